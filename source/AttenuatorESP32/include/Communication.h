@@ -121,5 +121,6 @@ enum api_messages : uint8_t {
   A_SEND_PREFERENCES_SMOKE,
   A_SAVE_PREFERENCES_PACK,
   A_SAVE_PREFERENCES_WAND,
-  A_SAVE_PREFERENCES_SMOKE
+  A_SAVE_PREFERENCES_SMOKE,
+  A_MEMORY_STATS
 };
@@ -109,6 +109,20 @@ const char DEVICE_page[] PROGMEM = R"=====(
     </div>
   </div>
 
+  <h1>Diagnostics</h1>
+  <div class="block left">
+    <p>
+      Record the serial traffic between this device and the Proton Pack, then download it for troubleshooting.
+      The most recent 16 KB of traffic is kept while recording.
+    </p>
+    <div class="setting">
+      <b>Serial Capture:</b>
+      <button type="button" class="orange" onclick="setCapture('start')">Start</button>
+      <button type="button" class="orange" onclick="setCapture('stop')">Stop</button>
+      <a href="/capture" download="capture.bin">Download</a>
+    </div>
+  </div>
+
   <div class="block">
     <a href="#top">Top</a>
     <hr/>
@@ -219,6 +233,17 @@ const char DEVICE_page[] PROGMEM = R"=====(
       xhttp.send(body);
     }
 
+    function setCapture(action) {
+      var xhttp = new XMLHttpRequest();
+      xhttp.onreadystatechange = function() {
+        if (this.readyState == 4 && this.status == 200) {
+          handleStatus(this.responseText);
+        }
+      };
+      xhttp.open("PUT", "/capture/" + action, true);
+      xhttp.send();
+    }
+
     function doRestart() {
       var xhttp = new XMLHttpRequest();
       xhttp.onreadystatechange = function() {
@@ -183,7 +183,6 @@ bool b_right_toggle_center_start = false;
  * Debounce Settings
  */
 const uint8_t switch_debounce_time = 50;
-const uint8_t rotary_debounce_time = 100;
 
 /*
  * Rotary encoder for various uses.
@@ -192,7 +191,6 @@ const uint8_t rotary_debounce_time = 100;
 #define r_encoderB 33
 #define r_button 4
 ezButton encoder_center(r_button); // For center-press on encoder dial.
-millisDelay ms_rotary_debounce; // Put some timing on the rotary so we do not overload the serial communication buffer.
 millisDelay ms_center_double_tap; // Timer for determinine when a double-tap was detected.
 millisDelay ms_center_long_press; // Timer for determining when a long press was detected.
 bool b_center_pressed = false;
@@ -201,9 +199,21 @@ const uint16_t i_center_double_tap_delay = 300; // When to consider the center d
 const uint16_t i_center_long_press_delay = 600; // When to consider the center dial has a "long" press.
 uint8_t i_press_count = 0;
 uint8_t i_rotary_count = 0;
-int i_encoder_pos = 0;
-int i_val_rotary;
-int i_last_val_rotary;
+
+/*
+ * Rotary encoder decoding.
+ * Both encoder channels are counted in hardware by a PCNT unit (x4 quadrature) with its glitch filter enabled,
+ * so no edge is missed while the web server or serial tasks are busy. checkRotaryEncoder() collects the count.
+ */
+pcnt_unit_handle_t encoderUnit = NULL;
+const uint8_t i_encoder_counts_per_detent = 4; // Quadrature edges counted per detent of the dial.
+const uint16_t i_encoder_glitch_ns = 1000; // Pulses shorter than this (ns) are filtered out as contact bounce.
+const int16_t i_encoder_count_limit = 10000; // Counter limits; the count is collected long before either is reached.
+int16_t i_encoder_remainder = 0; // Counts collected which do not yet add up to a full detent.
+unsigned long i_encoder_last_detent = 0; // Time (ms) of the last detent acted upon.
+const uint8_t i_encoder_fast_interval = 40; // Detents closer than this (ms) send 3 steps each.
+const uint8_t i_encoder_medium_interval = 90; // Detents closer than this (ms) send 2 steps each.
+const uint8_t i_encoder_max_steps = 6; // Most volume steps sent per check, so the serial buffer is not overloaded.
 
 /*
  * Define states for the rotary dial center press.
@@ -89,6 +89,8 @@ const char INDEX_page[] PROGMEM = R"=====(
         <span class="infoState" id="battVoltageTXT">&mdash;</span>
         <span style="font-size: 0.8em">GeV</span>
       </p>
+      <p><span class="infoLabel">Pack SRAM:</span> <span class="infoState" id="ramPack">&mdash;</span></p>
+      <p><span class="infoLabel">Wand SRAM:</span> <span class="infoState" id="ramWand">&mdash;</span></p>
     </div>
   </div>
 
@@ -22,6 +22,7 @@
 
 const char INDEXJS_page[] PROGMEM = R"=====(
 var websocket;
+var websocketClient = 0, commandSeq = 0;
 var statusInterval;
 var musicTrackStart = 0, musicTrackMax = 0, musicTrackCurrent = 0, musicTrackList = [];
 
@@ -78,6 +79,7 @@ function onOpen(event) {
 
 function onClose(event) {
   console.log("Connection closed");
+  websocketClient = 0; // Commands use HTTP until the next connection is identified.
   setTimeout(initWebSocket, 1000);
 
   // Fallback for when WebSocket is unavailable.
@@ -91,7 +93,19 @@ function onClose(event) {
 function onMessage(event) {
   if (isJsonString(event.data)) {
     // If JSON, use as status update.
-    updateEquipment(JSON.parse(event.data));
+    var jObj = JSON.parse(event.data);
+
+    if (jObj.client) {
+      websocketClient = jObj.client; // Our ID; once known, commands are sent over the WebSocket.
+    }
+
+    if (jObj.ack) {
+      // Result of one of our commands; handleStatus() alerts only on a failure, just as for the HTTP endpoint response.
+      handleStatus(JSON.stringify({ status: jObj.ackStatus }));
+      return;
+    }
+
+    updateEquipment(jObj);
   } else {
     // Anything else gets sent to console.
     console.log(event.data);
@@ -443,6 +457,10 @@ function updateEquipment(jObj) {
       setHtml("battHealth", "");
     }
 
+    // SRAM usage on the pack and wand controllers, reported in bytes.
+    setHtml("ramPack", formatMemory(jObj.ramPackFree, jObj.ramPackMin, jObj.ramPackHeap, jObj.ramPackStack));
+    setHtml("ramWand", formatMemory(jObj.ramWandFree, jObj.ramWandMin, jObj.ramWandHeap, jObj.ramWandStack));
+
     // Volume Information
     setHtml("masterVolume", (jObj.volMaster || 0) + "%");
     if ((jObj.volMaster || 0) == 0) {
@@ -475,6 +493,14 @@ function updateEquipment(jObj) {
   }
 }
 
+function formatMemory(free, min, heap, stack) {
+  if (!free) {
+    return "...";
+  }
+
+  return free + " B free (" + (min || 0) + " B min) / " + (stack || 0) + " B stack / " + (heap || 0) + " B heap free";
+}
+
 function getStatus() {
   var xhttp = new XMLHttpRequest();
   xhttp.onreadystatechange = function() {
@@ -547,7 +573,18 @@ function doRestart() {
   }
 }
 
-function sendCommand(apiUri) {
+function sendCommand(apiUri, track) {
+  if (websocket && websocket.readyState == websocket.OPEN && websocketClient) {
+    // Send over the open WebSocket; the result arrives as an acknowledgement for this sequence number.
+    commandSeq++;
+    websocket.send(commandSeq + " " + apiUri.substring(1) + (track !== undefined ? " " + track : ""));
+    return;
+  }
+
+  if (track !== undefined) {
+    apiUri += "?track=" + track;
+  }
+
   var xhttp = new XMLHttpRequest();
   xhttp.onreadystatechange = function() {
     if (this.readyState == 4 && this.status == 200) {
@@ -623,7 +660,7 @@ function musicNext() {
 }
 
 function musicSelect(caller) {
-  sendCommand("/music/select?track=" + caller.value);
+  sendCommand("/music/select", caller.value);
 }
 
 function musicPrev() {
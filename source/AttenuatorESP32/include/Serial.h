@@ -35,7 +35,8 @@ enum PACKET_TYPE : uint8_t {
   PACKET_PACK = 3,
   PACKET_WAND = 4,
   PACKET_SMOKE = 5,
-  PACKET_SYNC = 6
+  PACKET_SYNC = 6,
+  PACKET_MEMORY = 7
 };
 
 // For command signals (1 byte ID, 2 byte optional data).
@@ -170,6 +171,162 @@ struct __attribute__((packed)) AttenuatorSyncData {
   uint16_t packVoltage;
 } attenuatorSyncData;
 
+// SRAM usage reported by the ATmega2560 controllers; must match Memory.h on the pack and wand.
+struct __attribute__((packed)) MemoryStats {
+  uint16_t freeRAM;
+  uint16_t minFreeRAM;
+  uint16_t heapFree;
+  uint16_t stackPeak;
+};
+
+struct __attribute__((packed)) AttenuatorMemoryData {
+  MemoryStats pack;
+  MemoryStats wand;
+} attenuatorMemoryData;
+
+/*
+ * Serial Traffic Capture
+ *
+ * While a capture is running, every frame received from or sent to the pack is appended to a ring buffer
+ * as a record holding a microsecond timestamp, the packet ID (with the high bit set for frames we sent)
+ * and the raw payload. The oldest records are dropped to make room once the buffer is full, and the log
+ * is downloaded from the web UI as binary data for replay on a desk.
+ *
+ * Positions in the ring are kept as running stream offsets, so a download in progress can tell when the
+ * records it has yet to send were overwritten. The buffer size must be a power of two for the offsets to
+ * stay aligned with the buffer when they wrap.
+ */
+const uint16_t i_capture_buffer_size = 16384; // Bytes reserved for records while a capture is running.
+const uint8_t i_capture_sent = 0x80; // Set in the packet ID of frames which were sent to the pack.
+const uint8_t i_capture_version = 1; // Version of the record layout, written after the "GPSC" signature.
+
+struct __attribute__((packed)) objCaptureRecord {
+  uint32_t timestamp; // micros() when the frame was received or sent.
+  uint8_t packet; // Packet ID, with i_capture_sent set for frames which were sent to the pack.
+  uint8_t length; // Number of payload bytes which follow this header.
+};
+
+uint8_t* p_capture_buffer = nullptr;
+uint32_t i_capture_start = 0; // Stream offset of the oldest record still held.
+uint32_t i_capture_end = 0; // Stream offset where the next record will be written.
+uint32_t i_capture_dropped = 0; // Frames skipped while a download held the buffer, reported by /metrics.
+bool b_capture_enabled = false;
+SemaphoreHandle_t captureMutex = nullptr; // Guards the buffer between the serial loop and the web server.
+
+// Frames received from [0] and sent to [1] the pack, by packet type, counted whether or not a capture is running.
+const uint8_t i_serial_packet_types = 8;
+uint32_t i_serial_packets[2][i_serial_packet_types] = {};
+
+// Copy bytes into the ring at the end of the stream.
+void captureWrite(const uint8_t* p_data, uint16_t i_length) {
+  for(uint16_t i = 0; i < i_length; i++) {
+    p_capture_buffer[i_capture_end++ % i_capture_buffer_size] = p_data[i];
+  }
+}
+
+// Copy bytes out of the ring from a stream offset.
+void captureRead(uint32_t i_offset, uint8_t* p_data, uint16_t i_length) {
+  for(uint16_t i = 0; i < i_length; i++) {
+    p_data[i] = p_capture_buffer[(i_offset + i) % i_capture_buffer_size];
+  }
+}
+
+// Release the oldest record held in the ring.
+void captureDropOldest() {
+  objCaptureRecord record;
+
+  captureRead(i_capture_start, (uint8_t*) &record, sizeof(objCaptureRecord));
+  i_capture_start += sizeof(objCaptureRecord) + record.length;
+}
+
+// Append a frame to the capture, if one is running.
+void captureFrame(uint8_t i_packet_id, const uint8_t* p_payload, uint8_t i_length) {
+  // Every frame passes through here, so count it for the /metrics endpoint first.
+  i_serial_packets[(i_packet_id & i_capture_sent) ? 1 : 0][i_packet_id & (i_serial_packet_types - 1)]++;
+
+  if(!b_capture_enabled) {
+    return;
+  }
+
+  objCaptureRecord record = { (uint32_t) micros(), i_packet_id, i_length };
+  uint16_t i_size = sizeof(objCaptureRecord) + i_length;
+
+  // Never block the serial loop; skip the frame if a download is copying from the buffer.
+  if(xSemaphoreTake(captureMutex, 0) != pdTRUE) {
+    i_capture_dropped++;
+    return;
+  }
+
+  while(i_capture_end - i_capture_start + i_size > i_capture_buffer_size) {
+    captureDropOldest();
+  }
+
+  captureWrite((const uint8_t*) &record, sizeof(objCaptureRecord));
+  captureWrite(p_payload, i_length);
+
+  xSemaphoreGive(captureMutex);
+}
+
+// Copy whole records from a stream offset up to i_stop into a buffer, advancing the offset past them.
+// Records overwritten since the offset was taken are skipped, so the copy always starts on a record.
+size_t readCaptureRecords(uint32_t &i_offset, uint32_t i_stop, uint8_t* p_data, size_t i_max) {
+  size_t i_copied = 0;
+
+  xSemaphoreTake(captureMutex, portMAX_DELAY);
+
+  if((int32_t)(i_capture_start - i_offset) > 0) {
+    i_offset = i_capture_start;
+  }
+
+  while((int32_t)(i_stop - i_offset) > 0) {
+    objCaptureRecord record;
+    captureRead(i_offset, (uint8_t*) &record, sizeof(objCaptureRecord));
+
+    uint16_t i_size = sizeof(objCaptureRecord) + record.length;
+
+    if(i_copied + i_size > i_max) {
+      break; // Sent with the next chunk.
+    }
+
+    captureRead(i_offset, p_data + i_copied, i_size);
+    i_copied += i_size;
+    i_offset += i_size;
+  }
+
+  xSemaphoreGive(captureMutex);
+
+  return i_copied;
+}
+
+// Reserve the buffer (in PSRAM where available) and begin recording frames.
+bool startCapture() {
+  if(captureMutex == nullptr) {
+    captureMutex = xSemaphoreCreateMutex();
+  }
+
+  if(p_capture_buffer == nullptr) {
+    p_capture_buffer = (uint8_t*) (psramFound() ? ps_malloc(i_capture_buffer_size) : malloc(i_capture_buffer_size));
+
+    if(p_capture_buffer == nullptr) {
+      return false;
+    }
+  }
+
+  // Empty the ring without rewinding the stream, so a download still running sees its records as overwritten.
+  xSemaphoreTake(captureMutex, portMAX_DELAY);
+  i_capture_start = i_capture_end;
+  i_capture_dropped = 0;
+  b_capture_enabled = true;
+  xSemaphoreGive(captureMutex);
+
+  return true;
+}
+
+// Stop recording, keeping the records for download.
+void stopCapture() {
+  b_capture_enabled = false;
+}
+
 /*
  * Serial API Communication Handlers
  */
@@ -189,6 +346,7 @@ void attenuatorSerialSend(uint8_t i_command, uint16_t i_value = 0) {
   sendCmd.e = A_COM_END;
 
   i_send_size = packComs.txObj(sendCmd);
+  captureFrame(i_capture_sent | PACKET_COMMAND, packComs.packet.txBuff, i_send_size);
   packComs.sendData(i_send_size, (uint8_t) PACKET_COMMAND);
 }
 
@@ -215,6 +373,7 @@ void attenuatorSerialSendData(uint8_t i_message) {
       #endif
 
       i_send_size = packComs.txObj(packConfig);
+      captureFrame(i_capture_sent | PACKET_PACK, packComs.packet.txBuff, i_send_size);
       packComs.sendData(i_send_size, (uint8_t) PACKET_PACK);
     break;
 
@@ -224,6 +383,7 @@ void attenuatorSerialSendData(uint8_t i_message) {
       #endif
 
       i_send_size = packComs.txObj(wandConfig);
+      captureFrame(i_capture_sent | PACKET_WAND, packComs.packet.txBuff, i_send_size);
       packComs.sendData(i_send_size, (uint8_t) PACKET_WAND);
     break;
 
@@ -233,6 +393,7 @@ void attenuatorSerialSendData(uint8_t i_message) {
       #endif
 
       i_send_size = packComs.txObj(smokeConfig);
+      captureFrame(i_capture_sent | PACKET_SMOKE, packComs.packet.txBuff, i_send_size);
       packComs.sendData(i_send_size, (uint8_t) PACKET_SMOKE);
     break;
 
@@ -256,6 +417,8 @@ bool checkPack() {
     #endif
 
     if(i_packet_id > 0) {
+      captureFrame(i_packet_id, packComs.packet.rxBuff, packComs.bytesRead);
+
       if(ms_packsync.isRunning() && !b_wait_for_pack) {
         // If the timer is still running and Pack is connected, consider any request as proof of life.
         ms_packsync.restart();
@@ -367,6 +530,17 @@ bool checkPack() {
           packComs.rxObj(smokeConfig);
         break;
 
+        case PACKET_MEMORY:
+          {
+            // Periodic SRAM usage report from the pack (and wand, when connected).
+            AttenuatorMemoryData lastMemoryData = attenuatorMemoryData;
+            packComs.rxObj(attenuatorMemoryData);
+
+            // Publish a new status only when the figures have changed.
+            return memcmp(&lastMemoryData, &attenuatorMemoryData, sizeof(AttenuatorMemoryData)) != 0;
+          }
+        break;
+
         case PACKET_SYNC:
           // Used to sync the pack to the Attenuator.
           debug("Pack Sync Packet Received");
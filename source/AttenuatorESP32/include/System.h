@@ -347,17 +347,82 @@ void checkRotaryPress() {
 }
 
 /*
- * Determines if encoder was turned CW or CCW.
+ * Configures a PCNT unit to decode the rotary encoder in hardware.
+ * Each channel counts the edges of one encoder signal, using the level of the other to set the direction.
  */
-void readEncoder() {
-  if(digitalRead(r_encoderA) == digitalRead(r_encoderB)) {
-    i_encoder_pos++; // Clockwise
+void setupEncoder() {
+  pcnt_unit_config_t unitConfig = {};
+  unitConfig.low_limit = -i_encoder_count_limit;
+  unitConfig.high_limit = i_encoder_count_limit;
+  ESP_ERROR_CHECK(pcnt_new_unit(&unitConfig, &encoderUnit));
+
+  pcnt_glitch_filter_config_t filterConfig = {};
+  filterConfig.max_glitch_ns = i_encoder_glitch_ns;
+  ESP_ERROR_CHECK(pcnt_unit_set_glitch_filter(encoderUnit, &filterConfig));
+
+  pcnt_chan_config_t channelConfigA = {};
+  channelConfigA.edge_gpio_num = r_encoderA;
+  channelConfigA.level_gpio_num = r_encoderB;
+  pcnt_channel_handle_t channelA = NULL;
+  ESP_ERROR_CHECK(pcnt_new_channel(encoderUnit, &channelConfigA, &channelA));
+
+  pcnt_chan_config_t channelConfigB = {};
+  channelConfigB.edge_gpio_num = r_encoderB;
+  channelConfigB.level_gpio_num = r_encoderA;
+  pcnt_channel_handle_t channelB = NULL;
+  ESP_ERROR_CHECK(pcnt_new_channel(encoderUnit, &channelConfigB, &channelB));
+
+  // Count up (clockwise) when both signals match after an edge on A, as with the previous interrupt handler:
+  // A rising while B is high or falling while B is low. Edges on B count up when the signals differ afterwards.
+  ESP_ERROR_CHECK(pcnt_channel_set_edge_action(channelA, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_DECREASE));
+  ESP_ERROR_CHECK(pcnt_channel_set_level_action(channelA, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE));
+  ESP_ERROR_CHECK(pcnt_channel_set_edge_action(channelB, PCNT_CHANNEL_EDGE_ACTION_DECREASE, PCNT_CHANNEL_EDGE_ACTION_INCREASE));
+  ESP_ERROR_CHECK(pcnt_channel_set_level_action(channelB, PCNT_CHANNEL_LEVEL_ACTION_KEEP, PCNT_CHANNEL_LEVEL_ACTION_INVERSE));
+
+  ESP_ERROR_CHECK(pcnt_unit_enable(encoderUnit));
+  ESP_ERROR_CHECK(pcnt_unit_clear_count(encoderUnit));
+  ESP_ERROR_CHECK(pcnt_unit_start(encoderUnit));
+}
+
+/*
+ * Collects the detents turned since the last call (positive for CW, negative for CCW).
+ */
+int16_t readEncoderDetents() {
+  int i_count = 0;
+
+  if(encoderUnit == NULL || pcnt_unit_get_count(encoderUnit, &i_count) != ESP_OK) {
+    return 0;
   }
-  else {
-    i_encoder_pos--; // Counter-clockwise
+
+  // Clear the hardware count as soon as it is read; an edge between the two calls is the only one which can be lost.
+  pcnt_unit_clear_count(encoderUnit);
+
+  i_encoder_remainder += i_count;
+
+  int16_t i_detents = i_encoder_remainder / i_encoder_counts_per_detent;
+  i_encoder_remainder -= i_detents * i_encoder_counts_per_detent;
+
+  return i_detents;
+}
+
+/*
+ * Scales detents into volume steps by how quickly the dial is being turned.
+ */
+uint8_t encoderAcceleration(uint8_t i_detents) {
+  unsigned long i_now = millis();
+  unsigned long i_interval = (i_now - i_encoder_last_detent) / i_detents;
+  uint8_t i_multiplier = 1;
+
+  i_encoder_last_detent = i_now;
+
+  if(i_interval < i_encoder_fast_interval) {
+    i_multiplier = 3;
+  }
+  else if(i_interval < i_encoder_medium_interval) {
+    i_multiplier = 2;
   }
 
-  i_val_rotary = i_encoder_pos / 2.5;
+  return min((uint8_t)(i_detents * i_multiplier), i_encoder_max_steps);
 }
 
 /*
@@ -366,80 +431,57 @@ void readEncoder() {
  * Performs action based turning the dial.
  */
 void checkRotaryEncoder() {
-  // Take action if rotary encoder value was turned CW.
-  if(i_val_rotary > i_last_val_rotary) {
-    if(!ms_rotary_debounce.isRunning()) {
-      if(b_firing && i_speed_multiplier > 2) {
-        // Tell the pack to cancel the current overheat warning.
-        // Only do so after 5 turns of the dial (CW).
-        i_rotary_count++;
-        if(i_rotary_count % 5 == 0) {
-          attenuatorSerialSend(A_WARNING_CANCELLED);
-          debug("Rotary: Overheat Cancelled");
-          i_rotary_count = 0;
-        }
-      }
-      else {
-        // Perform action based on the current menu level.
-        switch(MENU_LEVEL) {
-          case MENU_1:
-            // Tell pack to increase overall volume.
-            attenuatorSerialSend(A_VOLUME_INCREASE);
-            debug("Rotary: Master Volume+");
-          break;
-
-          case MENU_2:
-            // Tell pack to increase effects volume.
-            attenuatorSerialSend(A_VOLUME_SOUND_EFFECTS_INCREASE);
-            debug("Rotary: Effects Volume+");
-          break;
-        }
-      }
+  int16_t i_detents = readEncoderDetents();
+
+  if(i_detents == 0) {
+    return;
+  }
 
-      ms_rotary_debounce.start(rotary_debounce_time);
+  if(b_firing && i_speed_multiplier > 2) {
+    // Tell the pack to cancel the current overheat warning.
+    // Only do so after 5 turns of the dial (CW or CCW).
+    i_rotary_count += abs(i_detents);
+    if(i_rotary_count >= 5) {
+      attenuatorSerialSend(A_WARNING_CANCELLED);
+      debug("Rotary: Overheat Cancelled");
+      i_rotary_count = 0;
     }
+
+    return;
   }
 
-  // Take action if rotary encoder value was turned CCW.
-  if(i_val_rotary < i_last_val_rotary) {
-    if(!ms_rotary_debounce.isRunning()) {
-      if(b_firing && i_speed_multiplier > 2) {
-        // Tell the pack to cancel the current overheat warning.
-        // Only do so after 5 turns of the dial (CCW).
-        i_rotary_count++;
-        if(i_rotary_count % 5 == 0) {
-          attenuatorSerialSend(A_WARNING_CANCELLED);
-          debug("Rotary: Overheat Cancelled");
-          i_rotary_count = 0;
+  uint8_t i_steps = encoderAcceleration(min(abs(i_detents), 255));
+
+  for(uint8_t i = 0; i < i_steps; i++) {
+    // Perform action based on the current menu level.
+    switch(MENU_LEVEL) {
+      case MENU_1:
+        if(i_detents > 0) {
+          // Tell pack to increase overall volume.
+          attenuatorSerialSend(A_VOLUME_INCREASE);
+          debug("Rotary: Master Volume+");
         }
-      }
-      else {
-        // Perform action based on the current menu level.
-        switch(MENU_LEVEL) {
-          case MENU_1:
-            // Tell pack to decrease overall volume.
-            attenuatorSerialSend(A_VOLUME_DECREASE);
-            debug("Rotary: Master Volume-");
-          break;
-
-          case MENU_2:
-            // Tell pack to decrease effects volume.
-            attenuatorSerialSend(A_VOLUME_SOUND_EFFECTS_DECREASE);
-            debug("Rotary: Effects Volume-");
-          break;
+        else {
+          // Tell pack to decrease overall volume.
+          attenuatorSerialSend(A_VOLUME_DECREASE);
+          debug("Rotary: Master Volume-");
         }
-      }
+      break;
 
-      ms_rotary_debounce.start(rotary_debounce_time);
+      case MENU_2:
+        if(i_detents > 0) {
+          // Tell pack to increase effects volume.
+          attenuatorSerialSend(A_VOLUME_SOUND_EFFECTS_INCREASE);
+          debug("Rotary: Effects Volume+");
+        }
+        else {
+          // Tell pack to decrease effects volume.
+          attenuatorSerialSend(A_VOLUME_SOUND_EFFECTS_DECREASE);
+          debug("Rotary: Effects Volume-");
+        }
+      break;
     }
   }
-
-  // Remember the last rotary value for comparison later.
-  i_last_val_rotary = i_val_rotary;
-
-  if(ms_rotary_debounce.justFinished()) {
-    ms_rotary_debounce.stop();
-  }
 }
 
 /*
@@ -33,167 +33,97 @@
 #include "Style.h" // STYLE_page
 #include "Equip.h" // EQUIP_svg
 #include "Icon.h" // FAVICON_ico, FAVICON_svg
+#include "Metrics.h" // handleGetMetrics
 
 // Forward function declarations.
 void setupRouting();
+bool updateEquipmentStatus();
+AsyncWebSocketSharedBuffer getStatusSnapshot(uint32_t* p_version = nullptr);
+void handleWebSocketCommand(AsyncWebSocketClient *client, uint8_t *data, size_t len);
+
+/*
+ * Status Snapshot
+ *
+ * The status is serialized once per change into an immutable snapshot with an increasing version number.
+ * A rebuild which serializes to the same bytes as the current snapshot publishes nothing, so the version
+ * only moves (and long-polls only wake) when the content has actually changed.
+ * The WebSocket and /status both send the current snapshot by reference instead of rebuilding it, and
+ * /status?since=N is held open until a snapshot newer than version N is published (or a timeout passes).
+ */
+const uint32_t i_status_poll_timeout = 25000; // Longest time a /status?since= request is held open (ms).
+AsyncWebSocketSharedBuffer statusSnapshot; // Current serialized status, never modified once published.
+uint32_t i_status_version = 0; // Version of statusSnapshot, also included as "version" in the status.
+std::vector<uint8_t> statusBody; // Status last published, serialized without its version, to detect unchanged rebuilds.
+SemaphoreHandle_t statusMutex = nullptr; // Guards statusSnapshot, i_status_version and statusBody.
 
 /*
  * Text Helper Functions - Converts ENUM values to user-friendly text
+ *
+ * Each table is indexed by its enum value and returns a pointer to constant text, so building the
+ * status never allocates a String per field.
  */
+const char* const c_mode_text[] PROGMEM = { "Super Hero", "Original" }; // SYSTEM_MODES
+const char* const c_theme_text[] PROGMEM = { "Unknown", "Unknown", "1984", "1989", "Afterlife", "Frozen Empire" }; // SYSTEM_YEARS
+const char* const c_red_switch_text[] PROGMEM = { "Ready", "Standby" }; // RED_SWITCH_MODES
+const char* const c_safety_text[] PROGMEM = { "Safety On", "Safety Off" }; // BARREL_STATES
+const char* const c_power_text[] PROGMEM = { "1", "2", "3", "4", "5" }; // POWER_LEVELS
+const char* const c_wand_mode_text[] PROGMEM = {
+  "Proton Stream", // PROTON
+  "Dark Matter Gen.", // STASIS (Dark Matter Generator)
+  "Plasm System", // SLIME (Plasm Distribution System)
+  "Particle System", // MESON (Composite Particle System)
+  "Spectral Stream", // SPECTRAL
+  "Halloween", // HOLIDAY_HALLOWEEN
+  "Christmas", // HOLIDAY_CHRISTMAS
+  "Custom Stream", // SPECTRAL_CUSTOM
+  "Settings" // SETTINGS
+};
+const char* const c_cyclotron_text[] PROGMEM = { "Normal", "Active", "Warning" }; // Speed multiplier 1-3
+
+// Look up the text for an enum value, or the fallback when the value is outside of the table.
+template<size_t N>
+const char* enumText(const char* const (&c_table)[N], uint8_t i_value, const char* c_fallback = "Unknown") {
+  return (i_value < N) ? c_table[i_value] : c_fallback;
+}
 
-String getMode() {
-  switch(SYSTEM_MODE) {
-    case MODE_SUPER_HERO:
-      return "Super Hero";
-    break;
-    case MODE_ORIGINAL:
-      return "Original";
-    break;
-    default:
-      return "Unknown";
-    break;
-  }
+const char* getMode() {
+  return enumText(c_mode_text, SYSTEM_MODE);
 }
 
-String getTheme() {
-  switch(SYSTEM_YEAR) {
-    case SYSTEM_1984:
-      return "1984";
-    break;
-    case SYSTEM_1989:
-      return "1989";
-    break;
-    case SYSTEM_AFTERLIFE:
-      return "Afterlife";
-    break;
-    case SYSTEM_FROZEN_EMPIRE:
-      return "Frozen Empire";
-    break;
-    default:
-      return "Unknown";
-    break;
-  }
+const char* getTheme() {
+  return enumText(c_theme_text, SYSTEM_YEAR);
 }
 
-String getRedSwitch() {
-  if(SYSTEM_MODE == MODE_ORIGINAL) {
-    // Switch state only matters for mode "Original".
-    switch(RED_SWITCH_MODE) {
-      case SWITCH_ON:
-        return "Ready";
-      break;
-      case SWITCH_OFF:
-        return "Standby";
-      break;
-      default:
-        return "Unknown";
-      break;
-    }
-  }
-  else {
-    // Otherwise, just "Ready".
-    return "Ready";
-  }
+const char* getRedSwitch() {
+  // Switch state only matters for mode "Original", otherwise it is always "Ready".
+  return (SYSTEM_MODE == MODE_ORIGINAL) ? enumText(c_red_switch_text, RED_SWITCH_MODE) : c_red_switch_text[SWITCH_ON];
 }
 
-String getSafety() {
-  switch(BARREL_STATE) {
-    case BARREL_RETRACTED:
-      return "Safety On";
-    break;
-    case BARREL_EXTENDED:
-      return "Safety Off";
-    break;
-    default:
-      return "Unknown";
-    break;
-  }
+const char* getSafety() {
+  return enumText(c_safety_text, BARREL_STATE);
 }
 
-String getWandMode() {
-  switch(STREAM_MODE) {
-    case PROTON:
-      return "Proton Stream";
-    break;
-    case SLIME:
-      // Plasm Distribution System
-      return "Plasm System";
-    break;
-    case STASIS:
-      // Dark Matter Generator
-      return "Dark Matter Gen.";
-    break;
-    case MESON:
-      // Composite Particle System
-      return "Particle System";
-    break;
-    case SPECTRAL:
-      return "Spectral Stream";
-    break;
-    case HOLIDAY_HALLOWEEN:
-      return "Halloween";
-    break;
-    case HOLIDAY_CHRISTMAS:
-      return "Christmas";
-    break;
-    case SPECTRAL_CUSTOM:
-      return "Custom Stream";
-    break;
-    case SETTINGS:
-      return "Settings";
-    break;
-    default:
-      return "Unknown";
-    break;
-  }
+const char* getWandMode() {
+  return enumText(c_wand_mode_text, STREAM_MODE);
 }
 
-String getPower() {
-  switch(POWER_LEVEL) {
-    case LEVEL_1:
-      return "1";
-    break;
-    case LEVEL_2:
-      return "2";
-    break;
-    case LEVEL_3:
-      return "3";
-    break;
-    case LEVEL_4:
-      return "4";
-    break;
-    case LEVEL_5:
-      return "5";
-    break;
-    default:
-      return "-";
-    break;
-  }
+const char* getPower() {
+  return enumText(c_power_text, POWER_LEVEL, "-");
 }
 
-String getCyclotronState() {
-  switch(i_speed_multiplier) {
-    case 1:
-       // Indicates an "idle" state, subject to the overheat status.
-      return (b_overheating ? "Recovery" : "Normal");
-    break;
-    case 2:
-      return "Active"; // After throwing a stream for an extended period.
-    break;
-    case 3:
-      return "Warning"; // Considered to be in a "pre-overheat" state.
-    break;
-    default:
-      return "Critical"; // For anything above a 3x speed increase.
-    break;
+const char* getCyclotronState() {
+  if(i_speed_multiplier == 1 && b_overheating) {
+    return "Recovery"; // An "idle" cyclotron while the pack recovers from an overheat.
   }
+
+  // Normal when idle, Active after throwing a stream for an extended period, then Warning before an overheat.
+  // Anything above a 3x speed increase is Critical.
+  return enumText(c_cyclotron_text, i_speed_multiplier - 1, "Critical");
 }
 
 /*
  * Web Handler Functions - Performs actions or returns data for web UI
  */
-JsonDocument jsonBody; // Used for processing JSON body/payload data.
-JsonDocument jsonSuccess; // Used for sending JSON status as success.
 String status; // Holder for simple "status: success" response.
 
 void onWebSocketEventHandler(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
@@ -203,6 +133,12 @@ void onWebSocketEventHandler(AsyncWebSocket *server, AsyncWebSocketClient *clien
         Serial.printf("WebSocket[%s][%lu] Connect\n", server->url(), client->id());
       #endif
       i_ws_client_count++;
+
+      // Tell the client its ID, which also tells the web UI that commands can be sent over the WebSocket.
+      client->printf("{\"client\":%lu}", client->id());
+
+      // Send the current snapshot, rather than waiting for the next change.
+      client->text(getStatusSnapshot());
     break;
 
     case WS_EVT_DISCONNECT:
@@ -230,16 +166,38 @@ void onWebSocketEventHandler(AsyncWebSocket *server, AsyncWebSocketClient *clien
       #if defined(DEBUG_SEND_TO_CONSOLE)
         Serial.printf("WebSocket[%s][C:%lu] Data[L:%u]: %s\n", server->url(), client->id(), len, (len)?(char*)data:"");
       #endif
+
+      {
+        // Only complete, single-frame text messages can be commands.
+        AwsFrameInfo *info = (AwsFrameInfo*)arg;
+
+        if(info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT) {
+          handleWebSocketCommand(client, data, len);
+        }
+      }
     break;
   }
 }
 
 void startWebServer() {
+  // Guards the status snapshot shared by the web server and the serial task.
+  if(statusMutex == nullptr) {
+    statusMutex = xSemaphoreCreateMutex();
+  }
+
+  // Guards the metrics history shared by the web server and the WiFi management task.
+  if(metricsMutex == nullptr) {
+    metricsMutex = xSemaphoreCreateMutex();
+  }
+
+  // Publish a first snapshot so /status always has something to send.
+  updateEquipmentStatus();
+
   // Configures URI routing with function handlers.
   setupRouting();
 
   // Prepare a standard "success" message for responses.
-  jsonSuccess.clear();
+  JsonDocument jsonSuccess;
   jsonSuccess["status"] = "success";
   serializeJson(jsonSuccess, status);
 
@@ -362,10 +320,9 @@ void handleFavSvg(AsyncWebServerRequest *request) {
   request->send(response);
 }
 
-String getDeviceConfig() {
+void writeDeviceConfig(Print& output) {
   // Prepare a JSON object with information we have gleamed from the system.
-  String equipSettings;
-  jsonBody.clear();
+  JsonDocument jsonBody;
 
   // Provide current values for the device.
   jsonBody["invertLEDs"] = b_invert_leds;
@@ -387,15 +344,13 @@ String getDeviceConfig() {
   jsonBody["extAddr"] = wifi_address;
   jsonBody["extMask"] = wifi_subnet;
 
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, equipSettings);
-  return equipSettings;
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
 }
 
-String getPackConfig() {
+void writePackConfig(Print& output) {
   // Prepare a JSON object with information we have gleamed from the system.
-  String equipSettings;
-  jsonBody.clear();
+  JsonDocument jsonBody;
 
   if(!b_wait_for_pack) {
     // Provide a flag to indicate prefs were received via serial coms.
@@ -441,15 +396,13 @@ String getPackConfig() {
     jsonBody["ledVGPowercell"] = packConfig.ledVGPowercell; // true|false
   }
 
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, equipSettings);
-  return equipSettings;
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
 }
 
-String getWandConfig() {
+void writeWandConfig(Print& output) {
   // Prepare a JSON object with information we have gleamed from the system.
-  String equipSettings;
-  jsonBody.clear();
+  JsonDocument jsonBody;
 
   if(!b_wait_for_pack) {
     // Provide a flag to indicate prefs were received via serial coms.
@@ -484,15 +437,13 @@ String getWandConfig() {
     jsonBody["bargraphFireAnimation"] = wandConfig.bargraphFireAnimation; // [1=SYSTEM,2=SH,3=MO]
   }
 
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, equipSettings);
-  return equipSettings;
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
 }
 
-String getSmokeConfig() {
+void writeSmokeConfig(Print& output) {
   // Prepare a JSON object with information we have gleamed from the system.
-  String equipSettings;
-  jsonBody.clear();
+  JsonDocument jsonBody;
 
   if(!b_wait_for_pack) {
     // Provide a flag to indicate prefs were received via serial coms.
@@ -540,15 +491,37 @@ String getSmokeConfig() {
     jsonBody["overheatDelay1"] = smokeConfig.overheatDelay1; // 2-60 Seconds
   }
 
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, equipSettings);
-  return equipSettings;
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
+}
+
+// Returns the current snapshot, and optionally its version.
+AsyncWebSocketSharedBuffer getStatusSnapshot(uint32_t* p_version) {
+  xSemaphoreTake(statusMutex, portMAX_DELAY);
+  AsyncWebSocketSharedBuffer snapshot = statusSnapshot;
+  if(p_version != nullptr) {
+    *p_version = i_status_version;
+  }
+  xSemaphoreGive(statusMutex);
+
+  return snapshot;
 }
 
-String getEquipmentStatus() {
+// Serialize the current status and publish it as a new snapshot, returning false if nothing had changed.
+bool updateEquipmentStatus() {
+  if(statusMutex == nullptr) {
+    return false; // Web server not started yet.
+  }
+
+  #if defined(DEBUG_PERFORMANCE)
+    uint32_t i_build_start = micros();
+  #endif
+
+  // Held for the whole build so that versions are always published in order.
+  xSemaphoreTake(statusMutex, portMAX_DELAY);
+
   // Prepare a JSON object with information we have gleamed from the system.
-  String equipStatus;
-  jsonBody.clear();
+  JsonDocument jsonBody;
 
   if(!b_wait_for_pack) {
     // Only prepare status when not waiting on the pack
@@ -563,6 +536,7 @@ String getEquipmentStatus() {
     jsonBody["wand"] = (b_wand_present ? "Connected" : "Not Connected");
     jsonBody["wandPower"] = (b_wand_on ? "Powered" : "Idle");
     jsonBody["wandMode"] = getWandMode();
+    jsonBody["wandModeID"] = STREAM_MODE;
     jsonBody["firing"] = (b_firing ? "Firing" : "Idle");
     jsonBody["cable"] = (b_pack_alarm ? "Disconnected" : "Connected");
     jsonBody["cyclotron"] = getCyclotronState();
@@ -578,88 +552,142 @@ String getEquipmentStatus() {
     jsonBody["volMusic"] = i_volume_music_percentage;
     jsonBody["battVoltage"] = f_batt_volts;
     jsonBody["wandAmps"] = f_wand_amps;
+    jsonBody["ramPackFree"] = attenuatorMemoryData.pack.freeRAM;
+    jsonBody["ramPackMin"] = attenuatorMemoryData.pack.minFreeRAM;
+    jsonBody["ramPackHeap"] = attenuatorMemoryData.pack.heapFree;
+    jsonBody["ramPackStack"] = attenuatorMemoryData.pack.stackPeak;
+    jsonBody["ramWandFree"] = attenuatorMemoryData.wand.freeRAM;
+    jsonBody["ramWandMin"] = attenuatorMemoryData.wand.minFreeRAM;
+    jsonBody["ramWandHeap"] = attenuatorMemoryData.wand.heapFree;
+    jsonBody["ramWandStack"] = attenuatorMemoryData.wand.stackPeak;
     jsonBody["apClients"] = i_ap_client_count;
     jsonBody["wsClients"] = i_ws_client_count;
   }
 
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, equipStatus);
-  return equipStatus;
-}
+  // Compare against the last published status before it is given a new version.
+  std::vector<uint8_t> body(measureJson(jsonBody));
+  serializeJson(jsonBody, (char*) body.data(), body.size());
 
-String getWifiSettings() {
-  // Prepare a JSON object with information stored in preferences (or a blank default).
-  String wifiNetwork;
-  jsonBody.clear();
-
-  // Accesses namespace in read-only mode.
-  if(preferences.begin("network", true)) {
-    jsonBody["enabled"] = preferences.getBool("enabled", false);
-    jsonBody["network"] = preferences.getString("ssid");
-    jsonBody["password"] = preferences.getString("password");
-
-    jsonBody["address"] = preferences.getString("address");
-    if(jsonBody["address"].as<String>() == "") {
-      jsonBody["address"] = wifi_address;
-    }
+  if(statusSnapshot && body == statusBody) {
+    xSemaphoreGive(statusMutex);
+    return false;
+  }
 
-    jsonBody["subnet"] = preferences.getString("subnet");
-    if(jsonBody["subnet"].as<String>() == "") {
-      jsonBody["subnet"] = wifi_subnet;
-    }
+  statusBody.swap(body);
+  jsonBody["version"] = i_status_version + 1;
 
-    jsonBody["gateway"] = preferences.getString("gateway");
-    if(jsonBody["gateway"].as<String>() == "") {
-      jsonBody["gateway"] = wifi_gateway;
-    }
+  // Serialize JSON object to a new snapshot, which replaces the previous one for any later requests.
+  AsyncWebSocketSharedBuffer snapshot = std::make_shared<std::vector<uint8_t>>(measureJson(jsonBody));
+  serializeJson(jsonBody, (char*) snapshot->data(), snapshot->size());
 
-    preferences.end();
-  }
-  else {
-    if(preferences.begin("network", false)) {
-      preferences.putBool("enabled", false);
-      preferences.putString("ssid", "");
-      preferences.putString("password", "");
-      preferences.putString("address", "");
-      preferences.putString("subnet", "");
-      preferences.putString("gateway", "");
-      preferences.end();
-    }
+  statusSnapshot = snapshot;
+  i_status_version++;
+  xSemaphoreGive(statusMutex);
+
+  #if defined(DEBUG_PERFORMANCE)
+    // Time to build and serialize one status push, for comparing changes to the serializer.
+    debug("Status " + String(i_status_version) + ": " + String(snapshot->size()) + " bytes in " + String(micros() - i_build_start) + "us");
+  #endif
+
+  return true;
+}
+
+// Copies the next part of a snapshot into a response buffer, returning the number of bytes written.
+size_t fillStatusResponse(const AsyncWebSocketSharedBuffer& snapshot, uint8_t *buffer, size_t maxLen, size_t index) {
+  if(index >= snapshot->size()) {
+    return 0;
   }
 
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, wifiNetwork);
-  return wifiNetwork;
+  size_t i_length = min(maxLen, snapshot->size() - index);
+  memcpy(buffer, snapshot->data() + index, i_length);
+  return i_length;
+}
+
+void writeWifiSettings(Print& output) {
+  // Prepare a JSON object with information stored in preferences (or a blank default).
+  JsonDocument jsonBody;
+
+  // Served from the settings cache, as flash is only read at boot.
+  xSemaphoreTake(settingsMutex, portMAX_DELAY);
+  jsonBody["enabled"] = networkSettings.enabled;
+  jsonBody["network"] = networkSettings.ssid;
+  jsonBody["password"] = networkSettings.password;
+  jsonBody["address"] = (networkSettings.address != "") ? networkSettings.address : wifi_address;
+  jsonBody["subnet"] = (networkSettings.subnet != "") ? networkSettings.subnet : wifi_subnet;
+  jsonBody["gateway"] = (networkSettings.gateway != "") ? networkSettings.gateway : wifi_gateway;
+  xSemaphoreGive(settingsMutex);
+
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
 }
 
 void handleGetDeviceConfig(AsyncWebServerRequest *request) {
-  // Return current device settings as a stringified JSON object.
-  request->send(200, "application/json", getDeviceConfig());
+  // Return current device settings as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writeDeviceConfig(*response);
+  request->send(response);
 }
 
 void handleGetPackConfig(AsyncWebServerRequest *request) {
-  // Return current pack settings as a stringified JSON object.
-  request->send(200, "application/json", getPackConfig());
+  // Return current pack settings as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writePackConfig(*response);
+  request->send(response);
 }
 
 void handleGetWandConfig(AsyncWebServerRequest *request) {
-  // Return current wand settings as a stringified JSON object.
-  request->send(200, "application/json", getWandConfig());
+  // Return current wand settings as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writeWandConfig(*response);
+  request->send(response);
 }
 
 void handleGetSmokeConfig(AsyncWebServerRequest *request) {
-  // Return current smoke settings as a stringified JSON object.
-  request->send(200, "application/json", getSmokeConfig());
+  // Return current smoke settings as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writeSmokeConfig(*response);
+  request->send(response);
 }
 
 void handleGetStatus(AsyncWebServerRequest *request) {
   // Return current system status as a stringified JSON object.
-  request->send(200, "application/json", getEquipmentStatus());
+  uint32_t i_version;
+  AsyncWebSocketSharedBuffer snapshot = getStatusSnapshot(&i_version);
+
+  if(!request->hasParam("since") || (uint32_t) request->getParam("since")->value().toInt() != i_version) {
+    // Send the current snapshot when no version was given, or the client is already behind.
+    request->send(request->beginResponse("application/json", snapshot->size(), [snapshot](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+      return fillStatusResponse(snapshot, buffer, maxLen, index);
+    }));
+    return;
+  }
+
+  // The client already has the current version, so hold the response until a newer snapshot is published.
+  // The web server polls the filler again while it returns RESPONSE_TRY_AGAIN, so no task is blocked.
+  uint32_t i_deadline = millis() + i_status_poll_timeout;
+  AsyncWebSocketSharedBuffer newer;
+
+  request->send(request->beginChunkedResponse("application/json", [i_version, i_deadline, newer](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+    if(!newer) {
+      uint32_t i_current;
+      AsyncWebSocketSharedBuffer current = getStatusSnapshot(&i_current);
+
+      if(i_current == i_version && (int32_t)(millis() - i_deadline) < 0) {
+        return RESPONSE_TRY_AGAIN;
+      }
+
+      newer = current; // Either a newer version, or the unchanged status once the timeout passes.
+    }
+
+    return fillStatusResponse(newer, buffer, maxLen, index);
+  }));
 }
 
 void handleGetWifi(AsyncWebServerRequest *request) {
-  // Return current system status as a stringified JSON object.
-  request->send(200, "application/json", getWifiSettings());
+  // Return current system status as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writeWifiSettings(*response);
+  request->send(response);
 }
 
 void handleRestart(AsyncWebServerRequest *request) {
@@ -669,6 +697,70 @@ void handleRestart(AsyncWebServerRequest *request) {
   ESP.restart();
 }
 
+void handleCaptureStart(AsyncWebServerRequest *request) {
+  debug("Web: Start Serial Capture");
+
+  JsonDocument jsonBody;
+
+  if(startCapture()) {
+    jsonBody["status"] = "Serial capture started";
+  }
+  else {
+    jsonBody["status"] = "Unable to reserve memory for the capture";
+  }
+
+  // Serialize JSON object straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  serializeJson(jsonBody, *response);
+  request->send(response);
+}
+
+void handleCaptureStop(AsyncWebServerRequest *request) {
+  debug("Web: Stop Serial Capture");
+  stopCapture();
+
+  JsonDocument jsonBody;
+  jsonBody["status"] = "Serial capture stopped";
+
+  // Serialize JSON object straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  serializeJson(jsonBody, *response);
+  request->send(response);
+}
+
+void handleCaptureDownload(AsyncWebServerRequest *request) {
+  // Returns the signature and version, followed by the records held when the download began, oldest first.
+  // Records are copied a chunk at a time, so the serial loop is only held off for the copy of each chunk.
+  uint32_t i_offset = 0;
+  uint32_t i_stop = 0;
+
+  if(captureMutex != nullptr) {
+    xSemaphoreTake(captureMutex, portMAX_DELAY);
+    i_offset = i_capture_start;
+    i_stop = i_capture_end;
+    xSemaphoreGive(captureMutex);
+  }
+
+  AsyncWebServerResponse *response = request->beginChunkedResponse("application/octet-stream", [i_offset, i_stop](uint8_t *buffer, size_t maxLen, size_t index) mutable -> size_t {
+    size_t i_length = 0;
+
+    if(index == 0) {
+      memcpy(buffer, "GPSC", 4);
+      buffer[4] = i_capture_version;
+      i_length = 5;
+    }
+
+    if(captureMutex != nullptr) {
+      i_length += readCaptureRecords(i_offset, i_stop, buffer + i_length, maxLen - i_length);
+    }
+
+    return i_length; // Nothing left to copy ends the response.
+  });
+
+  response->addHeader("Content-Disposition", "attachment; filename=\"capture.bin\"");
+  request->send(response);
+}
+
 void handlePackOn(AsyncWebServerRequest *request) {
   debug("Web: Turn Pack On");
   attenuatorSerialSend(A_TURN_PACK_ON);
@@ -681,17 +773,28 @@ void handlePackOff(AsyncWebServerRequest *request) {
   request->send(200, "application/json", status);
 }
 
-void handleAttenuatePack(AsyncWebServerRequest *request) {
+// Cancel the overheat warning, returning the reason when the pack is not in a warning state.
+const char* attenuatePack() {
   if(i_speed_multiplier > 2) {
     // Only send command to pack if cyclotron is not "normal".
     debug("Web: Cancel Overheat Warning");
     attenuatorSerialSend(A_WARNING_CANCELLED);
+    return nullptr;
+  }
+
+  return "System not in overheat warning";
+}
+
+void handleAttenuatePack(AsyncWebServerRequest *request) {
+  const char* c_error = attenuatePack();
+
+  if(c_error == nullptr) {
     request->send(200, "application/json", status);
   } else {
     // Tell the user why the requested action failed.
     String result;
-    jsonBody.clear();
-    jsonBody["status"] = "System not in overheat warning";
+    JsonDocument jsonBody;
+    jsonBody["status"] = c_error;
     serializeJson(jsonBody, result); // Serialize to string.
     request->send(200, "application/json", result);
   }
@@ -787,6 +890,17 @@ void handleLoopMusicTrack(AsyncWebServerRequest *request) {
   request->send(200, "application/json", status);
 }
 
+// Play a specific music track, returning the reason when the track number is not valid.
+const char* selectMusicTrack(long i_track) {
+  if(i_track != 0 && i_track >= i_music_track_min) {
+    debug("Web: Selected Music Track: " + String(i_track));
+    attenuatorSerialSend(A_MUSIC_PLAY_TRACK, (uint16_t) i_track); // Inform the pack of the new track.
+    return nullptr;
+  }
+
+  return "Invalid track number requested";
+}
+
 void handleSelectMusicTrack(AsyncWebServerRequest *request) {
   String c_music_track = "";
 
@@ -795,17 +909,16 @@ void handleSelectMusicTrack(AsyncWebServerRequest *request) {
     c_music_track = request->getParam("track")->value();
   }
 
-  if(c_music_track.toInt() != 0 && c_music_track.toInt() >= i_music_track_min) {
-    uint16_t i_music_track = c_music_track.toInt();
-    debug("Web: Selected Music Track: " + String(i_music_track));
-    attenuatorSerialSend(A_MUSIC_PLAY_TRACK, i_music_track); // Inform the pack of the new track.
+  const char* c_error = selectMusicTrack(c_music_track.toInt());
+
+  if(c_error == nullptr) {
     request->send(200, "application/json", status);
   }
   else {
     // Tell the user why the requested action failed.
     String result;
-    jsonBody.clear();
-    jsonBody["status"] = "Invalid track number requested";
+    JsonDocument jsonBody;
+    jsonBody["status"] = c_error;
     serializeJson(jsonBody, result); // Serialize to string.
     request->send(200, "application/json", result);
   }
@@ -832,7 +945,7 @@ void handleSaveWandEEPROM(AsyncWebServerRequest *request) {
 
 // Handles the JSON body for the pack settings save request.
 AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHandler("/config/device/save", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -850,15 +963,19 @@ AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHa
     // Update the private network name ONLY if the new value differs from the current SSID.
     if(newSSID != ap_ssid){
       if(newSSID.length() >= 8 && newSSID.length() <= 32) {
-        // Accesses namespace in read/write mode.
-        if(preferences.begin("credentials", false)) {
-          #if defined(DEBUG_SEND_TO_CONSOLE)
-            Serial.print(F("New Private SSID: "));
-            Serial.println(newSSID);
-          #endif
-          preferences.putString("ssid", newSSID); // Store SSID in case this was altered.
-          preferences.end();
-        }
+        #if defined(DEBUG_SEND_TO_CONSOLE)
+          Serial.print(F("New Private SSID: "));
+          Serial.println(newSSID);
+        #endif
+
+        // Store SSID in case this was altered.
+        xSemaphoreTake(settingsMutex, portMAX_DELAY);
+        credentialSettings.ssid = newSSID;
+        markSettingsDirty(SETTINGS_CREDENTIALS);
+        xSemaphoreGive(settingsMutex);
+
+        // The new name only takes effect after a restart, so write it to NVS now.
+        flushSettings();
 
         b_ssid_changed = true; // This will cause a reboot of the device after saving.
       }
@@ -928,38 +1045,31 @@ AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHa
     String songList = jsonBody["songList"].as<String>();
     bool b_list_err = false;
 
-    // Accesses namespace in read/write mode.
-    if(preferences.begin("device", false)) {
-      preferences.putBool("invert_led", b_invert_leds);
-      preferences.putBool("use_buzzer", b_enable_buzzer);
-      preferences.putBool("use_vibration", b_enable_vibration);
-      preferences.putBool("use_overheat", b_overheat_feedback);
-      preferences.putBool("fire_feedback", b_firing_feedback);
-      preferences.putShort("radiation_idle", RAD_LENS_IDLE);
-      preferences.putShort("display_type", DISPLAY_TYPE);
-
-      if(songList.length() <= 2000) {
-        if(songList == "null") {
-          songList = "";
-        }
-
-        // Update song lists if contents are under 2000 bytes.
-        #if defined(DEBUG_SEND_TO_CONSOLE)
-          Serial.print(F("Song List Bytes: "));
-          Serial.println(songList.length());
-        #endif
-        preferences.putString("track_list", songList);
-        s_track_listing = songList;
-      }
-      else {
-        // Max size for preferences is 4KB so we need to make reserve space for other items.
-        // Also, there is a 2KB limit for a single item which is what we're storing here.
-        b_list_err = true;
+    if(songList.length() <= 2000) {
+      if(songList == "null") {
+        songList = "";
       }
 
-      preferences.end();
+      // Update song lists if contents are under 2000 bytes.
+      #if defined(DEBUG_SEND_TO_CONSOLE)
+        Serial.print(F("Song List Bytes: "));
+        Serial.println(songList.length());
+      #endif
+    }
+    else {
+      // Max size for preferences is 4KB so we need to make reserve space for other items.
+      // Also, there is a 2KB limit for a single item which is what we're storing here.
+      b_list_err = true;
     }
 
+    // The device settings are written to flash from their globals on the next flush.
+    xSemaphoreTake(settingsMutex, portMAX_DELAY);
+    if(!b_list_err) {
+      s_track_listing = songList;
+    }
+    markSettingsDirty(SETTINGS_DEVICE);
+    xSemaphoreGive(settingsMutex);
+
     if(b_list_err){
       jsonBody.clear();
       jsonBody["status"] = "Settings updated, but song list exceeds the 2,000 bytes maximum and was not saved.";
@@ -989,7 +1099,7 @@ AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHa
 
 // Handles the JSON body for the pack settings save request.
 AsyncCallbackJsonWebHandler *handleSavePackConfig = new AsyncCallbackJsonWebHandler("/config/pack/save", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -1081,7 +1191,7 @@ AsyncCallbackJsonWebHandler *handleSavePackConfig = new AsyncCallbackJsonWebHand
 
 // Handles the JSON body for the wand settings save request.
 AsyncCallbackJsonWebHandler *handleSaveWandConfig = new AsyncCallbackJsonWebHandler("/config/wand/save", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -1138,7 +1248,7 @@ AsyncCallbackJsonWebHandler *handleSaveWandConfig = new AsyncCallbackJsonWebHand
 
 // Handles the JSON body for the smoke settings save request.
 AsyncCallbackJsonWebHandler *handleSaveSmokeConfig = new AsyncCallbackJsonWebHandler("/config/smoke/save", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -1200,7 +1310,7 @@ AsyncCallbackJsonWebHandler *handleSaveSmokeConfig = new AsyncCallbackJsonWebHan
 
 // Handles the JSON body for the password change request.
 AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHandler("/password/update", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -1214,15 +1324,19 @@ AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHan
 
     // Password is used for the built-in Access Point ability, which will be used when a preferred network is not available.
     if(newPasswd.length() >= 8) {
-      // Accesses namespace in read/write mode.
-      if(preferences.begin("credentials", false)) {
-        #if defined(DEBUG_SEND_TO_CONSOLE)
-          Serial.print(F("New Private WiFi Password: "));
-          Serial.println(newPasswd);
-        #endif
-        preferences.putString("password", newPasswd); // Store user-provided password.
-        preferences.end();
-      }
+      #if defined(DEBUG_SEND_TO_CONSOLE)
+        Serial.print(F("New Private WiFi Password: "));
+        Serial.println(newPasswd);
+      #endif
+
+      // Store user-provided password.
+      xSemaphoreTake(settingsMutex, portMAX_DELAY);
+      credentialSettings.password = newPasswd;
+      markSettingsDirty(SETTINGS_CREDENTIALS);
+      xSemaphoreGive(settingsMutex);
+
+      // Write the new password now, as the device is likely to be restarted or powered off next.
+      flushSettings();
 
       jsonBody.clear();
       jsonBody["status"] = "Password updated, restart required. Please enter your new WiFi password when prompted by your device.";
@@ -1248,7 +1362,7 @@ AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHan
 
 // Handles the JSON body for the wifi network info.
 AsyncCallbackJsonWebHandler *wifiChangeHandler = new AsyncCallbackJsonWebHandler("/wifi/update", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -1268,35 +1382,37 @@ AsyncCallbackJsonWebHandler *wifiChangeHandler = new AsyncCallbackJsonWebHandler
 
     // If no errors encountered, continue with storing a preferred network (with credentials and IP information).
     if(wifiNetwork.length() >= 2 && wifiPasswd.length() >= 8) {
-      // Accesses namespace in read/write mode.
-      if(preferences.begin("network", false)) {
-        // Clear old network IP info if SSID or password have been changed.
-        String old_ssid = preferences.getString("ssid", "");
-        String old_passwd = preferences.getString("password", "");
-        if(old_ssid == "" || old_ssid != wifiNetwork || old_passwd == "" || old_passwd != wifiPasswd) {
-          preferences.putString("address", "");
-          preferences.putString("subnet", "");
-          preferences.putString("gateway", "");
-        }
-
-        // Store the critical values to enable/disable the external WiFi.
-        preferences.putBool("enabled", b_enabled);
-        preferences.putString("ssid", wifiNetwork);
-        preferences.putString("password", wifiPasswd);
+      xSemaphoreTake(settingsMutex, portMAX_DELAY);
+
+      // Clear old network IP info if SSID or password have been changed.
+      if(networkSettings.ssid == "" || networkSettings.ssid != wifiNetwork || networkSettings.password == "" || networkSettings.password != wifiPasswd) {
+        networkSettings.address = "";
+        networkSettings.subnet = "";
+        networkSettings.gateway = "";
+        forgetAccessPoint();
+      }
 
-        // Continue saving only if network values are 7 characters or more (eg. N.N.N.N)
-        if(localAddr.length() >= 7 && localAddr != wifi_address) {
-          preferences.putString("address", localAddr);
-        }
-        if(subnetMask.length() >= 7 && subnetMask != wifi_subnet) {
-          preferences.putString("subnet", subnetMask);
-        }
-        if(gatewayIP.length() >= 7 && gatewayIP != wifi_gateway) {
-          preferences.putString("gateway", gatewayIP);
-        }
+      // Store the critical values to enable/disable the external WiFi.
+      networkSettings.enabled = b_enabled;
+      networkSettings.ssid = wifiNetwork;
+      networkSettings.password = wifiPasswd;
 
-        preferences.end();
+      // Continue saving only if network values are 7 characters or more (eg. N.N.N.N)
+      if(localAddr.length() >= 7 && localAddr != wifi_address) {
+        networkSettings.address = localAddr;
       }
+      if(subnetMask.length() >= 7 && subnetMask != wifi_subnet) {
+        networkSettings.subnet = subnetMask;
+      }
+      if(gatewayIP.length() >= 7 && gatewayIP != wifi_gateway) {
+        networkSettings.gateway = gatewayIP;
+      }
+
+      markSettingsDirty(SETTINGS_NETWORK);
+      xSemaphoreGive(settingsMutex);
+
+      // Write the network settings now rather than after the quiet period.
+      flushSettings();
     }
 
     if(!b_errors) {
@@ -1341,6 +1457,89 @@ AsyncCallbackJsonWebHandler *wifiChangeHandler = new AsyncCallbackJsonWebHandler
   }
 });
 
+/*
+ * WebSocket Commands
+ *
+ * The web UI sends its button presses over the open WebSocket rather than one PUT request each.
+ * A command is a text frame "<seq> <command>[ <value>]", where <command> is the path of the matching
+ * PUT endpoint without its leading slash (eg. "12 volume/master/up" or "13 music/select 501").
+ * Each command is answered straight away to the client which sent it, with a text frame carrying "ack"
+ * (the sequence number) and "ackStatus" ("success" or the same error text the endpoint would return).
+ * Any change to the equipment follows in the usual status push.
+ */
+struct WebSocketCommand {
+  const char* command;
+  uint8_t i_message;
+};
+
+const WebSocketCommand wsCommands[] = {
+  { "pack/on", A_TURN_PACK_ON },
+  { "pack/off", A_TURN_PACK_OFF },
+  { "pack/vent", A_MANUAL_OVERHEAT },
+  { "pack/lockout/start", A_SYSTEM_LOCKOUT },
+  { "pack/lockout/cancel", A_CANCEL_LOCKOUT },
+  { "volume/toggle", A_TOGGLE_MUTE },
+  { "volume/master/up", A_VOLUME_INCREASE },
+  { "volume/master/down", A_VOLUME_DECREASE },
+  { "volume/effects/up", A_VOLUME_SOUND_EFFECTS_INCREASE },
+  { "volume/effects/down", A_VOLUME_SOUND_EFFECTS_DECREASE },
+  { "volume/music/up", A_VOLUME_MUSIC_INCREASE },
+  { "volume/music/down", A_VOLUME_MUSIC_DECREASE },
+  { "music/startstop", A_MUSIC_START_STOP },
+  { "music/pauseresume", A_MUSIC_PAUSE_RESUME },
+  { "music/next", A_MUSIC_NEXT_TRACK },
+  { "music/prev", A_MUSIC_PREV_TRACK },
+  { "music/loop", A_MUSIC_TRACK_LOOP_TOGGLE }
+};
+
+void handleWebSocketCommand(AsyncWebSocketClient *client, uint8_t *data, size_t len) {
+  char c_frame[48];
+
+  if(len >= sizeof(c_frame)) {
+    return; // Too long to be a command.
+  }
+
+  memcpy(c_frame, data, len);
+  c_frame[len] = '\0';
+
+  // Anything not starting with a sequence number (such as the heartbeat) is not a command.
+  char* p_command;
+  uint32_t i_seq = strtoul(c_frame, &p_command, 10);
+
+  if(p_command == c_frame || *p_command != ' ') {
+    return;
+  }
+
+  p_command++;
+  char* p_value = strchr(p_command, ' ');
+
+  if(p_value != nullptr) {
+    *p_value++ = '\0';
+  }
+
+  const char* c_error = "Unknown command";
+
+  if(strcmp(p_command, "pack/attenuate") == 0) {
+    c_error = attenuatePack();
+  }
+  else if(strcmp(p_command, "music/select") == 0) {
+    c_error = selectMusicTrack(p_value != nullptr ? atol(p_value) : 0);
+  }
+  else {
+    for(const WebSocketCommand& command : wsCommands) {
+      if(strcmp(p_command, command.command) == 0) {
+        debug("WebSocket: " + String(p_command));
+        attenuatorSerialSend(command.i_message);
+        c_error = nullptr;
+        break;
+      }
+    }
+  }
+
+  // Acknowledge the command to the client which sent it.
+  client->printf("{\"ack\":%lu,\"ackStatus\":\"%s\"}", i_seq, (c_error == nullptr) ? "success" : c_error);
+}
+
 void handleNotFound(AsyncWebServerRequest *request) {
   // Returned for any invalid URL requested.
   debug("Web page not found");
@@ -1375,6 +1574,7 @@ void setupRouting() {
   httpServer.on("/eeprom/pack", HTTP_PUT, handleSavePackEEPROM);
   httpServer.on("/eeprom/wand", HTTP_PUT, handleSaveWandEEPROM);
   httpServer.on("/status", HTTP_GET, handleGetStatus);
+  httpServer.on("/metrics", HTTP_GET, handleGetMetrics);
   httpServer.on("/restart", HTTP_DELETE, handleRestart);
   httpServer.on("/pack/on", HTTP_PUT, handlePackOn);
   httpServer.on("/pack/off", HTTP_PUT, handlePackOff);
@@ -1396,6 +1596,9 @@ void setupRouting() {
   httpServer.on("/music/prev", HTTP_PUT, handlePrevMusicTrack);
   httpServer.on("/music/loop", HTTP_PUT, handleLoopMusicTrack);
   httpServer.on("/wifi/settings", HTTP_GET, handleGetWifi);
+  httpServer.on("/capture", HTTP_GET, handleCaptureDownload);
+  httpServer.on("/capture/start", HTTP_PUT, handleCaptureStart);
+  httpServer.on("/capture/stop", HTTP_PUT, handleCaptureStop);
 
   // Body Handlers
   httpServer.addHandler(handleSaveDeviceConfig); // /config/device/save
@@ -1408,6 +1611,12 @@ void setupRouting() {
 
 // Send notification to all websocket clients.
 void notifyWSClients() {
-  // Send latest status to all connected clients.
-  ws.textAll(getEquipmentStatus());
+  if(statusMutex == nullptr) {
+    return; // Web server not started yet.
+  }
+
+  // Publish the latest status and send it to all connected clients, unless nothing has changed.
+  if(updateEquipmentStatus()) {
+    ws.textAll(getStatusSnapshot());
+  }
 }
@@ -39,6 +39,7 @@
 #include <SerialTransfer.h>
 #include <esp_system.h>
 #include <nvs_flash.h>
+#include <driver/pulse_cnt.h>
 
 // Local Files
 #include "Configuration.h"
@@ -47,6 +48,7 @@
 #include "Bargraph.h"
 #include "Colours.h"
 #include "Serial.h"
+#include "Settings.h"
 #include "Wireless.h"
 #include "System.h"
 
@@ -162,61 +164,8 @@ void PreferencesTask(void *parameter) {
     debug(F("NVS initialized successfully"));
   }
 
-  /*
-   * Get Local Device Preferences
-   * Accesses the "device" namespace in read-only mode under the "nvs" partition.
-   */
-  bool b_namespace_opened = preferences.begin("device", true);
-  if(b_namespace_opened) {
-    // Return stored values if available, otherwise use a default value.
-    b_invert_leds = preferences.getBool("invert_led", false);
-    b_enable_buzzer = preferences.getBool("use_buzzer", true);
-    b_enable_vibration = preferences.getBool("use_vibration", true);
-    b_overheat_feedback = preferences.getBool("use_overheat", true);
-    b_firing_feedback = preferences.getBool("fire_feedback", false);
-
-    switch(preferences.getShort("radiation_idle", 0)) {
-      case 0:
-        RAD_LENS_IDLE = AMBER_PULSE;
-      break;
-      case 1:
-        RAD_LENS_IDLE = ORANGE_FADE;
-      break;
-      case 2:
-        RAD_LENS_IDLE = RED_FADE;
-      break;
-    }
-
-    switch(preferences.getShort("display_type", 0)) {
-      case 0:
-        DISPLAY_TYPE = STATUS_TEXT;
-      break;
-      case 1:
-        DISPLAY_TYPE = STATUS_GRAPHIC;
-      break;
-      case 2:
-      default:
-        DISPLAY_TYPE = STATUS_BOTH;
-      break;
-    }
-
-    s_track_listing = preferences.getString("track_list", "");
-    preferences.end();
-  }
-  else {
-    // If namespace is not initialized, open in read/write mode and set defaults.
-    if(preferences.begin("device", false)) {
-      preferences.putBool("invert_led", b_invert_leds);
-      preferences.putBool("use_buzzer", b_enable_buzzer);
-      preferences.putBool("use_vibration", b_enable_vibration);
-      preferences.putBool("use_overheat", b_overheat_feedback);
-      preferences.putBool("fire_feedback", b_firing_feedback);
-      preferences.putShort("radiation_idle", RAD_LENS_IDLE);
-      preferences.putShort("display_type", DISPLAY_TYPE);
-      preferences.putString("track_list", "");
-      preferences.end();
-    }
-  }
+  // Read all stored settings into RAM, where they are served from until the next restart.
+  loadSettings();
 
   #if defined(DEBUG_TASK_TO_CONSOLE)
     // Get the stack high water mark for optimizing bytes allocated.
@@ -258,6 +207,9 @@ void SerialCommsTask(void *parameter) {
       if(!b_wait_for_pack) {
         // Indicate that we are no longer waiting on the pack.
         digitalWrite(BUILT_IN_LED, HIGH);
+
+        // Publish the first full status now that the pack is known.
+        notifyWSClients();
       }
     }
     else {
@@ -277,6 +229,9 @@ void SerialCommsTask(void *parameter) {
         // The pack just went missing, so treat as disconnected.
         b_wait_for_pack = true;
         ms_packsync.start(i_sync_initial_delay);
+
+        // Replace the last status so that clients no longer see a connected pack.
+        updateEquipmentStatus();
       }
 
       /**
@@ -339,8 +294,13 @@ void WiFiManagementTask(void *parameter) {
       }
 
       if(ms_apclient.remaining() < 1) {
-        // Update the current count of AP clients.
-        i_ap_client_count = WiFi.softAPgetStationNum();
+        // Update the current count of AP clients, publishing a new status when it changes.
+        uint8_t i_ap_clients = WiFi.softAPgetStationNum();
+
+        if(i_ap_clients != i_ap_client_count) {
+          i_ap_client_count = i_ap_clients;
+          updateEquipmentStatus();
+        }
 
         // Restart timer for next count.
         ms_apclient.start(i_apClientCount);
@@ -353,8 +313,22 @@ void WiFiManagementTask(void *parameter) {
         // Restart timer for next check.
         ms_otacheck.start(i_otaCheck);
       }
+
+      if(ms_metrics.remaining() < 1) {
+        // Add a sample to the metrics history.
+        updateMetrics();
+
+        // Restart timer for next sample.
+        ms_metrics.start(i_metricsSample);
+      }
     }
 
+    // Renew the address with DHCP once a reused lease has run out.
+    checkWifiLease();
+
+    // Write any changed settings to NVS once saves have stopped.
+    checkSettingsFlush();
+
     vTaskDelay(100 / portTICK_PERIOD_MS); // 100ms delay
   }
 }
@@ -376,6 +350,7 @@ void WiFiSetupTask(void *parameter) {
     ms_cleanup.start(i_websocketCleanup);
     ms_apclient.start(i_apClientCount);
     ms_otacheck.start(i_otaCheck);
+    ms_metrics.start(i_metricsSample);
   }
 
   #if defined(DEBUG_TASK_TO_CONSOLE)
@@ -445,10 +420,10 @@ void setup() {
   switch_right.setDebounceTime(switch_debounce_time);
   encoder_center.setDebounceTime(switch_debounce_time);
 
-  // Rotary encoder on the top of the Attenuator.
+  // Rotary encoder on the top of the Attenuator, counted by the pulse counter peripheral.
   pinMode(r_encoderA, INPUT_PULLUP);
   pinMode(r_encoderB, INPUT_PULLUP);
-  attachInterrupt(digitalPinToInterrupt(r_encoderA), readEncoder, CHANGE);
+  setupEncoder();
 
   // Setup the bargraph after a brief delay.
   delay(10);
@@ -510,7 +485,7 @@ void setup() {
   xTaskCreatePinnedToCore(SerialCommsTask, "SerialCommsTask", 4096, NULL, 4, &SerialCommsTaskHandle, 1);
   xTaskCreatePinnedToCore(UserInputTask, "UserInputTask", 4096, NULL, 3, &UserInputTaskHandle, 1);
   xTaskCreatePinnedToCore(AnimationTask, "AnimationTask", 2048, NULL, 2, &AnimationTaskHandle, 1);
-  xTaskCreatePinnedToCore(WiFiManagementTask, "WiFiManagementTask", 2048, NULL, 1, &WiFiManagementTaskHandle, 1);
+  xTaskCreatePinnedToCore(WiFiManagementTask, "WiFiManagementTask", 4096, NULL, 1, &WiFiManagementTaskHandle, 1);
 
   // Create idle tasks for each core, used to estimate % busy for core.
   #if defined(DEBUG_PERFORMANCE)
@@ -39,6 +39,7 @@
 #include "Configuration.h"
 #include "Header.h"
 #include "Colours.h"
+#include "Settings.h"
 #include "Wireless.h"
 #include "System.h"
 
@@ -133,6 +134,9 @@ void PreferencesTask(void *parameter) {
     debug(F("NVS initialized successfully"));
   }
 
+  // Read all stored settings into RAM, where they are served from until the next restart.
+  loadSettings();
+
   #if defined(DEBUG_TASK_TO_CONSOLE)
     // Get the stack high water mark for optimizing bytes allocated.
     Serial.print(F("PreferencesTask Stack HWM: "));
@@ -191,12 +195,26 @@ void WiFiManagementTask(void *parameter) {
         ms_otacheck.start(i_otaCheck);
       }
 
+      if(ms_metrics.remaining() < 1) {
+        // Add a sample to the metrics history.
+        updateMetrics();
+
+        // Restart timer for next sample.
+        ms_metrics.start(i_metricsSample);
+      }
+
       // Try to start the external WiFi.
       if(!b_ext_wifi_started && !b_ext_wifi_paused) {
         b_ext_wifi_started = startExternalWifi();
       }
     }
 
+    // Renew the address with DHCP once a reused lease has run out.
+    checkWifiLease();
+
+    // Write any changed settings to NVS once saves have stopped.
+    checkSettingsFlush();
+
     vTaskDelay(1000 / portTICK_PERIOD_MS); // 1000ms delay
   }
 }
@@ -228,6 +246,7 @@ void WiFiSetupTask(void *parameter) {
     ms_cleanup.start(i_websocketCleanup);
     ms_apclient.start(i_apClientCount);
     ms_otacheck.start(i_otaCheck);
+    ms_metrics.start(i_metricsSample);
   }
 
   vTaskDelay(200 / portTICK_PERIOD_MS); // 200ms delay
@@ -0,0 +1,219 @@
+/**
+ *   GPStar Co-Simulation - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2023-2025 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *                         & Dustin Grau <dustin.grau@gmail.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Serial Framing
+ *
+ * A host copy of the packet format used by the SerialTransfer library (3.x) on every device:
+ *   0x7E | packet ID | overhead byte | payload length | payload (1-254 bytes) | CRC-8 | 0x81
+ * Any 0x7E in the payload is replaced by the distance to the next one (0 for the last), and the overhead
+ * byte holds the index of the first (0xFF if none). The CRC-8 (polynomial 0x9B) covers the stuffed payload.
+ * Frames built here are byte-identical to those sent by the firmware, so captures from the Attenuator
+ * can be decoded, and simulated devices can be fed exactly what a real one would send.
+ */
+const uint8_t i_frame_start = 0x7E;
+const uint8_t i_frame_stop = 0x81;
+const uint8_t i_frame_max_payload = 0xFE;
+const uint8_t i_frame_overhead = 6; // Bytes added around the payload.
+
+// CRC-8 with polynomial 0x9B, as calculated by SerialTransfer.
+uint8_t frameCRC(const uint8_t *p_data, uint8_t i_length) {
+  static uint8_t i_table[256];
+  static bool b_table = false;
+
+  if(!b_table) {
+    for(uint16_t i = 0; i < 256; i++) {
+      uint8_t i_crc = i;
+
+      for(uint8_t j = 0; j < 8; j++) {
+        i_crc = (i_crc & 0x80) ? (uint8_t)((i_crc << 1) ^ 0x9B) : (uint8_t)(i_crc << 1);
+      }
+
+      i_table[i] = i_crc;
+    }
+
+    b_table = true;
+  }
+
+  uint8_t i_crc = 0;
+
+  for(uint8_t i = 0; i < i_length; i++) {
+    i_crc = i_table[i_crc ^ p_data[i]];
+  }
+
+  return i_crc;
+}
+
+// Build a frame for a payload into p_frame (which must hold i_length + i_frame_overhead bytes), returning its size.
+uint16_t encodeFrame(uint8_t i_packet_id, const uint8_t *p_payload, uint8_t i_length, uint8_t *p_frame) {
+  if(i_length == 0 || i_length > i_frame_max_payload) {
+    return 0;
+  }
+
+  uint8_t *p_stuffed = p_frame + 4;
+  memcpy(p_stuffed, p_payload, i_length);
+
+  uint8_t i_overhead = 0xFF;
+  int16_t i_next = -1;
+
+  // Walk backwards so that each start byte can point at the one after it.
+  for(int16_t i = i_length - 1; i >= 0; i--) {
+    if(p_stuffed[i] == i_frame_start) {
+      p_stuffed[i] = (i_next < 0) ? 0 : (uint8_t)(i_next - i);
+      i_next = i;
+      i_overhead = i;
+    }
+  }
+
+  p_frame[0] = i_frame_start;
+  p_frame[1] = i_packet_id;
+  p_frame[2] = i_overhead;
+  p_frame[3] = i_length;
+  p_frame[4 + i_length] = frameCRC(p_stuffed, i_length);
+  p_frame[5 + i_length] = i_frame_stop;
+
+  return i_length + i_frame_overhead;
+}
+
+// Build a frame holding a packed struct, like SerialTransfer's txObj() followed by sendData().
+template <typename T>
+uint16_t encodeFrame(uint8_t i_packet_id, const T &obj, uint8_t *p_frame) {
+  static_assert(sizeof(T) <= i_frame_max_payload, "Object is too large for one frame.");
+  return encodeFrame(i_packet_id, (const uint8_t*) &obj, sizeof(T), p_frame);
+}
+
+enum FRAME_STATUS : uint8_t {
+  FRAME_CONTINUE,     // More bytes are needed.
+  FRAME_NEW_DATA,     // A complete, valid frame is ready.
+  FRAME_PAYLOAD_ERROR,
+  FRAME_CRC_ERROR,
+  FRAME_STOP_BYTE_ERROR
+};
+
+// Reassembles frames from a byte stream, following the same states as SerialTransfer's parser.
+class FrameParser {
+  public:
+    // Feed one received byte.
+    FRAME_STATUS parse(uint8_t i_byte) {
+      switch(STATE) {
+        case FIND_START:
+          if(i_byte == i_frame_start) {
+            STATE = FIND_ID;
+          }
+        break;
+
+        case FIND_ID:
+          i_packet_id = i_byte;
+          STATE = FIND_OVERHEAD;
+        break;
+
+        case FIND_OVERHEAD:
+          i_overhead = i_byte;
+          STATE = FIND_LENGTH;
+        break;
+
+        case FIND_LENGTH:
+          if(i_byte == 0 || i_byte > i_frame_max_payload) {
+            STATE = FIND_START;
+            return FRAME_PAYLOAD_ERROR;
+          }
+
+          i_length = i_byte;
+          i_index = 0;
+          STATE = FIND_PAYLOAD;
+        break;
+
+        case FIND_PAYLOAD:
+          payload[i_index++] = i_byte;
+
+          if(i_index == i_length) {
+            STATE = FIND_CRC;
+          }
+        break;
+
+        case FIND_CRC:
+          if(frameCRC(payload, i_length) != i_byte) {
+            STATE = FIND_START;
+            return FRAME_CRC_ERROR;
+          }
+
+          STATE = FIND_STOP;
+        break;
+
+        case FIND_STOP:
+          STATE = FIND_START;
+
+          if(i_byte != i_frame_stop) {
+            return FRAME_STOP_BYTE_ERROR;
+          }
+
+          unstuff();
+          return FRAME_NEW_DATA;
+      }
+
+      return FRAME_CONTINUE;
+    }
+
+    uint8_t packetId() const { return i_packet_id; }
+    uint8_t length() const { return i_length; }
+    const uint8_t* data() const { return payload; }
+
+    // Copy the payload into a packed struct, like SerialTransfer's rxObj(). Returns false if the sizes differ.
+    template <typename T>
+    bool read(T &obj) const {
+      if(i_length != sizeof(T)) {
+        return false;
+      }
+
+      memcpy(&obj, payload, sizeof(T));
+      return true;
+    }
+
+  private:
+    enum PARSER_STATES : uint8_t { FIND_START, FIND_ID, FIND_OVERHEAD, FIND_LENGTH, FIND_PAYLOAD, FIND_CRC, FIND_STOP };
+
+    PARSER_STATES STATE = FIND_START;
+    uint8_t i_packet_id = 0;
+    uint8_t i_overhead = 0xFF;
+    uint8_t i_length = 0;
+    uint8_t i_index = 0;
+    uint8_t payload[i_frame_max_payload];
+
+    // Restore the start bytes replaced when the frame was built.
+    void unstuff() {
+      uint8_t i_position = i_overhead;
+
+      while(i_position < i_length) {
+        uint8_t i_delta = payload[i_position];
+        payload[i_position] = i_frame_start;
+
+        if(i_delta == 0) {
+          break;
+        }
+
+        i_position += i_delta;
+      }
+    }
+};
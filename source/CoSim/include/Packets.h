@@ -0,0 +1,61 @@
+/**
+ *   GPStar Co-Simulation - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2023-2025 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *                         & Dustin Grau <dustin.grau@gmail.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "Communication.h" // Message IDs, taken from the pack firmware.
+
+/*
+ * Serial Packets
+ *
+ * Copies of the packet types and packed structs sent over the pack's serial links. These must match the
+ * definitions in ProtonPack/include/Serial.h, which the size checks below help to catch.
+ */
+enum PACKET_TYPE : uint8_t {
+  PACKET_UNKNOWN = 0,
+  PACKET_COMMAND = 1,
+  PACKET_DATA = 2,
+  PACKET_PACK = 3,
+  PACKET_WAND = 4,
+  PACKET_SMOKE = 5,
+  PACKET_SYNC = 6,
+  PACKET_MEMORY = 7
+};
+
+// For command signals (1 byte ID, 2 byte optional data).
+struct __attribute__((packed)) CommandPacket {
+  uint8_t s;
+  uint8_t c;
+  uint16_t d1; // Reserved for values over 255 (eg. current music track)
+  uint8_t e;
+};
+
+// For generic data communication (1 byte ID, 4 byte array).
+struct __attribute__((packed)) MessagePacket {
+  uint8_t s;
+  uint8_t m;
+  uint8_t d[3]; // Reserved for multiple, arbitrary byte values.
+  uint8_t e;
+};
+
+static_assert(sizeof(CommandPacket) == 5, "CommandPacket no longer matches the firmware.");
+static_assert(sizeof(MessagePacket) == 6, "MessagePacket no longer matches the firmware.");
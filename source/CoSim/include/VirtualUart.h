@@ -0,0 +1,145 @@
+/**
+ *   GPStar Co-Simulation - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2023-2025 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *                         & Dustin Grau <dustin.grau@gmail.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+/*
+ * Virtual UART
+ *
+ * One direction of an in-memory serial link, driven by a simulated clock in microseconds rather than by
+ * threads, so every run with the same seed gives the same result. Bytes written are delivered no earlier
+ * than the wire time at the configured baud rate (10 bits per byte, one after another), plus a random
+ * jitter, and each byte may be lost outright. Delivery order is always kept, as on a real UART.
+ */
+struct objUartConfig {
+  uint32_t baud = 9600;         // Line rate used by the pack for both the wand and the Attenuator.
+  uint16_t loss_per_mille = 0;  // Chance that a byte is lost, in 1/1000ths.
+  uint32_t jitter_us = 0;       // Largest extra delay added to a byte (us).
+  uint32_t seed = 1;            // Seed for the loss and jitter draws.
+};
+
+class VirtualUart {
+  public:
+    explicit VirtualUart(const objUartConfig &config = objUartConfig()) : config(config), i_random(config.seed ? config.seed : 1) {}
+
+    // Queue bytes sent at the given time.
+    void write(const uint8_t *p_data, uint16_t i_length, uint64_t i_now) {
+      uint64_t i_byte_time = 10000000ULL / config.baud;
+
+      for(uint16_t i = 0; i < i_length; i++) {
+        // The transmitter sends one byte at a time, starting no earlier than now.
+        i_line_free = (i_line_free > i_now ? i_line_free : i_now) + i_byte_time;
+        i_sent++;
+
+        if(config.loss_per_mille > 0 && next() % 1000 < config.loss_per_mille) {
+          i_lost++;
+          continue;
+        }
+
+        uint64_t i_due = i_line_free + (config.jitter_us > 0 ? next() % (config.jitter_us + 1) : 0);
+
+        // Jitter can delay a byte but never reorder it.
+        if(!pending.empty() && pending.back().i_due > i_due) {
+          i_due = pending.back().i_due;
+        }
+
+        pending.push_back({ i_due, p_data[i] });
+      }
+    }
+
+    // Number of bytes which have arrived by the given time.
+    uint16_t available(uint64_t i_now) const {
+      uint16_t i_count = 0;
+
+      for(const objPendingByte &pending_byte : pending) {
+        if(pending_byte.i_due > i_now) {
+          break;
+        }
+
+        i_count++;
+      }
+
+      return i_count;
+    }
+
+    // Take the next byte which has arrived by the given time, or -1 if there is none.
+    int16_t read(uint64_t i_now) {
+      if(pending.empty() || pending.front().i_due > i_now) {
+        return -1;
+      }
+
+      uint8_t i_byte = pending.front().i_byte;
+      pending.pop_front();
+
+      return i_byte;
+    }
+
+    // Time at which the next byte arrives, for stepping the clock straight to it.
+    bool nextArrival(uint64_t &i_time) const {
+      if(pending.empty()) {
+        return false;
+      }
+
+      i_time = pending.front().i_due;
+      return true;
+    }
+
+    uint32_t sent() const { return i_sent; }
+    uint32_t lost() const { return i_lost; }
+
+  private:
+    struct objPendingByte {
+      uint64_t i_due;
+      uint8_t i_byte;
+    };
+
+    objUartConfig config;
+    std::deque<objPendingByte> pending;
+    uint64_t i_line_free = 0; // Time the transmitter finishes the last byte queued.
+    uint32_t i_random;
+    uint32_t i_sent = 0;
+    uint32_t i_lost = 0;
+
+    // xorshift32, so runs are repeatable on any host.
+    uint32_t next() {
+      i_random ^= i_random << 13;
+      i_random ^= i_random >> 17;
+      i_random ^= i_random << 5;
+      return i_random;
+    }
+};
+
+// A full-duplex link between two devices.
+struct VirtualLink {
+  VirtualUart a_to_b;
+  VirtualUart b_to_a;
+
+  explicit VirtualLink(const objUartConfig &config = objUartConfig()) : a_to_b(config), b_to_a(reverse(config)) {}
+
+  private:
+    // The return direction draws its own losses and jitter.
+    static objUartConfig reverse(objUartConfig config) {
+      config.seed ^= 0x9E3779B9;
+      return config;
+    }
+};
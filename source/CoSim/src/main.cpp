@@ -0,0 +1,195 @@
+/**
+ *   GPStar Co-Simulation - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2023-2025 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *                         & Dustin Grau <dustin.grau@gmail.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "Framing.h"
+#include "Packets.h"
+#include "VirtualUart.h"
+
+/*
+ * Serial Link Co-Simulation
+ *
+ * Runs the framing layer across an in-memory UART between a simulated pack and Attenuator, with the
+ * same line rate as the real link. A run streams pack commands at a fixed interval and reports how many
+ * arrived intact, how many were lost or rejected by the parser, and the time from the pack sending each
+ * frame to the Attenuator decoding it. Further scenarios (sync, firing, overheat) can drive the same link.
+ */
+struct objScenario {
+  const char* name;
+  objUartConfig uart;
+  uint16_t i_frames;       // Commands sent by the pack.
+  uint32_t i_interval_us;  // Time between commands.
+  bool b_must_deliver;     // Whether every frame has to arrive for the run to pass.
+};
+
+struct objResult {
+  uint32_t i_delivered = 0;
+  uint32_t i_mismatched = 0; // Frames which decoded, but not to what was sent.
+  uint32_t i_rejected = 0;   // Frames dropped by the parser (length, CRC or stop byte).
+  uint64_t i_latency_min = UINT64_MAX;
+  uint64_t i_latency_max = 0;
+  uint64_t i_latency_total = 0;
+};
+
+// Check the framing against payloads holding start bytes at either end, in the middle and throughout.
+bool checkFraming() {
+  const std::vector<std::vector<uint8_t>> payloads = {
+    { 0x01 },
+    { i_frame_start },
+    { i_frame_start, 0x00, i_frame_start },
+    { 0x10, i_frame_start, i_frame_stop, 0x20, i_frame_start },
+    std::vector<uint8_t>(i_frame_max_payload, i_frame_start)
+  };
+
+  for(const std::vector<uint8_t> &payload : payloads) {
+    uint8_t frame[i_frame_max_payload + i_frame_overhead];
+    uint16_t i_size = encodeFrame(PACKET_DATA, payload.data(), payload.size(), frame);
+
+    // The start byte may only appear at the very beginning of a frame.
+    for(uint16_t i = 1; i < i_size - 2; i++) {
+      if(frame[i] == i_frame_start && i >= 4) {
+        return false;
+      }
+    }
+
+    FrameParser parser;
+    FRAME_STATUS STATUS = FRAME_CONTINUE;
+
+    for(uint16_t i = 0; i < i_size; i++) {
+      STATUS = parser.parse(frame[i]);
+    }
+
+    if(STATUS != FRAME_NEW_DATA || parser.packetId() != PACKET_DATA || parser.length() != payload.size() ||
+       memcmp(parser.data(), payload.data(), payload.size()) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+objResult runScenario(const objScenario &scenario) {
+  objResult result;
+  VirtualLink link(scenario.uart);
+  FrameParser attenuator;
+  std::deque<std::pair<uint64_t, CommandPacket>> in_flight; // Send time and content, oldest first.
+  uint64_t i_now = 0;
+  uint16_t i_sent = 0;
+  uint64_t i_next_send = 0;
+
+  while(i_sent < scenario.i_frames || link.a_to_b.available(UINT64_MAX) > 0) {
+    if(i_sent < scenario.i_frames && i_now >= i_next_send) {
+      // The pack sends a command, as serial1Send() would.
+      CommandPacket command = { P_COM_START, (uint8_t)(A_VOLUME_SYNC + (i_sent % 8)), (uint16_t)(i_sent * 257), P_COM_END };
+      uint8_t frame[sizeof(CommandPacket) + i_frame_overhead];
+      uint16_t i_size = encodeFrame(PACKET_COMMAND, command, frame);
+
+      link.a_to_b.write(frame, i_size, i_now);
+      in_flight.push_back({ i_now, command });
+      i_sent++;
+      i_next_send += scenario.i_interval_us;
+    }
+
+    // The Attenuator reads whatever has arrived.
+    int16_t i_byte;
+    while((i_byte = link.a_to_b.read(i_now)) >= 0) {
+      FRAME_STATUS STATUS = attenuator.parse((uint8_t) i_byte);
+      CommandPacket received;
+
+      if(STATUS == FRAME_NEW_DATA && attenuator.packetId() == PACKET_COMMAND && attenuator.read(received)) {
+        // Match against the oldest command not yet accounted for; anything older was lost.
+        while(!in_flight.empty() && memcmp(&in_flight.front().second, &received, sizeof(CommandPacket)) != 0) {
+          in_flight.pop_front();
+        }
+
+        if(in_flight.empty()) {
+          result.i_mismatched++;
+          continue;
+        }
+
+        uint64_t i_latency = i_now - in_flight.front().first;
+        in_flight.pop_front();
+
+        result.i_delivered++;
+        result.i_latency_total += i_latency;
+        result.i_latency_min = (i_latency < result.i_latency_min) ? i_latency : result.i_latency_min;
+        result.i_latency_max = (i_latency > result.i_latency_max) ? i_latency : result.i_latency_max;
+      }
+      else if(STATUS != FRAME_CONTINUE && STATUS != FRAME_NEW_DATA) {
+        result.i_rejected++;
+      }
+    }
+
+    // Step to whichever happens first: the next byte arriving or the next command being sent.
+    uint64_t i_arrival;
+    uint64_t i_step = (i_sent < scenario.i_frames) ? i_next_send : UINT64_MAX;
+
+    if(link.a_to_b.nextArrival(i_arrival) && i_arrival < i_step) {
+      i_step = i_arrival;
+    }
+
+    if(i_step == UINT64_MAX) {
+      break;
+    }
+
+    i_now = (i_step > i_now) ? i_step : i_now;
+  }
+
+  return result;
+}
+
+int main() {
+  if(!checkFraming()) {
+    printf("Framing check failed.\n");
+    return 1;
+  }
+
+  const objScenario scenarios[] = {
+    { "clean", { 9600, 0, 0, 1 }, 500, 20000, true },
+    { "jitter 2ms", { 9600, 0, 2000, 2 }, 500, 20000, true },
+    { "loss 1%, jitter 2ms", { 9600, 10, 2000, 3 }, 500, 20000, false },
+    { "back to back", { 9600, 0, 0, 4 }, 500, 0, true }
+  };
+
+  bool b_passed = true;
+
+  printf("%-22s %9s %9s %9s %11s %11s %11s\n", "scenario", "delivered", "rejected", "mismatch", "min (us)", "avg (us)", "max (us)");
+
+  for(const objScenario &scenario : scenarios) {
+    objResult result = runScenario(scenario);
+
+    printf("%-22s %5u/%-3u %9u %9u %11llu %11llu %11llu\n", scenario.name, result.i_delivered, scenario.i_frames,
+           result.i_rejected, result.i_mismatched,
+           (unsigned long long)(result.i_delivered ? result.i_latency_min : 0),
+           (unsigned long long)(result.i_delivered ? result.i_latency_total / result.i_delivered : 0),
+           (unsigned long long)result.i_latency_max);
+
+    if(result.i_mismatched > 0 || (scenario.b_must_deliver && result.i_delivered != scenario.i_frames)) {
+      b_passed = false;
+    }
+  }
+
+  return b_passed ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+/**
+ *   GPStar Ghost Trap - Ghostbusters Props, Mods, and Kits.
+ *   Copyright (C) 2025 Dustin Grau <dustin.grau@gmail.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Runtime Metrics
+ *
+ * GET /metrics returns Prometheus text, or JSON with ?format=json, so the device headroom can be watched over WiFi.
+ * Heap and CPU load are sampled into a short history by updateMetrics(), which the WiFi
+ * management task calls every i_metricsSample. Per-task CPU time and stack high-water marks are read when requested, and need a core
+ * built with the FreeRTOS trace facility and run time stats (as the Arduino ESP32 core is by default).
+ */
+#define METRICS_TASK_STATS (configUSE_TRACE_FACILITY == 1 && configGENERATE_RUN_TIME_STATS == 1)
+
+const uint8_t i_metrics_history_size = 30; // Samples kept, covering the last 5 minutes.
+
+struct MetricsSample {
+  uint32_t uptime; // Seconds since boot.
+  uint32_t heapFree;
+  uint32_t heapLargest; // Largest free block, which shows fragmentation when much lower than heapFree.
+  uint8_t coreLoad[2]; // Percent busy for each core since the previous sample.
+};
+
+MetricsSample metricsHistory[i_metrics_history_size];
+uint8_t i_metrics_head = 0; // Index where the next sample will be written.
+uint8_t i_metrics_count = 0; // Number of samples held.
+SemaphoreHandle_t metricsMutex = nullptr; // Guards the history between the WiFi management task and the web server.
+
+// Time and idle counters at the previous sample, used to turn the counters into loads.
+int64_t i_metrics_last_time = 0;
+#if METRICS_TASK_STATS
+  configRUN_TIME_COUNTER_TYPE i_metrics_last_idle[2] = {0, 0};
+#endif
+
+#if METRICS_TASK_STATS
+// Returns a snapshot of every task, which the caller must free(). The count is returned in i_tasks.
+TaskStatus_t* getTaskStats(UBaseType_t& i_tasks) {
+  i_tasks = uxTaskGetNumberOfTasks() + 2; // Room for tasks created while the array is allocated.
+  TaskStatus_t* p_tasks = (TaskStatus_t*) malloc(i_tasks * sizeof(TaskStatus_t));
+
+  if(p_tasks == nullptr) {
+    i_tasks = 0;
+    return nullptr;
+  }
+
+  i_tasks = uxTaskGetSystemState(p_tasks, i_tasks, NULL);
+  return p_tasks;
+}
+#endif
+
+// Add a sample to the history, replacing the oldest once it is full.
+void updateMetrics() {
+  if(metricsMutex == nullptr) {
+    return; // Web server not started yet.
+  }
+
+  int64_t i_now = esp_timer_get_time();
+  uint32_t i_elapsed = (uint32_t) (i_now - i_metrics_last_time); // Microseconds since the previous sample.
+
+  MetricsSample sample;
+  sample.uptime = (uint32_t) (i_now / 1000000);
+  sample.heapFree = esp_get_free_heap_size();
+  sample.heapLargest = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+  sample.coreLoad[0] = 0;
+  sample.coreLoad[1] = 0;
+
+  #if METRICS_TASK_STATS
+    // Each core is busy for whatever part of the interval its idle task did not run.
+    UBaseType_t i_tasks;
+    TaskStatus_t* p_tasks = getTaskStats(i_tasks);
+
+    for(UBaseType_t i = 0; i < i_tasks; i++) {
+      for(uint8_t i_core = 0; i_core < 2; i_core++) {
+        if(p_tasks[i].xHandle == xTaskGetIdleTaskHandleForCore(i_core)) {
+          uint32_t i_idle = (uint32_t) (p_tasks[i].ulRunTimeCounter - i_metrics_last_idle[i_core]);
+          sample.coreLoad[i_core] = (i_idle >= i_elapsed) ? 0 : (uint8_t) (100 - ((uint64_t) i_idle * 100 / i_elapsed));
+          i_metrics_last_idle[i_core] = p_tasks[i].ulRunTimeCounter;
+        }
+      }
+    }
+
+    free(p_tasks);
+  #endif
+
+  i_metrics_last_time = i_now;
+
+  xSemaphoreTake(metricsMutex, portMAX_DELAY);
+  metricsHistory[i_metrics_head] = sample;
+  i_metrics_head = (i_metrics_head + 1) % i_metrics_history_size;
+  if(i_metrics_count < i_metrics_history_size) {
+    i_metrics_count++;
+  }
+  xSemaphoreGive(metricsMutex);
+}
+
+// Copies the most recent sample, returning false before the first one.
+bool lastMetricsSample(MetricsSample& sample) {
+  if(metricsMutex == nullptr) {
+    return false;
+  }
+
+  xSemaphoreTake(metricsMutex, portMAX_DELAY);
+  bool b_found = (i_metrics_count > 0);
+  if(b_found) {
+    sample = metricsHistory[(i_metrics_head + i_metrics_history_size - 1) % i_metrics_history_size];
+  }
+  xSemaphoreGive(metricsMutex);
+
+  return b_found;
+}
+
+void sendMetricsPrometheus(AsyncWebServerRequest *request) {
+  AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+  uint32_t i_heap_free = esp_get_free_heap_size();
+  uint32_t i_heap_largest = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+
+  response->printf("gpstar_uptime_seconds %llu\n", esp_timer_get_time() / 1000000);
+  response->printf("gpstar_heap_free_bytes %lu\n", i_heap_free);
+  response->printf("gpstar_heap_min_free_bytes %lu\n", esp_get_minimum_free_heap_size());
+  response->printf("gpstar_heap_largest_block_bytes %lu\n", i_heap_largest);
+  response->printf("gpstar_heap_fragmentation_percent %lu\n", (i_heap_free > 0) ? 100 - (i_heap_largest * 100 / i_heap_free) : 0);
+
+  MetricsSample sample;
+  if(lastMetricsSample(sample)) {
+    response->printf("gpstar_cpu_load_percent{core=\"0\"} %u\n", sample.coreLoad[0]);
+    response->printf("gpstar_cpu_load_percent{core=\"1\"} %u\n", sample.coreLoad[1]);
+  }
+
+  #if METRICS_TASK_STATS
+    UBaseType_t i_tasks;
+    TaskStatus_t* p_tasks = getTaskStats(i_tasks);
+
+    for(UBaseType_t i = 0; i < i_tasks; i++) {
+      response->printf("gpstar_task_runtime_seconds_total{task=\"%s\"} %.3f\n", p_tasks[i].pcTaskName, p_tasks[i].ulRunTimeCounter / 1000000.0);
+      response->printf("gpstar_task_stack_free_bytes{task=\"%s\"} %lu\n", p_tasks[i].pcTaskName, (uint32_t) p_tasks[i].usStackHighWaterMark);
+    }
+
+    free(p_tasks);
+  #endif
+
+  response->printf("gpstar_websocket_clients %u\n", ws.count());
+  for(const AsyncWebSocketClient& client : ws.getClients()) {
+    response->printf("gpstar_websocket_queue_messages{client=\"%lu\"} %u\n", client.id(), client.queueLen());
+  }
+
+  request->send(response);
+}
+
+void sendMetricsJson(AsyncWebServerRequest *request) {
+  JsonDocument jsonBody;
+  uint32_t i_heap_free = esp_get_free_heap_size();
+  uint32_t i_heap_largest = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+
+  jsonBody["uptime"] = (uint32_t) (esp_timer_get_time() / 1000000);
+  jsonBody["heapFree"] = i_heap_free;
+  jsonBody["heapMinFree"] = esp_get_minimum_free_heap_size();
+  jsonBody["heapLargest"] = i_heap_largest;
+  jsonBody["heapFragmentation"] = (i_heap_free > 0) ? 100 - (i_heap_largest * 100 / i_heap_free) : 0;
+
+  #if METRICS_TASK_STATS
+    UBaseType_t i_tasks;
+    TaskStatus_t* p_tasks = getTaskStats(i_tasks);
+    JsonArray tasks = jsonBody["tasks"].to<JsonArray>();
+
+    for(UBaseType_t i = 0; i < i_tasks; i++) {
+      JsonObject task = tasks.add<JsonObject>();
+      task["name"] = p_tasks[i].pcTaskName;
+      task["runtime"] = p_tasks[i].ulRunTimeCounter / 1000000.0; // Seconds of CPU time since boot.
+      task["stackFree"] = p_tasks[i].usStackHighWaterMark;
+      task["priority"] = p_tasks[i].uxCurrentPriority;
+    }
+
+    free(p_tasks);
+  #endif
+
+  JsonArray queues = jsonBody["wsQueues"].to<JsonArray>();
+  for(const AsyncWebSocketClient& client : ws.getClients()) {
+    queues.add(client.queueLen());
+  }
+
+  // History, oldest first.
+  JsonArray history = jsonBody["history"].to<JsonArray>();
+  if(metricsMutex != nullptr) {
+    xSemaphoreTake(metricsMutex, portMAX_DELAY);
+
+    for(uint8_t i = 0; i < i_metrics_count; i++) {
+      const MetricsSample& sample = metricsHistory[(i_metrics_head + i_metrics_history_size - i_metrics_count + i) % i_metrics_history_size];
+      JsonObject entry = history.add<JsonObject>();
+      entry["uptime"] = sample.uptime;
+      entry["heapFree"] = sample.heapFree;
+      entry["heapLargest"] = sample.heapLargest;
+      entry["core0"] = sample.coreLoad[0];
+      entry["core1"] = sample.coreLoad[1];
+    }
+
+    xSemaphoreGive(metricsMutex);
+  }
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  serializeJson(jsonBody, *response);
+  request->send(response);
+}
+
+void handleGetMetrics(AsyncWebServerRequest *request) {
+  if(request->hasParam("format") && request->getParam("format")->value() == "json") {
+    sendMetricsJson(request);
+  }
+  else {
+    sendMetricsPrometheus(request);
+  }
+}
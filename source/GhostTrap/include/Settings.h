@@ -0,0 +1,205 @@
+/**
+ *   GPStar Ghost Trap - Ghostbusters Props, Mods, and Kits.
+ *   Copyright (C) 2025 Dustin Grau <dustin.grau@gmail.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <Preferences.h>
+#include <nvs.h>
+
+/*
+ * Settings Cache
+ *
+ * The "device", "credentials" and "network" namespaces are read from NVS once at boot by loadSettings()
+ * and served from RAM afterwards. A save only updates RAM and marks its namespace as dirty; once saves
+ * have been quiet for i_settingsFlush the dirty namespaces are written with one NVS commit each, so a
+ * burst of saves becomes a single flash write. Anything still dirty is written when the device restarts.
+ * The WiFi credential and network handlers flush straight away instead, as a power-off may follow them.
+ * Take settingsMutex around any access to the cached values or to markSettingsDirty().
+ */
+enum SETTINGS_NAMESPACES : uint8_t {
+  SETTINGS_DEVICE = 0x01,
+  SETTINGS_CREDENTIALS = 0x02,
+  SETTINGS_NETWORK = 0x04
+};
+
+// Private WiFi (AP) settings. Empty values mean the device defaults should be used.
+struct objCredentialSettings {
+  bool stored = false; // Namespace was found in NVS at boot.
+  String ssid;
+  String password;
+};
+
+// Preferred external WiFi network settings.
+struct objNetworkSettings {
+  bool enabled = false;
+  String ssid;
+  String password;
+  String address;
+  String subnet;
+  String gateway;
+
+  // Access point from the last successful connection, used to rejoin without a scan.
+  uint8_t bssid[6] = {0, 0, 0, 0, 0, 0};
+  uint8_t channel = 0; // 0 when nothing is cached.
+};
+
+// The "device" namespace is cached in the runtime globals (DISPLAY_TYPE).
+objCredentialSettings credentialSettings;
+objNetworkSettings networkSettings;
+
+const uint16_t i_settingsFlush = 2000; // Quiet time after the last save before writing to NVS (ms).
+millisDelay ms_settings;
+uint8_t i_settings_dirty = 0; // SETTINGS_NAMESPACES which differ from NVS.
+SemaphoreHandle_t settingsMutex = nullptr; // Guards the cached settings between the web server and the flush.
+
+// Mark a namespace for the next flush, restarting the quiet period. Call with settingsMutex held.
+void markSettingsDirty(uint8_t i_namespace) {
+  i_settings_dirty |= i_namespace;
+  ms_settings.start(i_settingsFlush);
+}
+
+// Write every dirty namespace to NVS with one commit per namespace.
+void flushSettings() {
+  if(settingsMutex == nullptr) {
+    return;
+  }
+
+  xSemaphoreTake(settingsMutex, portMAX_DELAY);
+
+  nvs_handle_t h_nvs;
+
+  if((i_settings_dirty & SETTINGS_DEVICE) && nvs_open("device", NVS_READWRITE, &h_nvs) == ESP_OK) {
+    // Same key type as the Preferences library (putShort is an i16).
+    nvs_set_i16(h_nvs, "display_type", DISPLAY_TYPE);
+
+    if(nvs_commit(h_nvs) == ESP_OK) {
+      i_settings_dirty &= ~SETTINGS_DEVICE;
+    }
+
+    nvs_close(h_nvs);
+  }
+
+  if((i_settings_dirty & SETTINGS_CREDENTIALS) && nvs_open("credentials", NVS_READWRITE, &h_nvs) == ESP_OK) {
+    nvs_set_str(h_nvs, "ssid", credentialSettings.ssid.c_str());
+    nvs_set_str(h_nvs, "password", credentialSettings.password.c_str());
+
+    if(nvs_commit(h_nvs) == ESP_OK) {
+      i_settings_dirty &= ~SETTINGS_CREDENTIALS;
+    }
+
+    nvs_close(h_nvs);
+  }
+
+  if((i_settings_dirty & SETTINGS_NETWORK) && nvs_open("network", NVS_READWRITE, &h_nvs) == ESP_OK) {
+    nvs_set_u8(h_nvs, "enabled", networkSettings.enabled);
+    nvs_set_str(h_nvs, "ssid", networkSettings.ssid.c_str());
+    nvs_set_str(h_nvs, "password", networkSettings.password.c_str());
+    nvs_set_str(h_nvs, "address", networkSettings.address.c_str());
+    nvs_set_str(h_nvs, "subnet", networkSettings.subnet.c_str());
+    nvs_set_str(h_nvs, "gateway", networkSettings.gateway.c_str());
+    nvs_set_blob(h_nvs, "bssid", networkSettings.bssid, sizeof(networkSettings.bssid));
+    nvs_set_u8(h_nvs, "channel", networkSettings.channel);
+
+    if(nvs_commit(h_nvs) == ESP_OK) {
+      i_settings_dirty &= ~SETTINGS_NETWORK;
+    }
+
+    nvs_close(h_nvs);
+  }
+
+  if(i_settings_dirty != 0) {
+    // Try again later for anything which could not be written.
+    ms_settings.start(i_settingsFlush);
+  }
+
+  xSemaphoreGive(settingsMutex);
+}
+
+// Flush once saves have been quiet for long enough.
+void checkSettingsFlush() {
+  if(settingsMutex == nullptr) {
+    return;
+  }
+
+  xSemaphoreTake(settingsMutex, portMAX_DELAY);
+  bool b_flush = ms_settings.justFinished() && i_settings_dirty != 0;
+  xSemaphoreGive(settingsMutex);
+
+  if(b_flush) {
+    flushSettings();
+  }
+}
+
+// Read all namespaces into RAM. Must run once after NVS is initialized and before WiFi is started.
+void loadSettings() {
+  settingsMutex = xSemaphoreCreateMutex();
+  esp_register_shutdown_handler(flushSettings);
+
+  Preferences preferences;
+
+  /*
+   * Get Local Device Preferences
+   * Accesses the "device" namespace in read-only mode under the "nvs" partition.
+   */
+  if(preferences.begin("device", true)) {
+    switch(preferences.getShort("display_type", 0)) {
+      case 0:
+        DISPLAY_TYPE = STATUS_TEXT;
+      break;
+      case 1:
+        DISPLAY_TYPE = STATUS_GRAPHIC;
+      break;
+      case 2:
+      default:
+        DISPLAY_TYPE = STATUS_BOTH;
+      break;
+    }
+    preferences.end();
+  }
+  else {
+    // If namespace is not initialized, store the defaults on the next flush.
+    markSettingsDirty(SETTINGS_DEVICE);
+  }
+
+  // Credentials default to values derived from the MAC address, so those are stored when the AP starts.
+  if(preferences.begin("credentials", true)) {
+    credentialSettings.stored = true;
+    credentialSettings.ssid = preferences.getString("ssid", "");
+    credentialSettings.password = preferences.getString("password", "");
+    preferences.end();
+  }
+
+  if(preferences.begin("network", true)) {
+    networkSettings.enabled = preferences.getBool("enabled", false);
+    networkSettings.ssid = preferences.getString("ssid", user_wifi_ssid);
+    networkSettings.password = preferences.getString("password", user_wifi_pass);
+    networkSettings.address = preferences.getString("address", "");
+    networkSettings.subnet = preferences.getString("subnet", "");
+    networkSettings.gateway = preferences.getString("gateway", "");
+
+    if(preferences.getBytes("bssid", networkSettings.bssid, sizeof(networkSettings.bssid)) == sizeof(networkSettings.bssid)) {
+      networkSettings.channel = preferences.getUChar("channel", 0);
+    }
+    preferences.end();
+  }
+  else {
+    // If namespace is not initialized, store the (disabled) defaults on the next flush.
+    markSettingsDirty(SETTINGS_NETWORK);
+  }
+}
@@ -29,6 +29,7 @@
 #include "Style.h" // STYLE_page
 #include "Equip.h" // EQUIP_svg
 #include "Icon.h" // FAVICON_ico, FAVICON_svg
+#include "Metrics.h" // handleGetMetrics
 
 // Forward function declarations.
 void notifyWSClients();
@@ -39,8 +40,6 @@ void stopSmoke();
 /*
  * Web Handler Functions - Performs actions or returns data for web UI
  */
-JsonDocument jsonBody; // Used for processing JSON body/payload data.
-JsonDocument jsonSuccess; // Used for sending JSON status as success.
 String status; // Holder for simple "status: success" response.
 
 void onWebSocketEventHandler(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
@@ -82,11 +81,16 @@ void onWebSocketEventHandler(AsyncWebSocket *server, AsyncWebSocketClient *clien
 }
 
 void startWebServer() {
+  // Guards the metrics history shared by the web server and the WiFi management task.
+  if(metricsMutex == nullptr) {
+    metricsMutex = xSemaphoreCreateMutex();
+  }
+
   // Configures URI routing with function handlers.
   setupRouting();
 
   // Prepare a standard "success" message for responses.
-  jsonSuccess.clear();
+  JsonDocument jsonSuccess;
   jsonSuccess["status"] = "success";
   serializeJson(jsonSuccess, status);
 
@@ -180,10 +184,9 @@ void handleFavSvg(AsyncWebServerRequest *request) {
   request->send(response);
 }
 
-String getDeviceConfig() {
+void writeDeviceConfig(Print& output) {
   // Prepare a JSON object with information we have gleamed from the system.
-  String equipSettings;
-  jsonBody.clear();
+  JsonDocument jsonBody;
 
   // Provide current values for the device.
   jsonBody["displayType"] = DISPLAY_TYPE;
@@ -197,84 +200,58 @@ String getDeviceConfig() {
   jsonBody["openedSmokeDuration"] = i_smoke_opened_duration / 1000; // Convert MS to Seconds.
   jsonBody["closedSmokeDuration"] = i_smoke_closed_duration / 1000; // Convert MS to Seconds.
 
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, equipSettings);
-  return equipSettings;
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
 }
 
-String getEquipmentStatus() {
-  // Prepare a JSON object with information we have gleamed from the system.
-  String equipStatus;
-  jsonBody.clear();
-
+void buildEquipmentStatus(JsonDocument& jsonBody) {
+  // Fill the caller's JSON object with information we have gleamed from the system.
   jsonBody["smokeEnabled"] = b_smoke_enabled;
   jsonBody["doorState"] = (DOOR_STATE == DOORS_OPENED) ? "Opened" : "Closed";
   jsonBody["apClients"] = i_ap_client_count;
   jsonBody["wsClients"] = i_ws_client_count;
-
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, equipStatus);
-  return equipStatus;
 }
 
-String getWifiSettings() {
+void writeWifiSettings(Print& output) {
   // Prepare a JSON object with information stored in preferences (or a blank default).
-  String wifiNetwork;
-  jsonBody.clear();
-
-  // Accesses namespace in read-only mode.
-  if(preferences.begin("network", true)) {
-    jsonBody["enabled"] = preferences.getBool("enabled", false);
-    jsonBody["network"] = preferences.getString("ssid");
-    jsonBody["password"] = preferences.getString("password");
-
-    jsonBody["address"] = preferences.getString("address");
-    if(jsonBody["address"].as<String>() == "") {
-      jsonBody["address"] = wifi_address;
-    }
-
-    jsonBody["subnet"] = preferences.getString("subnet");
-    if(jsonBody["subnet"].as<String>() == "") {
-      jsonBody["subnet"] = wifi_subnet;
-    }
-
-    jsonBody["gateway"] = preferences.getString("gateway");
-    if(jsonBody["gateway"].as<String>() == "") {
-      jsonBody["gateway"] = wifi_gateway;
-    }
-
-    preferences.end();
-  }
-  else {
-    if(preferences.begin("network", false)) {
-      preferences.putBool("enabled", false);
-      preferences.putString("ssid", "");
-      preferences.putString("password", "");
-      preferences.putString("address", "");
-      preferences.putString("subnet", "");
-      preferences.putString("gateway", "");
-      preferences.end();
-    }
-  }
-
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, wifiNetwork);
-  return wifiNetwork;
+  JsonDocument jsonBody;
+
+  // Served from the settings cache, as flash is only read at boot.
+  xSemaphoreTake(settingsMutex, portMAX_DELAY);
+  jsonBody["enabled"] = networkSettings.enabled;
+  jsonBody["network"] = networkSettings.ssid;
+  jsonBody["password"] = networkSettings.password;
+  jsonBody["address"] = (networkSettings.address != "") ? networkSettings.address : wifi_address;
+  jsonBody["subnet"] = (networkSettings.subnet != "") ? networkSettings.subnet : wifi_subnet;
+  jsonBody["gateway"] = (networkSettings.gateway != "") ? networkSettings.gateway : wifi_gateway;
+  xSemaphoreGive(settingsMutex);
+
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
 }
 
 void handleGetDeviceConfig(AsyncWebServerRequest *request) {
-  // Return current device settings as a stringified JSON object.
-  request->send(200, "application/json", getDeviceConfig());
+  // Return current device settings as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writeDeviceConfig(*response);
+  request->send(response);
 }
 
 void handleGetStatus(AsyncWebServerRequest *request) {
-  // Return current system status as a stringified JSON object.
-  request->send(200, "application/json", getEquipmentStatus());
+  // Return current system status as a JSON object, written straight into the response.
+  JsonDocument jsonBody;
+  buildEquipmentStatus(jsonBody);
+
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  serializeJson(jsonBody, *response);
+  request->send(response);
 }
 
 void handleGetWifi(AsyncWebServerRequest *request) {
-  // Return current system status as a stringified JSON object.
-  request->send(200, "application/json", getWifiSettings());
+  // Return current system status as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writeWifiSettings(*response);
+  request->send(response);
 }
 
 void handleRestart(AsyncWebServerRequest *request) {
@@ -286,7 +263,7 @@ void handleRestart(AsyncWebServerRequest *request) {
 
 // Handles the JSON body for the pack settings save request.
 AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHandler("/config/device/save", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -304,15 +281,19 @@ AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHa
     // Update the private network name ONLY if the new value differs from the current SSID.
     if(newSSID != ap_ssid){
       if(newSSID.length() >= 8 && newSSID.length() <= 32) {
-        // Accesses namespace in read/write mode.
-        if(preferences.begin("credentials", false)) {
-          #if defined(DEBUG_SEND_TO_CONSOLE)
-            Serial.print(F("New Private SSID: "));
-            Serial.println(newSSID);
-          #endif
-          preferences.putString("ssid", newSSID); // Store SSID in case this was altered.
-          preferences.end();
-        }
+        #if defined(DEBUG_SEND_TO_CONSOLE)
+          Serial.print(F("New Private SSID: "));
+          Serial.println(newSSID);
+        #endif
+
+        // Store SSID in case this was altered.
+        xSemaphoreTake(settingsMutex, portMAX_DELAY);
+        credentialSettings.ssid = newSSID;
+        markSettingsDirty(SETTINGS_CREDENTIALS);
+        xSemaphoreGive(settingsMutex);
+
+        // The new name only takes effect after a restart, so write it to NVS now.
+        flushSettings();
 
         b_ssid_changed = true; // This will cause a reboot of the device after saving.
       }
@@ -361,11 +342,10 @@ AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHa
       i_smoke_closed_duration = jsonBody["closedSmokeDuration"].as<uint8_t>() * 1000; // Convert to MS.
     }
 
-    // Accesses namespace in read/write mode.
-    if(preferences.begin("device", false)) {
-      preferences.putShort("display_type", DISPLAY_TYPE);
-      preferences.end();
-    }
+    // The device settings are written to flash from their globals on the next flush.
+    xSemaphoreTake(settingsMutex, portMAX_DELAY);
+    markSettingsDirty(SETTINGS_DEVICE);
+    xSemaphoreGive(settingsMutex);
 
     if(b_ssid_changed){
       jsonBody.clear();
@@ -390,7 +370,7 @@ AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHa
 
 // Handles the JSON body for the password change request.
 AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHandler("/password/update", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -404,15 +384,19 @@ AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHan
 
     // Password is used for the built-in Access Point ability, which will be used when a preferred network is not available.
     if(newPasswd.length() >= 8) {
-      // Accesses namespace in read/write mode.
-      if(preferences.begin("credentials", false)) {
-        #if defined(DEBUG_SEND_TO_CONSOLE)
-          Serial.print(F("New Private WiFi Password: "));
-          Serial.println(newPasswd);
-        #endif
-        preferences.putString("password", newPasswd); // Store user-provided password.
-        preferences.end();
-      }
+      #if defined(DEBUG_SEND_TO_CONSOLE)
+        Serial.print(F("New Private WiFi Password: "));
+        Serial.println(newPasswd);
+      #endif
+
+      // Store user-provided password.
+      xSemaphoreTake(settingsMutex, portMAX_DELAY);
+      credentialSettings.password = newPasswd;
+      markSettingsDirty(SETTINGS_CREDENTIALS);
+      xSemaphoreGive(settingsMutex);
+
+      // Write the new password now, as the device is likely to be restarted or powered off next.
+      flushSettings();
 
       jsonBody.clear();
       jsonBody["status"] = "Password updated, restart required. Please enter your new WiFi password when prompted by your device.";
@@ -438,7 +422,7 @@ AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHan
 
 // Handles the JSON body for the wifi network info.
 AsyncCallbackJsonWebHandler *wifiChangeHandler = new AsyncCallbackJsonWebHandler("/wifi/update", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -458,35 +442,37 @@ AsyncCallbackJsonWebHandler *wifiChangeHandler = new AsyncCallbackJsonWebHandler
 
     // If no errors encountered, continue with storing a preferred network (with credentials and IP information).
     if(wifiNetwork.length() >= 2 && wifiPasswd.length() >= 8) {
-      // Accesses namespace in read/write mode.
-      if(preferences.begin("network", false)) {
-        // Clear old network IP info if SSID or password have been changed.
-        String old_ssid = preferences.getString("ssid", "");
-        String old_passwd = preferences.getString("password", "");
-        if(old_ssid == "" || old_ssid != wifiNetwork || old_passwd == "" || old_passwd != wifiPasswd) {
-          preferences.putString("address", "");
-          preferences.putString("subnet", "");
-          preferences.putString("gateway", "");
-        }
-
-        // Store the critical values to enable/disable the external WiFi.
-        preferences.putBool("enabled", b_enabled);
-        preferences.putString("ssid", wifiNetwork);
-        preferences.putString("password", wifiPasswd);
+      xSemaphoreTake(settingsMutex, portMAX_DELAY);
+
+      // Clear old network IP info if SSID or password have been changed.
+      if(networkSettings.ssid == "" || networkSettings.ssid != wifiNetwork || networkSettings.password == "" || networkSettings.password != wifiPasswd) {
+        networkSettings.address = "";
+        networkSettings.subnet = "";
+        networkSettings.gateway = "";
+        forgetAccessPoint();
+      }
 
-        // Continue saving only if network values are 7 characters or more (eg. N.N.N.N)
-        if(localAddr.length() >= 7 && localAddr != wifi_address) {
-          preferences.putString("address", localAddr);
-        }
-        if(subnetMask.length() >= 7 && subnetMask != wifi_subnet) {
-          preferences.putString("subnet", subnetMask);
-        }
-        if(gatewayIP.length() >= 7 && gatewayIP != wifi_gateway) {
-          preferences.putString("gateway", gatewayIP);
-        }
+      // Store the critical values to enable/disable the external WiFi.
+      networkSettings.enabled = b_enabled;
+      networkSettings.ssid = wifiNetwork;
+      networkSettings.password = wifiPasswd;
 
-        preferences.end();
+      // Continue saving only if network values are 7 characters or more (eg. N.N.N.N)
+      if(localAddr.length() >= 7 && localAddr != wifi_address) {
+        networkSettings.address = localAddr;
+      }
+      if(subnetMask.length() >= 7 && subnetMask != wifi_subnet) {
+        networkSettings.subnet = subnetMask;
       }
+      if(gatewayIP.length() >= 7 && gatewayIP != wifi_gateway) {
+        networkSettings.gateway = gatewayIP;
+      }
+
+      markSettingsDirty(SETTINGS_NETWORK);
+      xSemaphoreGive(settingsMutex);
+
+      // Write the network settings now rather than after the quiet period.
+      flushSettings();
     }
 
     if(!b_errors) {
@@ -572,7 +558,7 @@ void handleSmokeRun(AsyncWebServerRequest *request) {
   else {
     // Tell the user why the requested action failed.
     String result;
-    jsonBody.clear();
+    JsonDocument jsonBody;
     jsonBody["status"] = "Invalid duration specified";
     serializeJson(jsonBody, result); // Serialize to string.
     request->send(200, "application/json", result);
@@ -611,6 +597,7 @@ void setupRouting() {
   httpServer.on("/config/device", HTTP_GET, handleGetDeviceConfig);
   httpServer.on("/status", HTTP_GET, handleGetStatus);
   httpServer.on("/restart", HTTP_DELETE, handleRestart);
+  httpServer.on("/metrics", HTTP_GET, handleGetMetrics);
   httpServer.on("/wifi/settings", HTTP_GET, handleGetWifi);
   httpServer.on("/smoke/enable", HTTP_PUT, handleSmokeEnable);
   httpServer.on("/smoke/disable", HTTP_PUT, handleSmokeDisable);
@@ -626,6 +613,11 @@ void setupRouting() {
 
 // Send notification to all websocket clients.
 void notifyWSClients() {
-  // Send latest status to all connected clients.
-  ws.textAll(getEquipmentStatus());
+  // Send latest status to all connected clients, serialized once into a buffer which they all share.
+  JsonDocument jsonBody;
+  buildEquipmentStatus(jsonBody);
+
+  AsyncWebSocketSharedBuffer buffer = std::make_shared<std::vector<uint8_t>>(measureJson(jsonBody));
+  serializeJson(jsonBody, (char*) buffer->data(), buffer->size());
+  ws.textAll(buffer);
 }
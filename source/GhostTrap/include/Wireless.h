@@ -37,7 +37,6 @@
  *
  * https://docs.espressif.com/projects/esp-idf/en/latest/esp32/api-guides/coexist.html
  */
-#include <Preferences.h>
 #include <WiFi.h>
 #include <WiFiAP.h>
 #include <ESPmDNS.h>
@@ -45,11 +44,10 @@
 #include <ESPAsyncWebServer.h>
 #include <ElegantOTA.h>
 
-// Preferences for SSID and AP password, which will use a "credentials" namespace.
-Preferences preferences;
-
 // Set up values for the SSID and password for the built-in WiFi access point (AP).
 const uint8_t i_max_attempts = 3; // Max attempts to establish a external WiFi connection.
+const uint16_t i_connect_timeout = 1500; // Time allowed for each connection attempt (ms).
+const uint16_t i_fast_connect_timeout = 1000; // Time allowed to rejoin the cached access point (ms).
 const String ap_ssid_prefix = "GhostTrap"; // This will be the base of the SSID name.
 String ap_default_passwd = "555-2368"; // This will be the default password for the AP.
 String ap_ssid; // Reserved for holding the full, private AP name for this device.
@@ -93,6 +91,10 @@ const uint16_t i_apClientCount = 200;
 millisDelay ms_otacheck;
 const uint16_t i_otaCheck = 100;
 
+// Create timer for the runtime metrics history.
+millisDelay ms_metrics;
+const uint16_t i_metricsSample = 10000;
+
 // Convert an IP address string to an IPAddress object.
 IPAddress convertToIP(String ipAddressString) {
   uint16_t quads[4]; // Array to store 4 quads for the IP.
@@ -141,6 +143,142 @@ String sanitizeSSID(String input) {
  * WiFi Management Functions
  */
 
+// Wait for the station to join the network, returning true once it has.
+bool waitForStation(uint16_t i_timeout) {
+  uint32_t i_start = millis();
+
+  while(WiFi.status() != WL_CONNECTED && millis() - i_start < i_timeout) {
+    delay(20);
+  }
+
+  return WiFi.status() == WL_CONNECTED;
+}
+
+/*
+ * The DHCP lease of the last connection is kept in RTC memory, which survives a restart but not a power
+ * cycle. The WiFi library does not report the lease time granted by the server, so a lease is trusted for
+ * i_lease_reuse_time after it was obtained from DHCP; the system clock keeps counting across a restart.
+ * An address applied from the stored lease is never stored again, and once the lease is no longer valid
+ * checkWifiLease() rejoins the network so the address is leased from the server again.
+ */
+const uint32_t i_lease_magic = 0x4C454153; // Marks wifiLease as valid, as RTC memory is random after power on.
+const uint32_t i_lease_reuse_time = 1800; // Seconds a lease is reused, kept below the shortest common lease time.
+
+struct objWifiLease {
+  uint32_t magic;
+  uint8_t bssid[6]; // Access point which issued the lease.
+  uint32_t address;
+  uint32_t subnet;
+  uint32_t gateway;
+  uint32_t dns;
+  time_t acquired; // System time when the lease was obtained from DHCP (seconds).
+  uint32_t duration; // Seconds the lease may be reused after it was acquired.
+};
+
+RTC_NOINIT_ATTR objWifiLease wifiLease;
+bool b_lease_reused = false; // The current address was applied from wifiLease rather than obtained from DHCP.
+
+// Returns true while the stored lease may be reused.
+bool leaseValid() {
+  if(wifiLease.magic != i_lease_magic) {
+    return false;
+  }
+
+  time_t i_now = time(nullptr);
+
+  return i_now >= wifiLease.acquired && (uint32_t) (i_now - wifiLease.acquired) < wifiLease.duration;
+}
+
+// Clear the cached access point and lease so the next connection does a full scan. Call with settingsMutex held.
+void forgetAccessPoint() {
+  memset(networkSettings.bssid, 0, sizeof(networkSettings.bssid));
+  networkSettings.channel = 0;
+  wifiLease.magic = 0;
+}
+
+// Remember the access point (and DHCP lease, unless a static IP is used) of the current connection.
+void cacheAccessPoint(bool b_static_ip) {
+  uint8_t* p_bssid = WiFi.BSSID();
+  uint8_t i_channel = WiFi.channel();
+
+  if(p_bssid == nullptr) {
+    return;
+  }
+
+  if(b_static_ip) {
+    wifiLease.magic = 0;
+  }
+  else if(!b_lease_reused) {
+    // Only an address which came from DHCP starts a new lease.
+    wifiLease.magic = i_lease_magic;
+    memcpy(wifiLease.bssid, p_bssid, sizeof(wifiLease.bssid));
+    wifiLease.address = WiFi.localIP();
+    wifiLease.subnet = WiFi.subnetMask();
+    wifiLease.gateway = WiFi.gatewayIP();
+    wifiLease.dns = WiFi.dnsIP(0);
+    wifiLease.acquired = time(nullptr);
+    wifiLease.duration = i_lease_reuse_time;
+  }
+
+  // Only write to flash when the access point differs from the last connection.
+  xSemaphoreTake(settingsMutex, portMAX_DELAY);
+  if(memcmp(networkSettings.bssid, p_bssid, sizeof(networkSettings.bssid)) != 0 || networkSettings.channel != i_channel) {
+    memcpy(networkSettings.bssid, p_bssid, sizeof(networkSettings.bssid));
+    networkSettings.channel = i_channel;
+    markSettingsDirty(SETTINGS_NETWORK);
+  }
+  xSemaphoreGive(settingsMutex);
+}
+
+// Rejoin the access point from the last connection on its known channel, which skips the scan. Without a
+// static IP a still valid lease from that access point is reused as well, which also skips DHCP.
+// Returns false (and leaves the station on DHCP) if the access point could not be joined.
+bool fastConnectWifi(bool b_static_ip) {
+  b_lease_reused = false;
+
+  xSemaphoreTake(settingsMutex, portMAX_DELAY);
+  uint8_t bssid[6];
+  memcpy(bssid, networkSettings.bssid, sizeof(bssid));
+  uint8_t i_channel = networkSettings.channel;
+  xSemaphoreGive(settingsMutex);
+
+  if(i_channel == 0) {
+    return false; // Nothing cached yet.
+  }
+
+  bool b_lease = !b_static_ip && leaseValid() && memcmp(wifiLease.bssid, bssid, sizeof(bssid)) == 0;
+
+  #if defined(DEBUG_WIRELESS_SETUP)
+    Serial.print(F("Rejoining cached access point on channel "));
+    Serial.println(i_channel);
+  #endif
+
+  if(b_lease) {
+    WiFi.config(IPAddress(wifiLease.address), IPAddress(wifiLease.gateway), IPAddress(wifiLease.subnet), IPAddress(wifiLease.dns));
+  }
+
+  WiFi.persistent(false); // Don't write SSID/Password to flash memory.
+  WiFi.begin(wifi_ssid.c_str(), wifi_pass.c_str(), i_channel, bssid);
+
+  if(waitForStation(i_fast_connect_timeout)) {
+    b_lease_reused = b_lease;
+    return true;
+  }
+
+  // The access point moved or is out of range, so fall back to a full scan with DHCP.
+  WiFi.disconnect();
+  if(b_lease) {
+    WiFi.config(IPAddress(), IPAddress(), IPAddress());
+    wifiLease.magic = 0;
+  }
+
+  #if defined(DEBUG_WIRELESS_SETUP)
+    Serial.println(F("Cached access point not available, scanning..."));
+  #endif
+
+  return false;
+}
+
 bool startAccesPoint() {
   // Report some diagnostic data which will be necessary for this portion of setup.
   #if defined(DEBUG_WIRELESS_SETUP)
@@ -155,33 +293,28 @@ bool startAccesPoint() {
   String ap_pass; // Local variable for stored AP password.
 
   // Prepare to return either stored preferences or a default value for SSID/password.
-  // Accesses namespace in read-only mode.
-  if(preferences.begin("credentials", true)) {
-    #if defined(RESET_AP_SETTINGS)
-      // Doesn't actually "reset" but forces default values for SSID and password.
-      // Meant to allow the user to reset their credentials then re-flash after
-      // commenting out the RESET_AP_SETTINGS definition in Configuration.h
-      ap_ssid = ap_ssid_prefix + "_" + ap_ssid_suffix; // Use default SSID.
-      ap_pass = ap_default_passwd; // Force use of the default WiFi password.
-    #else
-      // Use either the stored preferences or an expected default value.
-      ap_ssid = preferences.getString("ssid", ap_ssid_prefix + "_" + ap_ssid_suffix);
-      ap_ssid = sanitizeSSID(ap_ssid); // Jacques, clean him!
-      ap_pass = preferences.getString("password", ap_default_passwd);
-    #endif
-    preferences.end();
-  }
-  else {
+  xSemaphoreTake(settingsMutex, portMAX_DELAY);
+  #if defined(RESET_AP_SETTINGS)
+    // Doesn't actually "reset" but forces default values for SSID and password.
+    // Meant to allow the user to reset their credentials then re-flash after
+    // commenting out the RESET_AP_SETTINGS definition in Configuration.h
     ap_ssid = ap_ssid_prefix + "_" + ap_ssid_suffix; // Use default SSID.
     ap_pass = ap_default_passwd; // Force use of the default WiFi password.
+  #else
+    // Use either the stored preferences or an expected default value.
+    ap_ssid = (credentialSettings.ssid.length() > 0) ? credentialSettings.ssid : ap_ssid_prefix + "_" + ap_ssid_suffix;
+    ap_ssid = sanitizeSSID(ap_ssid); // Jacques, clean him!
+    ap_pass = (credentialSettings.password.length() > 0) ? credentialSettings.password : ap_default_passwd;
+  #endif
 
-    // If namespace is not initialized, open in read/write mode and set defaults.
-    if(preferences.begin("credentials", false)) {
-      preferences.putString("ssid", ap_ssid);
-      preferences.putString("password", ap_pass);
-      preferences.end();
-    }
+  if(!credentialSettings.stored) {
+    // If namespace is not initialized, store the defaults on the next flush.
+    credentialSettings.stored = true;
+    credentialSettings.ssid = ap_ssid_prefix + "_" + ap_ssid_suffix;
+    credentialSettings.password = ap_default_passwd;
+    markSettingsDirty(SETTINGS_CREDENTIALS);
   }
+  xSemaphoreGive(settingsMutex);
 
   #if defined(DEBUG_WIRELESS_SETUP)
     Serial.println();
@@ -248,29 +381,15 @@ bool startExternalWifi() {
     // the WiFi preferences to be reset by the user, then re-flash after
     // commenting out the RESET_AP_SETTINGS definition in Configuration.h
   #else
-    // Use either the stored preferences or an expected default value.
-    // Accesses namespace in read-only mode.
-    if(preferences.begin("network", true)) {
-      b_wifi_enabled = preferences.getBool("enabled", false);
-      wifi_ssid = preferences.getString("ssid", user_wifi_ssid);
-      wifi_pass = preferences.getString("password", user_wifi_pass);
-      wifi_address = preferences.getString("address", "");
-      wifi_subnet = preferences.getString("subnet", "");
-      wifi_gateway = preferences.getString("gateway", "");
-      preferences.end();
-    }
-    else {
-      // If namespace is not initialized, open in read/write mode and set defaults.
-      if(preferences.begin("network", false)) {
-        preferences.putBool("enabled", false);
-        preferences.putString("ssid", "");
-        preferences.putString("password", "");
-        preferences.putString("address", "");
-        preferences.putString("subnet", "");
-        preferences.putString("gateway", "");
-        preferences.end();
-      }
-    }
+    // Use the stored preferences, which default to a disabled network.
+    xSemaphoreTake(settingsMutex, portMAX_DELAY);
+    b_wifi_enabled = networkSettings.enabled;
+    wifi_ssid = networkSettings.ssid;
+    wifi_pass = networkSettings.password;
+    wifi_address = networkSettings.address;
+    wifi_subnet = networkSettings.subnet;
+    wifi_gateway = networkSettings.gateway;
+    xSemaphoreGive(settingsMutex);
   #endif
 
   // User wants to utilize the external WiFi network and has valid SSID and password.
@@ -278,8 +397,10 @@ bool startExternalWifi() {
     uint8_t i_curr_attempt = 0;
 
     // When external WiFi is desired, enable simultaneous SoftAP + Station mode.
-    WiFi.mode(WIFI_MODE_APSTA);
-    delay(300);
+    if(WiFi.getMode() != WIFI_MODE_APSTA) {
+      WiFi.mode(WIFI_MODE_APSTA);
+      delay(300);
+    }
 
     #if defined(DEBUG_WIRELESS_SETUP)
       Serial.println();
@@ -290,27 +411,32 @@ bool startExternalWifi() {
       Serial.println(wifi_pass);
     #endif
 
-    // Provide adequate attempts to connect to the external WiFi network.
-    while (i_curr_attempt < i_max_attempts) {
-      WiFi.persistent(false); // Don't write SSID/Password to flash memory.
+    // A stored static IP is applied once connected, otherwise the address comes from DHCP.
+    bool b_static_ip = (wifi_address.length() >= 7 && wifi_subnet.length() >= 7 && wifi_gateway.length() >= 7);
 
-      // Attempt to connect to a specified WiFi network.
-      WiFi.begin(wifi_ssid.c_str(), wifi_pass.c_str());
+    // Try the access point from the last connection first, which avoids a scan.
+    fastConnectWifi(b_static_ip);
 
-      // Wait for the connection to be established.
-      uint8_t attempt = 0;
-      while (attempt < i_max_attempts && WiFi.status() != WL_CONNECTED) {
-        delay(500);
+    // Provide adequate attempts to connect to the external WiFi network.
+    while (i_curr_attempt < i_max_attempts) {
+      if(WiFi.status() != WL_CONNECTED) {
         #if defined(DEBUG_WIRELESS_SETUP)
           Serial.print(F("Connecting to external WiFi network, attempt #"));
-          Serial.println(attempt);
+          Serial.println(i_curr_attempt);
         #endif
-        attempt++;
+
+        WiFi.persistent(false); // Don't write SSID/Password to flash memory.
+
+        // Attempt to connect to a specified WiFi network.
+        WiFi.begin(wifi_ssid.c_str(), wifi_pass.c_str());
+
+        // Wait for the connection to be established.
+        waitForStation(i_connect_timeout);
       }
 
       if (WiFi.status() == WL_CONNECTED) {
         // Configure static IP values for tis device on the preferred network.
-        if(wifi_address.length() >= 7 && wifi_subnet.length() >= 7 && wifi_gateway.length() >= 7) {
+        if(b_static_ip) {
           #if defined(DEBUG_WIRELESS_SETUP)
             Serial.print(F("Using Stored IP: "));
             Serial.print(wifi_address);
@@ -338,6 +464,9 @@ bool startExternalWifi() {
         wifi_subnet = subnetMask.toString();
         wifi_gateway = gatewayIP.toString();
 
+        // Remember this access point for a faster connection next time.
+        cacheAccessPoint(b_static_ip);
+
         #if defined(DEBUG_WIRELESS_SETUP)
           Serial.print(F("WiFi IP Address: "));
           Serial.print(localIP);
@@ -367,6 +496,29 @@ bool startExternalWifi() {
   return false; // If we reach this point the connection has failed.
 }
 
+// Once an address applied from the stored lease is no longer covered by it, rejoin the network with DHCP.
+void checkWifiLease() {
+  if(!b_lease_reused || leaseValid()) {
+    return;
+  }
+
+  b_lease_reused = false;
+  wifiLease.magic = 0;
+
+  if(WiFi.status() == WL_CONNECTED) {
+    #if defined(DEBUG_WIRELESS_SETUP)
+      Serial.println(F("Stored lease expired, renewing the address with DHCP"));
+    #endif
+
+    WiFi.disconnect();
+    b_ext_wifi_started = false;
+
+    delay(100); // Delay needed.
+
+    b_ext_wifi_started = startExternalWifi();
+  }
+}
+
 bool startWiFi() {
   // Begin some diagnostic information to console.
   #if defined(DEBUG_WIRELESS_SETUP)
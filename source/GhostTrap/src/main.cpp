@@ -40,6 +40,7 @@
 #include "Configuration.h"
 #include "Header.h"
 #include "Colours.h"
+#include "Settings.h"
 #include "Wireless.h"
 #include "System.h"
 
@@ -139,33 +140,8 @@ void PreferencesTask(void *parameter) {
     debug(F("NVS initialized successfully"));
   }
 
-  /*
-   * Get Local Device Preferences
-   * Accesses the "device" namespace in read-only mode under the "nvs" partition.
-   */
-  bool b_namespace_opened = preferences.begin("device", true);
-  if(b_namespace_opened) {
-    switch(preferences.getShort("display_type", 0)) {
-      case 0:
-        DISPLAY_TYPE = STATUS_TEXT;
-      break;
-      case 1:
-        DISPLAY_TYPE = STATUS_GRAPHIC;
-      break;
-      case 2:
-      default:
-        DISPLAY_TYPE = STATUS_BOTH;
-      break;
-    }
-    preferences.end();
-  }
-  else {
-    // If namespace is not initialized, open in read/write mode and set defaults.
-    if(preferences.begin("device", false)) {
-      preferences.putShort("display_type", DISPLAY_TYPE);
-      preferences.end();
-    }
-  }
+  // Read all stored settings into RAM, where they are served from until the next restart.
+  loadSettings();
 
   #if defined(DEBUG_TASK_TO_CONSOLE)
     // Get the stack high water mark for optimizing bytes allocated.
@@ -247,8 +223,22 @@ void WiFiManagementTask(void *parameter) {
         // Restart timer for next check.
         ms_otacheck.start(i_otaCheck);
       }
+
+      if(ms_metrics.remaining() < 1) {
+        // Add a sample to the metrics history.
+        updateMetrics();
+
+        // Restart timer for next sample.
+        ms_metrics.start(i_metricsSample);
+      }
     }
 
+    // Renew the address with DHCP once a reused lease has run out.
+    checkWifiLease();
+
+    // Write any changed settings to NVS once saves have stopped.
+    checkSettingsFlush();
+
     vTaskDelay(100 / portTICK_PERIOD_MS); // 100ms delay
   }
 }
@@ -270,6 +260,7 @@ void WiFiSetupTask(void *parameter) {
     ms_cleanup.start(i_websocketCleanup);
     ms_apclient.start(i_apClientCount);
     ms_otacheck.start(i_otaCheck);
+    ms_metrics.start(i_metricsSample);
   }
 
   #if defined(DEBUG_TASK_TO_CONSOLE)
@@ -355,7 +346,7 @@ void setup() {
   // Create tasks which utilize a loop for continuous operation (prioritized highest to lowest).
   xTaskCreatePinnedToCore(UserInputTask, "UserInputTask", 4096, NULL, 3, &UserInputTaskHandle, 1);
   xTaskCreatePinnedToCore(AnimationTask, "AnimationTask", 2048, NULL, 2, &AnimationTaskHandle, 1);
-  xTaskCreatePinnedToCore(WiFiManagementTask, "WiFiManagementTask", 2048, NULL, 1, &WiFiManagementTaskHandle, 1);
+  xTaskCreatePinnedToCore(WiFiManagementTask, "WiFiManagementTask", 4096, NULL, 1, &WiFiManagementTaskHandle, 1);
 
   // Create idle tasks for each core, used to estimate % busy for core.
   #if defined(DEBUG_PERFORMANCE)
@@ -70,8 +70,8 @@ void checkWandAction() {
           }
         }
 
-        if(b_firing == false) {
-          b_firing = true;
+        if(firingState.firing == false) {
+          firingState.firing = true;
           modeFireStart();
         }
 
@@ -92,7 +92,7 @@ void checkWandAction() {
           }
         }
       }
-      else if(b_pack_alarm == true && b_firing == true) {
+      else if(b_pack_alarm == true && firingState.firing == true) {
         modeFireStop();
       }
     break;
@@ -361,5 +361,6 @@ enum wand_messages : uint8_t {
   W_BARGRAPH_30_SEGMENTS,
   W_RGB_VENT_DISABLED,
   W_RGB_VENT_ENABLED,
-  W_COM_SOUND_NUMBER
+  W_COM_SOUND_NUMBER,
+  W_MEMORY_STATS
 };
\ No newline at end of file
@@ -124,13 +124,13 @@ enum WAND_YEAR_CTS_SETTING WAND_YEAR_CTS;
 /*
  * For MODE_ORIGINAL. For blinking the slo-blo light when the cyclotron is not on.
  */
-millisDelay ms_slo_blo_blink;
+millisTimer ms_slo_blo_blink;
 const uint16_t i_slo_blo_blink_delay = 500;
 
 /*
  * Control for the Meson Shock Blast sound effects.
 */
-millisDelay ms_meson_blast;
+millisTimer ms_meson_blast;
 const uint16_t i_meson_blast_delay_level_5 = 140;
 const uint16_t i_meson_blast_delay_level_4 = 160;
 const uint16_t i_meson_blast_delay_level_3 = 180;
@@ -168,14 +168,14 @@ enum WAND_BARREL_LED_COUNTS WAND_BARREL_LED_COUNT;
  */
 #define FAST_LED_UPDATE_MS 3
 uint8_t i_fast_led_delay = FAST_LED_UPDATE_MS;
-millisDelay ms_fast_led;
+millisTimer ms_fast_led;
 
 /*
  * RGB vent lights.
  */
 #define VENT_LEDS_MAX 2 // The maximum number of LEDs for the vent lights. Main vent + top Clip Lite.
 CRGB vent_leds[VENT_LEDS_MAX]; // FastLED object array for the RGB top/vent LEDs.
-millisDelay ms_vent_light; // Timer to control update rate for RGB top/vent LEDs.
+millisTimer ms_vent_light; // Timer to control update rate for RGB top/vent LEDs.
 const uint16_t i_vent_light_update_interval = 150; // FastLED update interval specifically for the top/vent LEDs.
 bool b_vent_lights_changed = false; // Check for whether there was actually a change to prevent superfluous calls to showLeds().
 
@@ -191,7 +191,7 @@ bool b_vent_lights_changed = false; // Check for whether there was actually a ch
  * GB2 Venkman (Vigo), GB2 Zeddemore: 375
  * Afterlife (all props): 146
  */
-millisDelay ms_white_light;
+millisTimer ms_white_light;
 const uint16_t i_afterlife_blink_interval = 146;
 const uint16_t i_classic_blink_intervals[5] = {333, 375, 417, 500, 666};
 uint8_t i_classic_blink_index = 0;
@@ -200,11 +200,13 @@ uint16_t i_white_light_interval = i_afterlife_blink_interval;
 /*
  * Rotary encoder on the top of the wand. Changes the wand power level and controls the wand settings menu.
  * Also controls independent music volume while the pack/wand is off and if music is playing.
+ * Decoded every millisecond by the Timer0 compare interrupt, so detents are counted while the loop is busy with other work.
+ * FastLED.show() holds interrupts off while it writes the LEDs, so samples (and steps of a very fast turn) can be missed then.
  */
-millisDelay ms_rotary_encoder; // Timer for slowing the rotary encoder spin.
-const uint8_t i_rotary_encoder_delay = 50; // Time in milliseconds to delay rotary encoder actions.
 static uint8_t prev_next_code = 0;
 static uint16_t store = 0;
+volatile int8_t i_rotary_detents = 0; // Net detents counted by the interrupt, not yet consumed by the loop.
+const int8_t i_rotary_max_detents = 4; // Limit on the detents held for the loop, so a fast spin does not keep stepping menus after the dial stops.
 
 /*
  * Vibration
@@ -217,7 +219,7 @@ enum VIBRATION_MODES VIBRATION_MODE;
 const uint8_t i_vibration_level_min = 65;
 uint8_t i_vibration_level = i_vibration_level_min;
 uint8_t i_vibration_level_prev = 0;
-millisDelay ms_menu_vibration; // Timer to do non-blocking confirmation buzzing in the vibration menu.
+millisTimer ms_menu_vibration; // Timer to do non-blocking confirmation buzzing in the vibration menu.
 
 /*
  * Enable or disable vibration control for the Neutrona Wand.
@@ -230,12 +232,13 @@ bool b_vibration_switch_on = true;
 /*
  * Various Switches on the wand.
  */
-Switch switch_intensify(INTENSIFY_SWITCH_PIN); // Intensify switch.
-Switch switch_activate(ACTIVATE_SWITCH_PIN); // Activate switch.
-Switch switch_vent(VENT_SWITCH_PIN); // Turns on the vent light. Bottom right switch on the wand.
-Switch switch_wand(WAND_SWITCH_PIN); // Controls the beeping. Top right switch on the wand.
-Switch switch_mode(MODE_SWITCH_PIN); // Changes firing modes, crosses streams, or used in settings menus.
-Switch switch_barrel(BARREL_SWITCH_PIN); // Checks whether barrel is retracted or not.
+switchBank wandSwitches(4, 13); // Sampled every 4ms, four agreeing samples to change, then held for 13 samples.
+clickSwitch switch_intensify(wandSwitches, SWITCH_INTENSIFY); // Intensify switch.
+bankedSwitch switch_activate(wandSwitches, SWITCH_ACTIVATE); // Activate switch.
+bankedSwitch switch_vent(wandSwitches, SWITCH_VENT); // Turns on the vent light. Bottom right switch on the wand.
+bankedSwitch switch_wand(wandSwitches, SWITCH_WAND); // Controls the beeping. Top right switch on the wand.
+bankedSwitch switch_mode(wandSwitches, SWITCH_MODE); // Changes firing modes, crosses streams, or used in settings menus.
+bankedSwitch switch_barrel(wandSwitches, SWITCH_BARREL); // Checks whether barrel is retracted or not.
 bool b_switch_barrel_extended = true; // Set to true for bootup to prevent sound from playing erroneously. The Neutrona Wand will adjust as necessary.
 uint8_t ventSwitchedCount = 0;
 uint8_t wandSwitchedCount = 0;
@@ -246,21 +249,21 @@ uint8_t wandSwitchedCount = 0;
 const uint8_t i_bargraph_segments_5_led = 5;
 const uint8_t i_bargraph_5_led_invert[i_bargraph_segments_5_led] PROGMEM = {BARGRAPH_LED_5_PIN, BARGRAPH_LED_4_PIN, BARGRAPH_LED_3_PIN, BARGRAPH_LED_2_PIN, BARGRAPH_LED_1_PIN};
 const uint8_t i_bargraph_5_led_normal[i_bargraph_segments_5_led] PROGMEM = {BARGRAPH_LED_1_PIN, BARGRAPH_LED_2_PIN, BARGRAPH_LED_3_PIN, BARGRAPH_LED_4_PIN, BARGRAPH_LED_5_PIN};
-bool b_bargraph_status_5[i_bargraph_segments_5_led] = {};
+flagSet<i_bargraph_segments_5_led> b_bargraph_status_5;
 
 /*
  * Afterlife/Frozen Empire wand idle ramp transition timers.
  */
-millisDelay ms_gun_loop_1; // Used when transitioning to S_AFTERLIFE_WAND_IDLE_1.
-millisDelay ms_gun_loop_2; // Used when transitioning to S_AFTERLIFE_WAND_IDLE_2.
+millisTimer ms_gun_loop_1; // Used when transitioning to S_AFTERLIFE_WAND_IDLE_1.
+millisTimer ms_gun_loop_2; // Used when transitioning to S_AFTERLIFE_WAND_IDLE_2.
 const uint16_t i_gun_loop_1 = 1768; // S_AFTERLIFE_WAND_RAMP_1 is 1768ms long.
 const uint16_t i_gun_loop_2 = 1881; // S_AFTERLIFE_WAND_RAMP_2 is 1881ms long.
 
 /*
  * Overheat timers
  */
-millisDelay ms_overheat_initiate;
-millisDelay ms_overheating; // This timer is only used when using the Neutrona Wand without a Proton Pack.
+millisTimer ms_overheat_initiate;
+millisTimer ms_overheating; // This timer is only used when using the Neutrona Wand without a Proton Pack.
 const uint16_t i_ms_overheating = 3500; // Overheating for 3 seconds. This is only used when using the Neutrona Wand without a Proton Pack.
 bool b_overheat_level[5] = { b_overheat_level_1, b_overheat_level_2, b_overheat_level_3, b_overheat_level_4, b_overheat_level_5 };
 uint16_t i_ms_overheat_initiate[5] = { i_ms_overheat_initiate_level_1, i_ms_overheat_initiate_level_2, i_ms_overheat_initiate_level_3, i_ms_overheat_initiate_level_4, i_ms_overheat_initiate_level_5 };
@@ -285,8 +288,8 @@ uint8_t i_power_level_prev = 1;
 /*
  * Stock Hasbro Bargraph timers
  */
-millisDelay ms_bargraph;
-millisDelay ms_bargraph_firing;
+millisTimer ms_bargraph;
+millisTimer ms_bargraph_firing;
 const uint8_t d_bargraph_ramp_interval = 120;
 uint8_t i_bargraph_status = 0;
 
@@ -308,7 +311,7 @@ enum BARGRAPH_TYPES BARGRAPH_TYPE_EEPROM;
 const uint8_t i_bargraph_interval = 4;
 const uint8_t i_bargraph_wait = 180;
 bool b_bargraph_up = false;
-millisDelay ms_bargraph_alt;
+millisTimer ms_bargraph_alt;
 uint8_t i_bargraph_status_alt = 0;
 const uint8_t d_bargraph_ramp_interval_alt = 40;
 const uint8_t i_bargraph_multiplier_ramp_1984 = 3;
@@ -330,7 +333,7 @@ const uint8_t i_bargraph_segments = 30;
 const uint8_t i_bargraph_invert[i_bargraph_segments - 2] PROGMEM = {54, 38, 22, 6, 53, 37, 21, 5, 52, 36, 20, 4, 51, 35, 19, 3, 50, 34, 18, 2, 49, 33, 17, 1, 48, 32, 16, 0};
 const uint8_t i_bargraph_normal[i_bargraph_segments - 2] PROGMEM = {0, 16, 32, 48, 1, 17, 33, 49, 2, 18, 34, 50, 3, 19, 35, 51, 4, 20, 36, 52, 5, 21, 37, 53, 6, 22, 38, 54};
 const uint8_t i_bargraph_power_table_28[i_power_level_max + 1] PROGMEM = {0, 4, 11, 16, 22, 27};
-bool b_bargraph_status[i_bargraph_segments] = {};
+flagSet<i_bargraph_segments> b_bargraph_status;
 
 /*
   30 Segment bargraph mapping.
@@ -348,8 +351,8 @@ const uint8_t i_bargraph_power_table_wamco[i_power_level_max + 1] PROGMEM = {0,
  * Timers for the optional hat lights.
  * Also used for vent lights during error modes.
  */
-millisDelay ms_warning_blink;
-millisDelay ms_error_blink;
+millisTimer ms_warning_blink;
+millisTimer ms_error_blink;
 const uint16_t i_warning_blink_delay = 100;
 const uint16_t i_error_blink_delay = 400;
 const uint16_t i_bargraph_beep_delay = 1600;
@@ -357,13 +360,13 @@ const uint16_t i_bargraph_beep_delay = 1600;
 /*
  * A timer to prevent the wand beep from restarting too rapidly in Afterlife & Frozen Empire modes.
  */
-millisDelay ms_reset_sound_beep;
+millisTimer ms_reset_sound_beep;
 const uint16_t i_sound_timer = 1750;
 
 /*
  * Wand tip heatup timers (when changing firing modes).
  */
-millisDelay ms_wand_heatup_fade;
+millisTimer ms_wand_heatup_fade;
 const uint8_t i_delay_heatup = 5;
 uint8_t i_heatup_counter = 0;
 uint8_t i_heatdown_counter = 100;
@@ -387,16 +390,16 @@ enum STREAM_MODES STREAM_MODE;
 /*
  * Firing timers.
  */
-millisDelay ms_firing_lights;
-millisDelay ms_firing_lights_end;
-millisDelay ms_firing_effect_end;
-millisDelay ms_firing_stream_effects;
-millisDelay ms_firing_pulse;
-millisDelay ms_impact; // Mix some impact sounds while firing.
-millisDelay ms_firing_length_timer;
-millisDelay ms_firing_sound_mix; // Mix additional impact sounds for standalone Neutrona Wand.
-millisDelay ms_semi_automatic_check; // Timer used to set the rate of fire for the semi-automatic firing modes.
-millisDelay ms_semi_automatic_firing; // Timer used to handle firing effect duration for the semi-automatic firing modes.
+millisTimer ms_firing_lights;
+millisTimer ms_firing_lights_end;
+millisTimer ms_firing_effect_end;
+millisTimer ms_firing_stream_effects;
+millisTimer ms_firing_pulse;
+millisTimer ms_impact; // Mix some impact sounds while firing.
+millisTimer ms_firing_length_timer;
+millisTimer ms_firing_sound_mix; // Mix additional impact sounds for standalone Neutrona Wand.
+millisTimer ms_semi_automatic_check; // Timer used to set the rate of fire for the semi-automatic firing modes.
+millisTimer ms_semi_automatic_firing; // Timer used to handle firing effect duration for the semi-automatic firing modes.
 const uint16_t i_boson_dart_rate = 2000; // Boson Dart firing rate.
 const uint16_t i_shock_blast_rate = 600; // Shock Blast firing rate.
 const uint16_t i_slime_tether_rate = 750; // Slime Tether firing rate.
@@ -431,10 +434,12 @@ bool b_pack_post_finish = true; // Checks whether the attached pack is currently
 bool b_pack_ion_arm_switch_on = false; // For MODE_ORIGINAL. Lets us know if the Proton Pack Ion Arm switch is on to give power to the pack & wand.
 bool b_pack_cyclotron_lid_on = false; // For SYSTEM_FROZEN_EMPIRE. Lets us know if the pack's cyclotron lid is on or not. Default to false to favor FE effects unless told otherwise.
 uint8_t i_cyclotron_speed_up = 1; // For telling the pack to speed up or slow down the Cyclotron lights.
-millisDelay ms_packsync; // Timer for attempting synchronization with a connected pack.
-millisDelay ms_handshake; // Timer for attempting a keepalive handshake with a connected pack.
+millisTimer ms_packsync; // Timer for attempting synchronization with a connected pack.
+millisTimer ms_handshake; // Timer for attempting a keepalive handshake with a connected pack.
 const uint16_t i_sync_initial_delay = 750; // Delay to re-try the initial handshake with a proton pack.
 const uint16_t i_heartbeat_delay = 3250; // Delay to send a heartbeat (handshake) to a connected proton pack.
+millisTimer ms_memory_check; // Timer for reporting SRAM usage to a connected pack.
+const uint16_t i_memory_check_delay = 5000; // Delay between SRAM usage reports.
 
 /*
  * Wand Menu
@@ -443,22 +448,24 @@ enum WAND_MENU_LEVELS { MENU_LEVEL_1, MENU_LEVEL_2, MENU_LEVEL_3, MENU_LEVEL_4,
 enum WAND_MENU_LEVELS WAND_MENU_LEVEL;
 uint8_t i_wand_menu = 5;
 const uint16_t i_settings_blink_delay = 400;
-millisDelay ms_settings_blink;
+millisTimer ms_settings_blink;
 
 /*
  * Misc wand settings and flags.
  */
-bool b_firing = false; // Check for general firing state.
-bool b_firing_intensify = false; // Check for Intensify button activity.
-bool b_firing_alt = false; // Check for Barrel Wing Button firing activity for CTS.
-bool b_firing_cross_streams = false; // Check for CTS firing activity.
-bool b_firing_semi_automatic = false; // Check for semi-automatic firing modes.
-bool b_sound_firing_intensify_trigger = false;
-bool b_sound_firing_alt_trigger = false;
-bool b_sound_firing_cross_the_streams = false;
-bool b_sound_idle = false;
-bool b_beeping = false;
-bool b_sound_afterlife_idle_2_fade = true;
+struct __attribute__((packed)) objFiringState {
+  bool firing : 1; // Check for general firing state.
+  bool intensify : 1; // Check for Intensify button activity.
+  bool alt : 1; // Check for Barrel Wing Button firing activity for CTS.
+  bool crossStreams : 1; // Check for CTS firing activity.
+  bool semiAutomatic : 1; // Check for semi-automatic firing modes.
+  bool soundIntensifyTrigger : 1;
+  bool soundAltTrigger : 1;
+  bool soundCrossTheStreams : 1;
+  bool soundIdle : 1;
+  bool beeping : 1;
+  bool soundAfterlifeIdle2Fade : 1;
+} firingState = { false, false, false, false, false, false, false, false, false, false, true };
 bool b_all_switch_activation = false; // Used to check if Activate was flipped to on while the vent switch was already in the on position for sound purposes.
 bool b_overheat_recovery = false; // Used to prevent wand from erroneously sending overlapping bootup sounds to pack when recovering from overheat.
 bool b_wand_boot_error_on = false;
@@ -469,7 +476,7 @@ bool b_wand_boot_error_on = false;
  * otherwise an error mode will be engaged to provide a cool-down period. This does not apply to any
  * prolonged firing which would trigger the overheat or venting sequences; only rapid firing bursts.
  */
-millisDelay ms_bmash;              // Timer for the button mash lock-out period.
+millisTimer ms_bmash;              // Timer for the button mash lock-out period.
 uint16_t i_bmash_delay = 1000;     // Time period in which we consider rapid firing.
 uint16_t i_bmash_cool_down = 3000; // Time period for the lock-out of user input.
 uint8_t i_bmash_count = 0;         // Current count for rapid firing bursts.
@@ -480,15 +487,15 @@ bool b_wand_mash_error = false;    // Indicates if wand is in a lock-out phase.
 /*
  * Used during the overheating sequences.
  */
-millisDelay ms_blink_sound_timer_1;
-millisDelay ms_blink_sound_timer_2;
+millisTimer ms_blink_sound_timer_1;
+millisTimer ms_blink_sound_timer_2;
 const uint16_t i_blink_sound_timer_1 = 400;
 const uint16_t i_blink_sound_timer_2 = 1600;
 
 /*
  * A timer to turn on the Clippard LED when the system is shut down after some inactivity as a reminder you left your power on to the system.
  */
-millisDelay ms_power_indicator;
+millisTimer ms_power_indicator;
 const uint32_t i_ms_power_indicator = 60000; // 1 minute -> 60000 milliseconds
 const uint16_t i_ms_power_indicator_blink = 500;
 
@@ -500,7 +507,5 @@ void wandSerialSend(uint8_t i_command);
 void wandSerialSendData(uint8_t i_message);
 void checkPack();
 void checkWandAction();
-void ventSwitched(void* n = nullptr);
-void wandSwitched(void* n = nullptr);
 void ventLedControl(uint8_t i_intensity = 255);
 void ventLedTopControl(bool b_on);
\ No newline at end of file
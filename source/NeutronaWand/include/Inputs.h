@@ -0,0 +1,217 @@
+/**
+ *   GPStar Neutrona Wand - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2023-2025 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * Switch Inputs
+ *
+ * Every switch is sampled from its port register on the same scan tick and debounced in parallel by a
+ * two-bit vertical counter: bit n of i_ct0/i_ct1 is the counter for input n. An input changes state on
+ * the fourth consecutive sample which disagrees with its debounced state. Inputs in the passthrough mask
+ * skip the counter, and an optional lockout (in scan ticks) holds an input after it changes.
+ * Edges are reported as bitmasks and are only valid until the next call to due().
+ * A set bit always means the switch is closed, which on these pull-up inputs is a LOW pin.
+ */
+class switchBank {
+  public:
+    switchBank(uint8_t i_interval, uint8_t i_lockout = 0, uint8_t i_passthrough = 0)
+      : i_interval(i_interval), i_lockout(i_lockout & 0x0F), i_passthrough(i_passthrough) {}
+
+    // Seed the debounced state from a first sample so nothing is reported as an edge at startup.
+    void begin(uint8_t i_raw, uint8_t i_now) {
+      i_state = i_raw;
+      i_ct0 = 0xFF;
+      i_ct1 = 0xFF;
+      i_pressed = 0;
+      i_released = 0;
+      i_lock[0] = i_lock[1] = i_lock[2] = i_lock[3] = 0;
+      i_last_sample = i_now;
+    }
+
+    // Returns true when the next sample is due. Between samples the edges of the previous one are cleared.
+    bool due(uint8_t i_now) {
+      if((uint8_t)(i_now - i_last_sample) < i_interval) {
+        i_pressed = 0;
+        i_released = 0;
+        return false;
+      }
+
+      i_last_sample = i_now;
+      return true;
+    }
+
+    void sample(uint8_t i_raw) {
+      uint8_t i_delta = i_raw ^ i_state;
+
+      // Count down while an input disagrees with its debounced state, reset to 3 while it agrees.
+      i_ct0 = ~(i_ct0 & i_delta);
+      i_ct1 = i_ct0 ^ (i_ct1 & i_delta);
+
+      uint8_t i_toggle = (i_delta & i_ct0 & i_ct1) | (i_delta & i_passthrough);
+
+      if(i_lockout > 0) {
+        // Decrement the four-bit lockout counters which are still running.
+        uint8_t i_borrow = i_lock[0] | i_lock[1] | i_lock[2] | i_lock[3];
+
+        for(uint8_t i = 0; i < 4; i++) {
+          uint8_t i_next = i_lock[i] ^ i_borrow;
+          i_borrow &= ~i_lock[i];
+          i_lock[i] = i_next;
+        }
+
+        // Locked inputs which finished counting hold at the end of the count and change on the first unlocked sample.
+        uint8_t i_held = i_toggle & (i_lock[0] | i_lock[1] | i_lock[2] | i_lock[3]);
+        i_toggle &= ~i_held;
+        i_ct0 &= ~i_held;
+        i_ct1 &= ~i_held;
+
+        for(uint8_t i = 0; i < 4; i++) {
+          i_lock[i] = (i_lock[i] & ~i_toggle) | ((i_lockout >> i) & 0x01 ? i_toggle : 0);
+        }
+      }
+
+      i_state ^= i_toggle;
+      i_pressed = i_toggle & i_state;
+      i_released = i_toggle & ~i_state;
+    }
+
+    uint8_t held() const { return i_state; }
+    uint8_t pressed() const { return i_pressed; }
+    uint8_t released() const { return i_released; }
+
+  private:
+    uint8_t i_interval;
+    uint8_t i_lockout;
+    uint8_t i_passthrough;
+    uint8_t i_last_sample = 0;
+    uint8_t i_state = 0;
+    uint8_t i_ct0 = 0xFF;
+    uint8_t i_ct1 = 0xFF;
+    uint8_t i_pressed = 0;
+    uint8_t i_released = 0;
+    uint8_t i_lock[4] = {0, 0, 0, 0};
+};
+
+/*
+ * One input of a switchBank, keeping the accessor names the wand code has always used for its switches.
+ */
+class bankedSwitch {
+  public:
+    bankedSwitch(const switchBank& bank, uint8_t i_bit) : bank(bank), i_mask(1 << i_bit) {}
+
+    bool on() const { return bank.held() & i_mask; }
+    bool pushed() const { return bank.pressed() & i_mask; }
+    bool released() const { return bank.released() & i_mask; }
+    bool switched() const { return (bank.pressed() | bank.released()) & i_mask; }
+
+  private:
+    const switchBank& bank;
+    uint8_t i_mask;
+};
+
+/*
+ * A bankedSwitch which also recognises single clicks, double clicks and long presses.
+ * Only the switches which need the click timing pay for it; call poll() once per loop after the bank.
+ */
+class clickSwitch : public bankedSwitch {
+  public:
+    clickSwitch(const switchBank& bank, uint8_t i_bit) : bankedSwitch(bank, i_bit) {}
+
+    void poll(unsigned long i_now) {
+      if(pushed()) {
+        // A push inside the double click window is the second click, so no single click is reported for it.
+        b_single_click_disable = (i_now - i_pushed_time) < i_double_click_period;
+      }
+
+      b_single_click = false;
+
+      if(!b_single_click_disable) {
+        b_single_click = !switched() && !on() && (i_released_time - i_pushed_time) <= i_long_press_period && (i_now - i_pushed_time) >= i_double_click_period;
+        b_single_click_disable = b_single_click;
+      }
+
+      b_double_click = pushed() && (i_now - i_pushed_time) < i_double_click_period;
+
+      if(switched()) {
+        b_long_press_disable = false;
+      }
+
+      b_long_press = false;
+
+      if(!b_long_press_disable) {
+        b_long_press = on() && (i_now - i_pushed_time) > i_long_press_period;
+        b_long_press_disable = b_long_press;
+      }
+
+      if(pushed()) {
+        i_pushed_time = i_now;
+      }
+      else if(released()) {
+        i_released_time = i_now;
+      }
+    }
+
+    bool singleClick() const { return b_single_click; }
+    bool doubleClick() const { return b_double_click; }
+    bool longPress() const { return b_long_press; }
+
+  private:
+    const static uint16_t i_long_press_period = 300;
+    const static uint16_t i_double_click_period = 250;
+    unsigned long i_pushed_time = 0;
+    unsigned long i_released_time = 0;
+    bool b_single_click = false;
+    bool b_single_click_disable = true;
+    bool b_double_click = false;
+    bool b_long_press = false;
+    bool b_long_press_disable = false;
+};
+
+/*
+ * Bit positions of the wand switches within the switchBank.
+ */
+enum WAND_SWITCHES : uint8_t {
+  SWITCH_INTENSIFY,
+  SWITCH_ACTIVATE,
+  SWITCH_VENT,
+  SWITCH_WAND,
+  SWITCH_MODE,
+  SWITCH_BARREL
+};
+
+/*
+ * Read all of the wand switches with one read per port. The port bits follow the ATmega2560 pin mapping
+ * of the switch pins in Header.h, so keep the two in step if a switch is moved.
+ */
+uint8_t readWandSwitches() {
+  const uint8_t i_port_e = PINE;
+  const uint8_t i_port_f = PINF;
+  uint8_t i_raw = 0;
+
+  if(!(i_port_e & _BV(PE4))) i_raw |= _BV(SWITCH_INTENSIFY); // Pin 2
+  if(!(i_port_e & _BV(PE5))) i_raw |= _BV(SWITCH_ACTIVATE); // Pin 3
+  if(!(PING & _BV(PG5))) i_raw |= _BV(SWITCH_VENT); // Pin 4
+  if(!(i_port_f & _BV(PF0))) i_raw |= _BV(SWITCH_WAND); // Pin A0
+  if(!(i_port_f & _BV(PF6))) i_raw |= _BV(SWITCH_MODE); // Pin A6
+  if(!(i_port_f & _BV(PF7))) i_raw |= _BV(SWITCH_BARREL); // Pin A7
+
+  return i_raw;
+}
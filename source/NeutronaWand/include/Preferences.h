@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 /*
  * User Preference Storage/Retrieval via EEPROM
  *
@@ -38,17 +40,11 @@ void clearConfigEEPROM();
 void clearLEDEEPROM();
 void saveConfigEEPROM();
 void saveLEDEEPROM();
-void updateCRCEEPROM();
 uint32_t eepromCRC(void);
 void bargraphYearModeUpdate();
 void resetOverheatLevels();
 void resetWhiteLEDBlinkRate();
 
-/*
- * General EEPROM Variables
- */
-uint16_t i_eepromAddress = 0; // The address in the EEPROM to start reading from.
-
 /*
  * Data structure object for LED settings which are saved into the EEPROM memory.
  */
@@ -97,394 +93,534 @@ struct objConfigEEPROM {
 };
 
 /*
- * Read all user preferences from Proton Pack controller EEPROM.
+ * EEPROM Preference Journal
+ *
+ * Rather than rewriting the same bytes at address 0, each save appends a record (header, object and
+ * its own CRC32) to the next slot of a ring spanning the EEPROM. At boot only the slot headers are
+ * scanned to find the newest record of each kind, and older copies are used only if its CRC fails.
+ * An interrupted save therefore loses only that save, and a save which changes nothing writes nothing.
  */
-void readEEPROM() {
-  // Get the stored CRC from the EEPROM.
+enum EEPROM_RECORDS { EEPROM_RECORD_CONFIG, EEPROM_RECORD_LED, EEPROM_RECORD_KINDS };
+const uint8_t i_eeprom_record_tag = 0xA0; // Stored as (tag + kind) so records stand apart from erased or legacy bytes.
+const uint8_t i_eeprom_record_length[EEPROM_RECORD_KINDS] = { sizeof(objConfigEEPROM), sizeof(objLEDEEPROM) };
+const uint16_t i_eeprom_no_slot = 0xFFFF;
+
+struct objEEPROMRecordHeader {
+  uint8_t tag;       // i_eeprom_record_tag + the record kind.
+  uint8_t length;    // Size of the object which follows the header.
+  uint32_t sequence; // Incremented for every record written; the highest is the newest. Too wide to wrap within the EEPROM's write endurance.
+};
+
+// Every slot fits a header, the largest preference object and a CRC32.
+const uint8_t i_eeprom_slot_size = sizeof(objEEPROMRecordHeader) + max(sizeof(objConfigEEPROM), sizeof(objLEDEEPROM)) + sizeof(uint32_t);
+
+// The last 4 bytes of the EEPROM still hold the CRC used by the single-copy layout of earlier firmware.
+const uint16_t i_eeprom_slots = (E2END + 1 - sizeof(uint32_t)) / i_eeprom_slot_size;
+
+// Slots overlapping that single-copy layout, which are left alone until the journal wraps around.
+const uint16_t i_eeprom_legacy_slots = (sizeof(objConfigEEPROM) + sizeof(objLEDEEPROM) + i_eeprom_slot_size - 1) / i_eeprom_slot_size;
+
+uint16_t i_eeprom_record_slot[EEPROM_RECORD_KINDS] = { i_eeprom_no_slot, i_eeprom_no_slot }; // Slot of the newest valid record of each kind.
+uint32_t i_eeprom_sequence = 0; // Sequence number of the newest record in the journal.
+uint16_t i_eeprom_next_slot = i_eeprom_legacy_slots; // Slot which receives the next record.
+
+// Whether sequence number a was written after sequence number b, allowing for wrap-around.
+bool eepromSequenceNewer(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b) > 0;
+}
+
+uint16_t eepromSlotAddress(uint16_t i_slot) {
+  return i_slot * i_eeprom_slot_size;
+}
+
+// Whether a slot header describes a record of the given kind.
+bool eepromRecordMatches(const objEEPROMRecordHeader &header, uint8_t i_kind) {
+  return header.tag == i_eeprom_record_tag + i_kind && header.length == i_eeprom_record_length[i_kind];
+}
+
+// Calculate the CRC32 for a record header and the object which follows it.
+uint32_t eepromRecordCRC(const objEEPROMRecordHeader &header, const uint8_t *p_data) {
+  CRC32 crc;
+  const uint8_t *p_header = (const uint8_t*) &header;
+
+  for(uint8_t i = 0; i < sizeof(objEEPROMRecordHeader); i++) {
+    crc.update(p_header[i]);
+  }
+
+  for(uint8_t i = 0; i < header.length; i++) {
+    crc.update(p_data[i]);
+  }
+
+  return (uint32_t)crc.finalize();
+}
+
+// Copy the object held by a slot into a buffer and check it against the CRC stored with it.
+bool readEEPROMRecord(uint16_t i_slot, uint8_t *p_data) {
+  uint16_t i_address = eepromSlotAddress(i_slot);
+  objEEPROMRecordHeader header;
   uint32_t l_crc_check;
-  EEPROM.get(EEPROM.length() - sizeof(eepromCRC()), l_crc_check);
 
-  // Check if the calculated CRC matches the stored CRC value in the EEPROM.
-  if(eepromCRC() == l_crc_check) {
-    // Read our object from the EEPROM.
-    objConfigEEPROM obj_config_eeprom;
-    EEPROM.get(i_eepromAddress, obj_config_eeprom);
+  EEPROM.get(i_address, header);
+  i_address += sizeof(objEEPROMRecordHeader);
 
-    // Assume that the VG_MODE as default, overriding as necessary based on stored flags.
-    FIRING_MODE = VG_MODE;
+  for(uint8_t i = 0; i < header.length; i++) {
+    p_data[i] = EEPROM.read(i_address + i);
+  }
 
-    if(obj_config_eeprom.cross_the_streams > 0 && obj_config_eeprom.cross_the_streams != 255) {
-      if(obj_config_eeprom.cross_the_streams > 1) {
-        FIRING_MODE = CTS_MODE; // At least the CTS mode is enabled.
+  EEPROM.get(i_address + header.length, l_crc_check);
 
-        if(obj_config_eeprom.cross_the_streams_mix > 0 && obj_config_eeprom.cross_the_streams_mix != 255) {
-          if(obj_config_eeprom.cross_the_streams_mix > 1) {
-            FIRING_MODE = CTS_MIX_MODE; // Upgrade to the CTS Mix mode.
-          }
-        }
-      }
-    }
+  return eepromRecordCRC(header, p_data) == l_crc_check;
+}
 
-    // Remember this as the last firing mode as well.
-    LAST_FIRING_MODE = FIRING_MODE;
+// Find the newest record of a kind with an intact CRC, falling back to older copies if necessary.
+uint16_t findEEPROMRecord(uint8_t i_kind, uint8_t *p_data) {
+  bool b_bounded = false;
+  uint32_t i_older_than = 0;
 
-    if(obj_config_eeprom.overheating > 0 && obj_config_eeprom.overheating != 255) {
-      if(obj_config_eeprom.overheating > 1) {
-        b_overheat_enabled = true;
-      }
-      else {
-        b_overheat_enabled = false;
-      }
-    }
+  for(uint16_t i_attempt = 0; i_attempt < i_eeprom_slots; i_attempt++) {
+    uint16_t i_best_slot = i_eeprom_no_slot;
+    uint32_t i_best_sequence = 0;
 
-    if(obj_config_eeprom.extra_proton_sounds > 0 && obj_config_eeprom.extra_proton_sounds != 255) {
-      if(obj_config_eeprom.extra_proton_sounds > 1) {
-        b_stream_effects = true;
-      }
-      else {
-        b_stream_effects = false;
-      }
-    }
+    for(uint16_t i_slot = 0; i_slot < i_eeprom_slots; i_slot++) {
+      objEEPROMRecordHeader header;
+      EEPROM.get(eepromSlotAddress(i_slot), header);
 
-    if(obj_config_eeprom.neutrona_wand_sounds > 0 && obj_config_eeprom.neutrona_wand_sounds != 255) {
-      if(obj_config_eeprom.neutrona_wand_sounds > 1) {
-        b_extra_pack_sounds = true;
-      }
-      else {
-        b_extra_pack_sounds = false;
+      if(!eepromRecordMatches(header, i_kind) || (b_bounded && !eepromSequenceNewer(i_older_than, header.sequence))) {
+        continue;
       }
-    }
 
-    if(obj_config_eeprom.spectral_mode > 0 && obj_config_eeprom.spectral_mode != 255) {
-      if(obj_config_eeprom.spectral_mode > 1) {
-        b_spectral_mode_enabled = true;
-        b_spectral_custom_mode_enabled = true;
-        b_holiday_mode_enabled = true;
-      }
-      else {
-        b_spectral_mode_enabled = false;
-        b_spectral_custom_mode_enabled = false;
-        b_holiday_mode_enabled = false;
+      if(i_best_slot == i_eeprom_no_slot || eepromSequenceNewer(header.sequence, i_best_sequence)) {
+        i_best_slot = i_slot;
+        i_best_sequence = header.sequence;
       }
     }
 
-    if(obj_config_eeprom.quick_vent > 0 && obj_config_eeprom.quick_vent != 255) {
-      if(obj_config_eeprom.quick_vent > 1) {
-        b_quick_vent = true;
-      }
-      else {
-        b_quick_vent = false;
-      }
+    if(i_best_slot == i_eeprom_no_slot || readEEPROMRecord(i_best_slot, p_data)) {
+      return i_best_slot;
     }
 
-    if(obj_config_eeprom.wand_boot_errors > 0 && obj_config_eeprom.wand_boot_errors != 255) {
-      if(obj_config_eeprom.wand_boot_errors > 1) {
-        b_wand_boot_errors = true;
-      }
-      else {
-        b_wand_boot_errors = false;
-      }
-    }
+    // That record was torn or corrupted, so try the next newest copy.
+    b_bounded = true;
+    i_older_than = i_best_sequence;
+  }
 
-    if(obj_config_eeprom.vent_light_auto_intensity > 0 && obj_config_eeprom.vent_light_auto_intensity != 255) {
-      if(obj_config_eeprom.vent_light_auto_intensity > 1) {
-        b_vent_light_control = true;
-      }
-      else {
-        b_vent_light_control = false;
-      }
-    }
+  return i_eeprom_no_slot;
+}
 
-    if(obj_config_eeprom.invert_bargraph > 0 && obj_config_eeprom.invert_bargraph != 255) {
-      if(obj_config_eeprom.invert_bargraph > 1) {
-        b_bargraph_invert = true;
-      }
-      else {
-        b_bargraph_invert = false;
-      }
-    }
+// Locate the newest record of each kind and the slot which the next record will be written to.
+void scanEEPROMJournal() {
+  bool b_found = false;
 
-    if(obj_config_eeprom.bargraph_mode > 0 && obj_config_eeprom.bargraph_mode != 255) {
-      switch(obj_config_eeprom.bargraph_mode) {
-        case 1:
-        default:
-          BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_DEFAULT;
-        break;
-
-        case 2:
-          BARGRAPH_MODE = BARGRAPH_SUPER_HERO;
-          BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_SUPER_HERO;
-        break;
-
-        case 3:
-          BARGRAPH_MODE = BARGRAPH_ORIGINAL;
-          BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_ORIGINAL;
-        break;
-      }
-    }
+  for(uint16_t i_slot = 0; i_slot < i_eeprom_slots; i_slot++) {
+    objEEPROMRecordHeader header;
+    EEPROM.get(eepromSlotAddress(i_slot), header);
 
-    if(obj_config_eeprom.bargraph_firing_animation > 0 && obj_config_eeprom.bargraph_mode != 255) {
-      switch(obj_config_eeprom.bargraph_firing_animation) {
-        case 1:
-        default:
-          BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_DEFAULT;
-        break;
-
-        case 2:
-          BARGRAPH_FIRING_ANIMATION = BARGRAPH_ANIMATION_SUPER_HERO;
-          BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_SUPER_HERO;
-        break;
-
-        case 3:
-          BARGRAPH_FIRING_ANIMATION = BARGRAPH_ANIMATION_ORIGINAL;
-          BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_ORIGINAL;
-        break;
+    for(uint8_t i_kind = 0; i_kind < EEPROM_RECORD_KINDS; i_kind++) {
+      if(eepromRecordMatches(header, i_kind) && (!b_found || eepromSequenceNewer(header.sequence, i_eeprom_sequence))) {
+        b_found = true;
+        i_eeprom_sequence = header.sequence;
+        i_eeprom_next_slot = (i_slot + 1) % i_eeprom_slots;
       }
     }
+  }
+}
 
-    if(obj_config_eeprom.bargraph_overheat_blinking > 0 && obj_config_eeprom.bargraph_overheat_blinking != 255) {
-      if(obj_config_eeprom.bargraph_overheat_blinking > 1) {
-        b_overheat_bargraph_blink = true;
-      }
-      else {
-        b_overheat_bargraph_blink = false;
-      }
-    }
+// Append a record for an object, unless the newest record of that kind already holds the same data.
+void writeEEPROMRecord(uint8_t i_kind, const uint8_t *p_data) {
+  uint8_t i_length = i_eeprom_record_length[i_kind];
+  uint16_t i_current = i_eeprom_record_slot[i_kind];
 
-    if(obj_config_eeprom.neutrona_wand_year_mode > 0 && obj_config_eeprom.neutrona_wand_year_mode != 255) {
-      switch(obj_config_eeprom.neutrona_wand_year_mode) {
-        case 1:
-        default:
-          WAND_YEAR_MODE = YEAR_DEFAULT;
-        break;
-        case 2:
-          WAND_YEAR_MODE = YEAR_1984;
-        break;
-        case 3:
-          WAND_YEAR_MODE = YEAR_1989;
-        break;
-        case 4:
-          WAND_YEAR_MODE = YEAR_AFTERLIFE;
-        break;
-        case 5:
-          WAND_YEAR_MODE = YEAR_FROZEN_EMPIRE;
-        break;
-      }
-    }
+  if(i_current != i_eeprom_no_slot) {
+    uint16_t i_address = eepromSlotAddress(i_current) + sizeof(objEEPROMRecordHeader);
+    bool b_changed = false;
 
-    if(obj_config_eeprom.CTS_mode > 0 && obj_config_eeprom.CTS_mode != 255) {
-      switch(obj_config_eeprom.CTS_mode) {
-        case 1:
-        default:
-          WAND_YEAR_CTS = CTS_DEFAULT;
-        break;
-        case 2:
-          WAND_YEAR_CTS = CTS_1984;
-        break;
-        case 4:
-          WAND_YEAR_CTS = CTS_AFTERLIFE;
-        break;
-      }
+    for(uint8_t i = 0; i < i_length && !b_changed; i++) {
+      b_changed = EEPROM.read(i_address + i) != p_data[i];
     }
 
-    if(obj_config_eeprom.system_mode > 0 && obj_config_eeprom.system_mode != 255 && b_gpstar_benchtest) {
-      if(obj_config_eeprom.system_mode > 1) {
-        SYSTEM_MODE = MODE_ORIGINAL;
-      }
-      else {
-        SYSTEM_MODE = MODE_SUPER_HERO;
-      }
+    if(!b_changed) {
+      return;
     }
+  }
 
-    if(obj_config_eeprom.beep_loop > 0 && obj_config_eeprom.beep_loop != 255) {
-      if(obj_config_eeprom.beep_loop > 1) {
-        b_beep_loop = true;
-      }
-      else {
-        b_beep_loop = false;
+  // Never overwrite the newest record of any kind.
+  uint16_t i_slot = i_eeprom_next_slot;
+  bool b_in_use = true;
+
+  while(b_in_use) {
+    b_in_use = false;
+
+    for(uint8_t i_kind_check = 0; i_kind_check < EEPROM_RECORD_KINDS; i_kind_check++) {
+      if(i_eeprom_record_slot[i_kind_check] == i_slot) {
+        b_in_use = true;
       }
     }
 
-    if(obj_config_eeprom.default_system_volume > 0 && obj_config_eeprom.default_system_volume <= 101 && b_gpstar_benchtest) {
-      // EEPROM value is from 1 to 101; subtract 1 to get the correct percentage.
-      i_volume_master_percentage = obj_config_eeprom.default_system_volume - 1;
-      i_volume_master_eeprom = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100);
-      i_volume_revert = i_volume_master_eeprom;
-      i_volume_master = i_volume_master_eeprom;
+    if(b_in_use) {
+      i_slot = (i_slot + 1) % i_eeprom_slots;
     }
+  }
 
-    if(obj_config_eeprom.overheat_start_timer_level_5 > 0 && obj_config_eeprom.overheat_start_timer_level_5 != 255) {
-      i_ms_overheat_initiate_level_5 = obj_config_eeprom.overheat_start_timer_level_5 * 1000;
+  objEEPROMRecordHeader header = { (uint8_t)(i_eeprom_record_tag + i_kind), i_length, i_eeprom_sequence + 1 };
+  uint16_t i_address = eepromSlotAddress(i_slot);
 
-      i_ms_overheat_initiate[4] = i_ms_overheat_initiate_level_5;
-    }
+  EEPROM.put(i_address, header);
 
-    if(obj_config_eeprom.overheat_start_timer_level_4 > 0 && obj_config_eeprom.overheat_start_timer_level_4 != 255) {
-      i_ms_overheat_initiate_level_4 = obj_config_eeprom.overheat_start_timer_level_4 * 1000;
+  for(uint8_t i = 0; i < i_length; i++) {
+    EEPROM.update(i_address + sizeof(objEEPROMRecordHeader) + i, p_data[i]);
+  }
 
-      i_ms_overheat_initiate[3] = i_ms_overheat_initiate_level_4;
-    }
+  // The CRC is written last so that an interrupted save never looks valid.
+  EEPROM.put(i_address + sizeof(objEEPROMRecordHeader) + i_length, eepromRecordCRC(header, p_data));
 
-    if(obj_config_eeprom.overheat_start_timer_level_3 > 0 && obj_config_eeprom.overheat_start_timer_level_3 != 255) {
-      i_ms_overheat_initiate_level_3 = obj_config_eeprom.overheat_start_timer_level_3 * 1000;
+  i_eeprom_sequence = header.sequence;
+  i_eeprom_record_slot[i_kind] = i_slot;
+  i_eeprom_next_slot = (i_slot + 1) % i_eeprom_slots;
+}
 
-      i_ms_overheat_initiate[2] = i_ms_overheat_initiate_level_3;
-    }
+// Fetch the newest stored configuration and LED objects. Objects never saved are left zeroed (defaults).
+bool loadEEPROM(objConfigEEPROM &obj_config_eeprom, objLEDEEPROM &obj_led_eeprom) {
+  scanEEPROMJournal();
 
-    if(obj_config_eeprom.overheat_start_timer_level_2 > 0 && obj_config_eeprom.overheat_start_timer_level_2 != 255) {
-      i_ms_overheat_initiate_level_2 = obj_config_eeprom.overheat_start_timer_level_2 * 1000;
+  i_eeprom_record_slot[EEPROM_RECORD_CONFIG] = findEEPROMRecord(EEPROM_RECORD_CONFIG, (uint8_t*) &obj_config_eeprom);
+  i_eeprom_record_slot[EEPROM_RECORD_LED] = findEEPROMRecord(EEPROM_RECORD_LED, (uint8_t*) &obj_led_eeprom);
 
-      i_ms_overheat_initiate[1] = i_ms_overheat_initiate_level_2;
-    }
+  if(i_eeprom_record_slot[EEPROM_RECORD_CONFIG] != i_eeprom_no_slot || i_eeprom_record_slot[EEPROM_RECORD_LED] != i_eeprom_no_slot) {
+    return true;
+  }
 
-    if(obj_config_eeprom.overheat_start_timer_level_1 > 0 && obj_config_eeprom.overheat_start_timer_level_1 != 255) {
-      i_ms_overheat_initiate_level_1 = obj_config_eeprom.overheat_start_timer_level_1 * 1000;
+  // Nothing journaled yet, so fall back to the single-copy layout used by earlier firmware.
+  uint32_t l_crc_check;
+  EEPROM.get(EEPROM.length() - sizeof(eepromCRC()), l_crc_check);
 
-      i_ms_overheat_initiate[0] = i_ms_overheat_initiate_level_1;
-    }
+  if(eepromCRC() == l_crc_check) {
+    EEPROM.get(0, obj_config_eeprom);
+    EEPROM.get(sizeof(objConfigEEPROM), obj_led_eeprom);
 
-    if(obj_config_eeprom.overheat_level_5 > 0 && obj_config_eeprom.overheat_level_5 != 255) {
-      if(obj_config_eeprom.overheat_level_5 > 1) {
-        b_overheat_level_5 = true;
-      }
-      else {
-        b_overheat_level_5 = false;
-      }
-    }
+    // Carry the stored preferences over into the journal.
+    writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_config_eeprom);
+    writeEEPROMRecord(EEPROM_RECORD_LED, (const uint8_t*) &obj_led_eeprom);
 
-    if(obj_config_eeprom.overheat_level_4 > 0 && obj_config_eeprom.overheat_level_4 != 255) {
-      if(obj_config_eeprom.overheat_level_4 > 1) {
-        b_overheat_level_4 = true;
-      }
-      else {
-        b_overheat_level_4 = false;
-      }
-    }
+    return true;
+  }
 
-    if(obj_config_eeprom.overheat_level_3 > 0 && obj_config_eeprom.overheat_level_3 != 255) {
-      if(obj_config_eeprom.overheat_level_3 > 1) {
-        b_overheat_level_3 = true;
-      }
-      else {
-        b_overheat_level_3 = false;
-      }
-    }
+  return false;
+}
 
-    if(obj_config_eeprom.overheat_level_2 > 0 && obj_config_eeprom.overheat_level_2 != 255) {
-      if(obj_config_eeprom.overheat_level_2 > 1) {
-        b_overheat_level_2 = true;
-      }
-      else {
-        b_overheat_level_2 = false;
-      }
-    }
+/*
+ * Preference Schema
+ *
+ * Every stored preference is a single byte, described by one PROGMEM entry holding the record and offset
+ * of that byte, the range of stored values which are accepted, and how an accepted value is applied.
+ * Stored values outside of that range (0 and 255 mean "never set") keep the defaults from Configuration.h.
+ */
+enum PREFERENCE_TYPES { PREF_FLAG, PREF_FLAG_INVERTED, PREF_BYTE, PREF_SECONDS, PREF_APPLY };
+
+struct objPreferenceField {
+  uint8_t record;         // EEPROM record which holds the value.
+  uint8_t offset;         // Byte offset of the value within that record.
+  uint8_t type;           // How an accepted value is applied.
+  uint8_t min;            // Lowest stored value which is accepted.
+  uint8_t max;            // Highest stored value which is accepted.
+  void *p_target;         // Variable updated by the PREF_FLAG, PREF_FLAG_INVERTED, PREF_BYTE and PREF_SECONDS types.
+  void (*apply)(uint8_t); // Called with the stored value by the PREF_APPLY type.
+};
 
-    if(obj_config_eeprom.overheat_level_1 > 0 && obj_config_eeprom.overheat_level_1 != 255) {
-      if(obj_config_eeprom.overheat_level_1 > 1) {
-        b_overheat_level_1 = true;
-      }
-      else {
-        b_overheat_level_1 = false;
-      }
-    }
+#define PREF_CONFIG(field, type, min, max, target, apply) { EEPROM_RECORD_CONFIG, offsetof(objConfigEEPROM, field), type, min, max, target, apply }
+#define PREF_LED(field, type, min, max, target, apply) { EEPROM_RECORD_LED, offsetof(objLEDEEPROM, field), type, min, max, target, apply }
 
-    if(obj_config_eeprom.wand_vibration > 0 && obj_config_eeprom.wand_vibration != 255) {
-      switch(obj_config_eeprom.wand_vibration) {
-        case 4:
-        default:
-          // Do nothing. Readings are taken from the vibration toggle switch from the Proton pack or configuration setting in stand alone mode.
-          VIBRATION_MODE_EEPROM = VIBRATION_DEFAULT;
-          VIBRATION_MODE = VIBRATION_FIRING_ONLY;
-        break;
-
-        case 3:
-          VIBRATION_MODE_EEPROM = VIBRATION_NONE;
-          VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-        break;
-
-        case 2:
-          b_vibration_switch_on = true; // Override the Proton Pack vibration toggle switch.
-          VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
-          VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-        break;
-
-        case 1:
-          b_vibration_switch_on = true; // Override the Proton Pack vibration toggle switch.
-          VIBRATION_MODE_EEPROM = VIBRATION_ALWAYS;
-          VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-        break;
-      }
-    }
+void applyCrossTheStreams(uint8_t i_value) {
+  if(i_value > 1) {
+    FIRING_MODE = CTS_MODE; // At least the CTS mode is enabled.
+  }
+}
 
-    // Rebuild the overheat enabled power levels.
-    resetOverheatLevels();
+void applyCrossTheStreamsMix(uint8_t i_value) {
+  if(i_value > 1 && FIRING_MODE == CTS_MODE) {
+    FIRING_MODE = CTS_MIX_MODE; // Upgrade to the CTS Mix mode.
+  }
+}
 
-    // Reset the blinking white LED interval.
-    resetWhiteLEDBlinkRate();
+void applySpectralMode(uint8_t i_value) {
+  b_spectral_mode_enabled = i_value > 1;
+  b_spectral_custom_mode_enabled = i_value > 1;
+  b_holiday_mode_enabled = i_value > 1;
+}
+
+void applyBargraphMode(uint8_t i_value) {
+  switch(i_value) {
+    case 1:
+    default:
+      BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_DEFAULT;
+    break;
 
-    // Read our LED object from the EEPROM.
-    objLEDEEPROM obj_led_eeprom;
-    uint16_t i_eepromLEDAddress = i_eepromAddress + sizeof(objConfigEEPROM);
+    case 2:
+      BARGRAPH_MODE = BARGRAPH_SUPER_HERO;
+      BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_SUPER_HERO;
+    break;
 
-    EEPROM.get(i_eepromLEDAddress, obj_led_eeprom);
+    case 3:
+      BARGRAPH_MODE = BARGRAPH_ORIGINAL;
+      BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_ORIGINAL;
+    break;
+  }
+}
 
-    if(obj_led_eeprom.barrel_spectral_custom > 0 && obj_led_eeprom.barrel_spectral_custom != 255) {
-      i_spectral_wand_custom_colour = obj_led_eeprom.barrel_spectral_custom;
-    }
+void applyBargraphFiringAnimation(uint8_t i_value) {
+  switch(i_value) {
+    case 1:
+    default:
+      BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_DEFAULT;
+    break;
 
-    if(obj_led_eeprom.barrel_spectral_saturation_custom > 0 && obj_led_eeprom.barrel_spectral_saturation_custom != 255) {
-      i_spectral_wand_custom_saturation = obj_led_eeprom.barrel_spectral_saturation_custom;
-    }
+    case 2:
+      BARGRAPH_FIRING_ANIMATION = BARGRAPH_ANIMATION_SUPER_HERO;
+      BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_SUPER_HERO;
+    break;
 
-    if(obj_led_eeprom.num_barrel_leds > 0 && obj_led_eeprom.num_barrel_leds != 255) {
-      i_num_barrel_leds = obj_led_eeprom.num_barrel_leds;
+    case 3:
+      BARGRAPH_FIRING_ANIMATION = BARGRAPH_ANIMATION_ORIGINAL;
+      BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_ORIGINAL;
+    break;
+  }
+}
 
-      switch(i_num_barrel_leds) {
-        case 5:
-        default:
-          WAND_BARREL_LED_COUNT = LEDS_5;
-        break;
+void applyWandYearMode(uint8_t i_value) {
+  switch(i_value) {
+    case 1:
+    default:
+      WAND_YEAR_MODE = YEAR_DEFAULT;
+    break;
+    case 2:
+      WAND_YEAR_MODE = YEAR_1984;
+    break;
+    case 3:
+      WAND_YEAR_MODE = YEAR_1989;
+    break;
+    case 4:
+      WAND_YEAR_MODE = YEAR_AFTERLIFE;
+    break;
+    case 5:
+      WAND_YEAR_MODE = YEAR_FROZEN_EMPIRE;
+    break;
+  }
+}
 
-        case 2:
-          WAND_BARREL_LED_COUNT = LEDS_2;
-        break;
+void applyCTSMode(uint8_t i_value) {
+  switch(i_value) {
+    case 1:
+    default:
+      WAND_YEAR_CTS = CTS_DEFAULT;
+    break;
+    case 2:
+      WAND_YEAR_CTS = CTS_1984;
+    break;
+    case 4:
+      WAND_YEAR_CTS = CTS_AFTERLIFE;
+    break;
+  }
+}
 
-        case 48:
-          WAND_BARREL_LED_COUNT = LEDS_48;
-        break;
+void applySystemMode(uint8_t i_value) {
+  if(!b_gpstar_benchtest) {
+    return;
+  }
 
-        case 50:
-          WAND_BARREL_LED_COUNT = LEDS_50;
-          i_num_barrel_leds = 48; // Need to reset it to 48. 2 are for the tip.
-        break;
-      }
-    }
+  if(i_value > 1) {
+    SYSTEM_MODE = MODE_ORIGINAL;
+  }
+  else {
+    SYSTEM_MODE = MODE_SUPER_HERO;
+  }
+}
 
-    if(obj_led_eeprom.num_bargraph_leds > 0 && obj_led_eeprom.num_bargraph_leds != 255) {
-      if(obj_led_eeprom.num_bargraph_leds < 30) {
-        BARGRAPH_TYPE_EEPROM = SEGMENTS_28;
-      }
-      else {
-        BARGRAPH_TYPE_EEPROM = SEGMENTS_30;
-      }
+void applyDefaultVolume(uint8_t i_value) {
+  if(!b_gpstar_benchtest) {
+    return;
+  }
 
-      if(BARGRAPH_TYPE != SEGMENTS_5) {
-        // Only override the bargraph LED count if we are not using a stock bargraph.
-        BARGRAPH_TYPE = BARGRAPH_TYPE_EEPROM;
-      }
-    }
+  // EEPROM value is from 1 to 101; subtract 1 to get the correct percentage.
+  i_volume_master_percentage = i_value - 1;
+  i_volume_master_eeprom = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100);
+  i_volume_revert = i_volume_master_eeprom;
+  i_volume_master = i_volume_master_eeprom;
+}
 
-    if(obj_led_eeprom.rgb_vent_light > 0 && obj_led_eeprom.rgb_vent_light != 255) {
-      if(obj_led_eeprom.rgb_vent_light > 1) {
-        b_rgb_vent_light = true;
-      }
-      else {
-        b_rgb_vent_light = false;
-      }
-    }
+void applyWandVibration(uint8_t i_value) {
+  switch(i_value) {
+    case 4:
+    default:
+      // Do nothing. Readings are taken from the vibration toggle switch from the Proton pack or configuration setting in stand alone mode.
+      VIBRATION_MODE_EEPROM = VIBRATION_DEFAULT;
+      VIBRATION_MODE = VIBRATION_FIRING_ONLY;
+    break;
+
+    case 3:
+      VIBRATION_MODE_EEPROM = VIBRATION_NONE;
+      VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+    break;
+
+    case 2:
+      b_vibration_switch_on = true; // Override the Proton Pack vibration toggle switch.
+      VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
+      VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+    break;
+
+    case 1:
+      b_vibration_switch_on = true; // Override the Proton Pack vibration toggle switch.
+      VIBRATION_MODE_EEPROM = VIBRATION_ALWAYS;
+      VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+    break;
+  }
+}
+
+void applyBarrelLEDCount(uint8_t i_value) {
+  i_num_barrel_leds = i_value;
+
+  switch(i_num_barrel_leds) {
+    case 5:
+    default:
+      WAND_BARREL_LED_COUNT = LEDS_5;
+    break;
+
+    case 2:
+      WAND_BARREL_LED_COUNT = LEDS_2;
+    break;
+
+    case 48:
+      WAND_BARREL_LED_COUNT = LEDS_48;
+    break;
+
+    case 50:
+      WAND_BARREL_LED_COUNT = LEDS_50;
+      i_num_barrel_leds = 48; // Need to reset it to 48. 2 are for the tip.
+    break;
+  }
+}
+
+void applyBargraphLEDCount(uint8_t i_value) {
+  if(i_value < 30) {
+    BARGRAPH_TYPE_EEPROM = SEGMENTS_28;
+  }
+  else {
+    BARGRAPH_TYPE_EEPROM = SEGMENTS_30;
+  }
+
+  if(BARGRAPH_TYPE != SEGMENTS_5) {
+    // Only override the bargraph LED count if we are not using a stock bargraph.
+    BARGRAPH_TYPE = BARGRAPH_TYPE_EEPROM;
+  }
+}
+
+const objPreferenceField preferenceFields[] PROGMEM = {
+  // The mix option only upgrades an enabled CTS mode, so it must follow the CTS entry.
+  PREF_CONFIG(cross_the_streams, PREF_APPLY, 1, 254, nullptr, applyCrossTheStreams),
+  PREF_CONFIG(cross_the_streams_mix, PREF_APPLY, 1, 254, nullptr, applyCrossTheStreamsMix),
+  PREF_CONFIG(overheating, PREF_FLAG, 1, 254, &b_overheat_enabled, nullptr),
+  PREF_CONFIG(extra_proton_sounds, PREF_FLAG, 1, 254, &b_stream_effects, nullptr),
+  PREF_CONFIG(neutrona_wand_sounds, PREF_FLAG, 1, 254, &b_extra_pack_sounds, nullptr),
+  PREF_CONFIG(spectral_mode, PREF_APPLY, 1, 254, nullptr, applySpectralMode),
+  PREF_CONFIG(quick_vent, PREF_FLAG, 1, 254, &b_quick_vent, nullptr),
+  PREF_CONFIG(wand_boot_errors, PREF_FLAG, 1, 254, &b_wand_boot_errors, nullptr),
+  PREF_CONFIG(vent_light_auto_intensity, PREF_FLAG, 1, 254, &b_vent_light_control, nullptr),
+  PREF_CONFIG(invert_bargraph, PREF_FLAG, 1, 254, &b_bargraph_invert, nullptr),
+  PREF_CONFIG(bargraph_mode, PREF_APPLY, 1, 254, nullptr, applyBargraphMode),
+  PREF_CONFIG(bargraph_firing_animation, PREF_APPLY, 1, 254, nullptr, applyBargraphFiringAnimation),
+  PREF_CONFIG(bargraph_overheat_blinking, PREF_FLAG, 1, 254, &b_overheat_bargraph_blink, nullptr),
+  PREF_CONFIG(neutrona_wand_year_mode, PREF_APPLY, 1, 254, nullptr, applyWandYearMode),
+  PREF_CONFIG(CTS_mode, PREF_APPLY, 1, 254, nullptr, applyCTSMode),
+  PREF_CONFIG(system_mode, PREF_APPLY, 1, 254, nullptr, applySystemMode),
+  PREF_CONFIG(beep_loop, PREF_FLAG, 1, 254, &b_beep_loop, nullptr),
+  PREF_CONFIG(default_system_volume, PREF_APPLY, 1, 101, nullptr, applyDefaultVolume),
+  PREF_CONFIG(overheat_start_timer_level_5, PREF_SECONDS, 1, 254, &i_ms_overheat_initiate_level_5, nullptr),
+  PREF_CONFIG(overheat_start_timer_level_4, PREF_SECONDS, 1, 254, &i_ms_overheat_initiate_level_4, nullptr),
+  PREF_CONFIG(overheat_start_timer_level_3, PREF_SECONDS, 1, 254, &i_ms_overheat_initiate_level_3, nullptr),
+  PREF_CONFIG(overheat_start_timer_level_2, PREF_SECONDS, 1, 254, &i_ms_overheat_initiate_level_2, nullptr),
+  PREF_CONFIG(overheat_start_timer_level_1, PREF_SECONDS, 1, 254, &i_ms_overheat_initiate_level_1, nullptr),
+  PREF_CONFIG(overheat_level_5, PREF_FLAG, 1, 254, &b_overheat_level_5, nullptr),
+  PREF_CONFIG(overheat_level_4, PREF_FLAG, 1, 254, &b_overheat_level_4, nullptr),
+  PREF_CONFIG(overheat_level_3, PREF_FLAG, 1, 254, &b_overheat_level_3, nullptr),
+  PREF_CONFIG(overheat_level_2, PREF_FLAG, 1, 254, &b_overheat_level_2, nullptr),
+  PREF_CONFIG(overheat_level_1, PREF_FLAG, 1, 254, &b_overheat_level_1, nullptr),
+  PREF_CONFIG(wand_vibration, PREF_APPLY, 1, 254, nullptr, applyWandVibration),
+  PREF_LED(barrel_spectral_custom, PREF_BYTE, 1, 254, &i_spectral_wand_custom_colour, nullptr),
+  PREF_LED(barrel_spectral_saturation_custom, PREF_BYTE, 1, 254, &i_spectral_wand_custom_saturation, nullptr),
+  PREF_LED(num_barrel_leds, PREF_APPLY, 1, 254, nullptr, applyBarrelLEDCount),
+  PREF_LED(num_bargraph_leds, PREF_APPLY, 1, 254, nullptr, applyBargraphLEDCount),
+  PREF_LED(rgb_vent_light, PREF_FLAG, 1, 254, &b_rgb_vent_light, nullptr)
+};
+
+const uint8_t i_preference_fields = sizeof(preferenceFields) / sizeof(objPreferenceField);
+
+// Apply a single stored value to the runtime variables described by its schema entry.
+void applyPreferenceField(const objPreferenceField &field, uint8_t i_value) {
+  if(i_value < field.min || i_value > field.max) {
+    return;
+  }
+
+  switch(field.type) {
+    case PREF_FLAG:
+      // 1 = false, 2 = true.
+      *(bool*) field.p_target = i_value > 1;
+    break;
+
+    case PREF_FLAG_INVERTED:
+      // 1 = true, 2 = false.
+      *(bool*) field.p_target = i_value < 2;
+    break;
+
+    case PREF_BYTE:
+      *(uint8_t*) field.p_target = i_value;
+    break;
+
+    case PREF_SECONDS:
+      *(uint16_t*) field.p_target = (uint16_t) i_value * 1000;
+    break;
+
+    case PREF_APPLY:
+    default:
+      field.apply(i_value);
+    break;
+  }
+}
+
+// Validate and apply every field in the schema from the loaded preference objects.
+void applyPreferences(const uint8_t *p_records[EEPROM_RECORD_KINDS]) {
+  objPreferenceField field;
+
+  for(uint8_t i = 0; i < i_preference_fields; i++) {
+    memcpy_P(&field, &preferenceFields[i], sizeof(objPreferenceField));
+    applyPreferenceField(field, p_records[field.record][field.offset]);
+  }
+}
+
+/*
+ * Read all user preferences from Proton Pack controller EEPROM.
+ */
+void readEEPROM() {
+  objConfigEEPROM obj_config_eeprom = {};
+  objLEDEEPROM obj_led_eeprom = {};
+
+  // Locate the newest stored copy of each preference object.
+  if(loadEEPROM(obj_config_eeprom, obj_led_eeprom)) {
+    const uint8_t *p_records[EEPROM_RECORD_KINDS] = { (const uint8_t*) &obj_config_eeprom, (const uint8_t*) &obj_led_eeprom };
+
+    // Assume that the VG_MODE as default, overriding as necessary based on stored flags.
+    FIRING_MODE = VG_MODE;
+
+    applyPreferences(p_records);
+
+    // Remember this as the last firing mode as well.
+    LAST_FIRING_MODE = FIRING_MODE;
+
+    // Rebuild the overheat enabled power levels and timers.
+    resetOverheatLevels();
+
+    // Reset the blinking white LED interval.
+    resetWhiteLEDBlinkRate();
   }
   else {
-    // CRC doesn't match; let's clear the EEPROMs to be safe.
+    // Nothing valid was found; let's clear the EEPROMs to be safe.
     playEffect(S_VOICE_EEPROM_LOADING_FAILED_RESET);
 
     clearConfigEEPROM();
@@ -493,21 +629,13 @@ void readEEPROM() {
 }
 
 void clearLEDEEPROM() {
-  // Clear out the EEPROM data for the configuration settings only.
-  uint16_t i_eepromLEDAddress = i_eepromAddress + sizeof(objConfigEEPROM);
+  // Store an empty LED object so that defaults are used.
+  objLEDEEPROM obj_led_eeprom = {};
 
-  for(uint16_t i = 0; i < sizeof(objLEDEEPROM); i++) {
-    EEPROM.update(i_eepromLEDAddress, 0);
-
-    i_eepromLEDAddress++;
-  }
-
-  updateCRCEEPROM();
+  writeEEPROMRecord(EEPROM_RECORD_LED, (const uint8_t*) &obj_led_eeprom);
 }
 
 void saveLEDEEPROM() {
-  uint16_t i_eepromLEDAddress = i_eepromAddress + sizeof(objConfigEEPROM);
-
   uint8_t i_barrel_led_count = 5; // 5 = Hasbro, 50 = GPStar Neutrona Barrel, 2 = GPStar Barrel LED Mini, 48 = Frutto.
   uint8_t i_bargraph_led_count = 28; // 28 segment, 30 segment.
   uint8_t i_rgb_vent_light = 1; // 1 = RGB Vent Light disabled, 2 = RGB Vent Light enabled
@@ -539,10 +667,8 @@ void saveLEDEEPROM() {
     i_rgb_vent_light
   };
 
-  // Save to the EEPROM.
-  EEPROM.put(i_eepromLEDAddress, obj_led_eeprom);
-
-  updateCRCEEPROM();
+  // Append the object to the EEPROM journal if any of the values have changed.
+  writeEEPROMRecord(EEPROM_RECORD_LED, (const uint8_t*) &obj_led_eeprom);
 
   if(WAND_BARREL_LED_COUNT == LEDS_50) {
     i_barrel_led_count = 48; // Needs to be reset back to 48 while 50 is stored in the EEPROM. 2 are for the tip.
@@ -550,12 +676,10 @@ void saveLEDEEPROM() {
 }
 
 void clearConfigEEPROM() {
-  // Clear out the EEPROM only in the memory addresses used for our EEPROM data object.
-  for(uint16_t i = 0; i < sizeof(objConfigEEPROM); i++) {
-    EEPROM.update(i, 0);
-  }
+  // Store an empty configuration object so that defaults are used.
+  objConfigEEPROM obj_config_eeprom = {};
 
-  updateCRCEEPROM();
+  writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_config_eeprom);
 }
 
 void saveConfigEEPROM() {
@@ -797,21 +921,15 @@ void saveConfigEEPROM() {
     i_wand_vibration
   };
 
-  // Save and update our object in the EEPROM.
-  EEPROM.put(i_eepromAddress, obj_config_eeprom);
-
-  updateCRCEEPROM();
-}
-
-// Update the CRC in the EEPROM.
-void updateCRCEEPROM() {
-  EEPROM.put(EEPROM.length() - sizeof(eepromCRC()), eepromCRC());
+  // Append the object to the EEPROM journal if any of the values have changed.
+  writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_config_eeprom);
 }
 
+// CRC of the single-copy layout used by earlier firmware, kept only to migrate it into the journal.
 uint32_t eepromCRC(void) {
   CRC32 crc;
 
-  for(uint16_t index = 0; index < (i_eepromAddress + sizeof(objConfigEEPROM) + sizeof(objLEDEEPROM)); index++) {
+  for(uint16_t index = 0; index < (sizeof(objConfigEEPROM) + sizeof(objLEDEEPROM)); index++) {
     crc.update(EEPROM[index]);
   }
 
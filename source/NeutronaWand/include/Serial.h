@@ -27,7 +27,8 @@ enum PACKET_TYPE : uint8_t {
   PACKET_PACK = 3,
   PACKET_WAND = 4,
   PACKET_SMOKE = 5,
-  PACKET_SYNC = 6
+  PACKET_SYNC = 6,
+  PACKET_MEMORY = 7
 };
 
 // For command signals (1 byte ID, 2 byte optional data).
@@ -326,6 +327,16 @@ void wandSerialSendData(uint8_t i_message) {
       wandComs.sendData(i_send_size, (uint8_t) PACKET_SMOKE);
     break;
 
+    case W_MEMORY_STATS:
+    {
+      MemoryStats wandMemory;
+      updateMemoryStats(wandMemory);
+
+      i_send_size = wandComs.txObj(wandMemory);
+      wandComs.sendData(i_send_size, (uint8_t) PACKET_MEMORY);
+    }
+    break;
+
     default:
       // No-op for all other actions.
     break;
@@ -966,7 +977,7 @@ bool handlePackCommand(uint8_t i_command, uint16_t i_value) {
             case SYSTEM_AFTERLIFE:
             case SYSTEM_FROZEN_EMPIRE:
             default:
-              if(!b_sound_idle) {
+              if(!firingState.soundIdle) {
                 stopAfterlifeSounds();
                 playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_1);
 
@@ -1024,7 +1035,7 @@ bool handlePackCommand(uint8_t i_command, uint16_t i_value) {
             case SYSTEM_AFTERLIFE:
             case SYSTEM_FROZEN_EMPIRE:
             default:
-              if(!b_sound_idle) {
+              if(!firingState.soundIdle) {
                 stopAfterlifeSounds();
                 playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_1);
 
@@ -1035,7 +1046,7 @@ bool handlePackCommand(uint8_t i_command, uint16_t i_value) {
             break;
           }
 
-          if(!b_firing) {
+          if(!firingState.firing) {
             // This is handled by modeFireStop() if firing when ribbon cable is removed.
             prepBargraphRampDown();
           }
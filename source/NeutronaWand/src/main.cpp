@@ -53,15 +53,17 @@
 #include <CRC32.h>
 #include <digitalWriteFast.h>
 #include <EEPROM.h>
-#include <millisDelay.h>
 #include <FastLED.h>
-#include <avdweb_Switch.h>
 #include <ht16k33.h>
 #include <Wire.h>
 #include <SerialTransfer.h>
 
 // Local Files
+#include "Timers.h"
+#include "Memory.h"
+#include "Flags.h"
 #include "Configuration.h"
+#include "Inputs.h"
 #include "MusicSounds.h"
 #include "Communication.h"
 #include "Header.h"
@@ -89,6 +91,7 @@ void checkMenuVibration();
 void checkPowerOnReminder();
 void checkRotaryEncoder();
 void checkSwitches();
+void clearRotaryDetents();
 void cyclotronSpeedUp(uint8_t speed);
 void fireControlCheck();
 void fireEffectEnd();
@@ -178,13 +181,24 @@ void setup() {
   SYSTEM_YEAR = SYSTEM_AFTERLIFE;
   WAND_BARREL_LED_COUNT = LEDS_5;
 
-  switch_vent.setPushedCallback(&ventSwitched);
-  switch_wand.setPushedCallback(&wandSwitched);
+  // Configure the various switches on the wand.
+  pinModeFast(INTENSIFY_SWITCH_PIN, INPUT_PULLUP);
+  pinModeFast(ACTIVATE_SWITCH_PIN, INPUT_PULLUP);
+  pinModeFast(VENT_SWITCH_PIN, INPUT_PULLUP);
+  pinModeFast(WAND_SWITCH_PIN, INPUT_PULLUP);
+  pinModeFast(MODE_SWITCH_PIN, INPUT_PULLUP);
+  pinModeFast(BARREL_SWITCH_PIN, INPUT_PULLUP);
+  delayMicroseconds(10); // Let the pull-ups settle before the first sample.
+  wandSwitches.begin(readWandSwitches(), millis());
 
   // Rotary encoder on the top of the wand.
   pinModeFast(ROTARY_ENCODER_A, INPUT_PULLUP);
   pinModeFast(ROTARY_ENCODER_B, INPUT_PULLUP);
 
+  // Decode the rotary encoder from the Timer0 compare B interrupt, midway between the millis() updates.
+  OCR0B = 0x80;
+  TIMSK0 |= _BV(OCIE0B);
+
   Wire.begin();
   Wire.setClock(400000UL); // Sets the i2c bus to 400kHz
 
@@ -274,6 +288,9 @@ void setup() {
   // Initialize the timer for initial handshake.
   ms_packsync.start(0);
 
+  // Initialize the timer for SRAM usage reports.
+  ms_memory_check.start(i_memory_check_delay);
+
   if(b_gpstar_benchtest) {
     WAND_CONN_STATE = NC_BENCHTEST;
 
@@ -294,6 +311,9 @@ void setup() {
 }
 
 void loop() {
+  // Check whether any timers have come due since the last pass.
+  updateTimers();
+
   switch(WAND_CONN_STATE) {
     case PACK_DISCONNECTED:
       // While waiting for a proton pack, issue a request for synchronization.
@@ -306,6 +326,8 @@ void loop() {
       }
 
       checkPack(); // Check for any response from the pack while still waiting.
+
+      clearRotaryDetents(); // Inputs are not read until a pack is connected.
     break;
 
     case PACK_CONNECTED:
@@ -315,6 +337,11 @@ void loop() {
         ms_handshake.restart(); // Restart the handshake timer.
       }
 
+      if(ms_memory_check.justFinished()) {
+        wandSerialSendData(W_MEMORY_STATS); // Report SRAM usage, which the pack relays to the Attenuator.
+        ms_memory_check.restart();
+      }
+
       updateAudio(); // Update the state of the selected sound board.
 
       checkPack(); // Get the latest communications from the connected Proton Pack.
@@ -322,6 +349,9 @@ void loop() {
       if(b_pack_post_finish) {
         mainLoop(); // Continue on to the main loop.
       }
+      else {
+        clearRotaryDetents(); // Inputs are not read while the pack runs its POST.
+      }
     break;
 
     case NC_BENCHTEST:
@@ -558,7 +588,7 @@ void mainLoop() {
   // Handle button press events based on current wand state and menu level (for config/EEPROM purposes).
   checkWandAction();
 
-  if(b_firing == true && WAND_ACTION_STATUS != ACTION_FIRING) {
+  if(firingState.firing == true && WAND_ACTION_STATUS != ACTION_FIRING) {
     modeFireStop();
   }
 
@@ -682,7 +712,7 @@ void wandTipOn() {
             c_temp = C_BEIGE;
           }
         }
-        else if(b_firing_cross_streams == true && !b_pack_cyclotron_lid_on) {
+        else if(firingState.crossStreams == true && !b_pack_cyclotron_lid_on) {
           // Set the tip of the Frutto LED array to greenish if in Frozen Empire and using CTS mode.
           c_temp = C_CHARTREUSE;
         }
@@ -818,7 +848,7 @@ void hatLightControl() {
             // In 1984 and 1989 the top hat light never comes on, and the barrel hat light comes on when firing.
             digitalWriteFast(TOP_HAT_LED_PIN, LOW);
 
-            if(b_firing) {
+            if(firingState.firing) {
               digitalWriteFast(BARREL_HAT_LED_PIN, HIGH);
             }
             else {
@@ -860,7 +890,7 @@ void resetHatLights() {
   ms_error_blink.stop();
 
   // Reset barrel wing hat light.
-  if(b_firing || ((getNeutronaWandYearMode() == SYSTEM_AFTERLIFE || getNeutronaWandYearMode() == SYSTEM_FROZEN_EMPIRE) && WAND_STATUS == MODE_ON)) {
+  if(firingState.firing || ((getNeutronaWandYearMode() == SYSTEM_AFTERLIFE || getNeutronaWandYearMode() == SYSTEM_FROZEN_EMPIRE) && WAND_STATUS == MODE_ON)) {
     digitalWriteFast(BARREL_HAT_LED_PIN, HIGH);
   }
   else {
@@ -1022,7 +1052,7 @@ void startQuickVent() {
 }
 
 void startVentSequence() {
-  if(WAND_ACTION_STATUS == ACTION_FIRING && b_firing) {
+  if(WAND_ACTION_STATUS == ACTION_FIRING && firingState.firing) {
     modeFireStop();
   }
 
@@ -1123,18 +1153,18 @@ void settingsBlinkingLights() {
         for(uint8_t i = 0; i < i_bargraph_segments - i_segment_adjust; i++) {
           if(i > 0 && ((b_solid_one == true && i < i_bottom_segment_rows) || i >= i_top_segment_rows)) {
             ht_bargraph.setLed(bargraphLookupTable(i));
-            b_bargraph_status[i] = true;
+            b_bargraph_status.set(i, true);
           }
           else {
             ht_bargraph.clearLed(bargraphLookupTable(i));
-            b_bargraph_status[i] = false;
+            b_bargraph_status.set(i, false);
           }
         }
 
         if(BARGRAPH_TYPE == SEGMENTS_30) {
           // On the 30-segment bargraph the last segment is always off.
           ht_bargraph.clearLed(bargraphLookupTable(i_bargraph_segments - 1));
-          b_bargraph_status[i_bargraph_segments - 1] = false;
+          b_bargraph_status.set(i_bargraph_segments - 1, false);
         }
 
         ht_bargraph.sendLed(); // Commit the changes.
@@ -1143,11 +1173,11 @@ void settingsBlinkingLights() {
         for(uint8_t i = 1; i < i_bargraph_segments - i_segment_adjust; i++) {
           if(i > 0 && i < i_bottom_segment_rows) {
             ht_bargraph.setLed(bargraphLookupTable(i));
-            b_bargraph_status[i] = true;
+            b_bargraph_status.set(i, true);
           }
           else {
             ht_bargraph.clearLed(bargraphLookupTable(i));
-            b_bargraph_status[i] = false;
+            b_bargraph_status.set(i, false);
           }
         }
 
@@ -1198,7 +1228,7 @@ void settingsBlinkingLights() {
 
                 default:
                   ht_bargraph.setLed(bargraphLookupTable(i));
-                  b_bargraph_status[i] = true;
+                  b_bargraph_status.set(i, true);
                 break;
               }
             }
@@ -1223,7 +1253,7 @@ void settingsBlinkingLights() {
 
                 default:
                   ht_bargraph.setLed(bargraphLookupTable(i));
-                  b_bargraph_status[i] = true;
+                  b_bargraph_status.set(i, true);
                 break;
               }
             }
@@ -1252,7 +1282,7 @@ void settingsBlinkingLights() {
 
                 default:
                   ht_bargraph.setLed(bargraphLookupTable(i));
-                  b_bargraph_status[i] = true;
+                  b_bargraph_status.set(i, true);
                 break;
               }
             }
@@ -1274,7 +1304,7 @@ void settingsBlinkingLights() {
 
                 default:
                   ht_bargraph.setLed(bargraphLookupTable(i));
-                  b_bargraph_status[i] = true;
+                  b_bargraph_status.set(i, true);
                 break;
               }
             }
@@ -1301,7 +1331,7 @@ void settingsBlinkingLights() {
 
                 default:
                   ht_bargraph.setLed(bargraphLookupTable(i));
-                  b_bargraph_status[i] = true;
+                  b_bargraph_status.set(i, true);
                 break;
               }
             }
@@ -1320,7 +1350,7 @@ void settingsBlinkingLights() {
 
                 default:
                   ht_bargraph.setLed(bargraphLookupTable(i));
-                  b_bargraph_status[i] = true;
+                  b_bargraph_status.set(i, true);
                 break;
               }
             }
@@ -1345,7 +1375,7 @@ void settingsBlinkingLights() {
 
                 default:
                   ht_bargraph.setLed(bargraphLookupTable(i));
-                  b_bargraph_status[i] = true;
+                  b_bargraph_status.set(i, true);
                 break;
               }
             }
@@ -1361,7 +1391,7 @@ void settingsBlinkingLights() {
 
                 default:
                   ht_bargraph.setLed(bargraphLookupTable(i));
-                  b_bargraph_status[i] = true;
+                  b_bargraph_status.set(i, true);
                 break;
               }
             }
@@ -1379,13 +1409,13 @@ void settingsBlinkingLights() {
           if(BARGRAPH_TYPE == SEGMENTS_30) {
             for(uint8_t i = 1; i < 5; i++) {
               ht_bargraph.setLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = true;
+              b_bargraph_status.set(i, true);
             }
           }
           else {
             for(uint8_t i = 1; i < 4; i++) {
               ht_bargraph.setLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = true;
+              b_bargraph_status.set(i, true);
             }
           }
 
@@ -1687,7 +1717,7 @@ void wandVentStateCheck() {
       soundIdleStart();
 
       if(switch_wand.on()) {
-        if(!b_beeping) {
+        if(!firingState.beeping) {
           // Beep loop.
           soundBeepLoop();
         }
@@ -1765,7 +1795,7 @@ void wandOff() {
 
     case SYSTEM_1984:
     case SYSTEM_1989:
-      if(!b_sound_idle) {
+      if(!firingState.soundIdle) {
         stopEffect(S_WAND_BOOTUP_SHORT);
       }
     break;
@@ -1808,7 +1838,7 @@ void wandOff() {
       switch(getNeutronaWandYearMode()) {
         case SYSTEM_1984:
         case SYSTEM_1989:
-          if(SYSTEM_MODE == MODE_SUPER_HERO && !b_sound_idle && !b_wand_mash_error && b_gpstar_benchtest) {
+          if(SYSTEM_MODE == MODE_SUPER_HERO && !firingState.soundIdle && !b_wand_mash_error && b_gpstar_benchtest) {
             // Proton Pack plays shutdown sound, but standalone Wand needs to play its own.
             stopEffect(S_WAND_HEATDOWN);
             playEffect(S_WAND_HEATDOWN);
@@ -1818,7 +1848,7 @@ void wandOff() {
         case SYSTEM_AFTERLIFE:
         case SYSTEM_FROZEN_EMPIRE:
         default:
-          if(!b_sound_idle && !b_wand_mash_error && WAND_ACTION_STATUS != ACTION_OVERHEATING) {
+          if(!firingState.soundIdle && !b_wand_mash_error && WAND_ACTION_STATUS != ACTION_OVERHEATING) {
             playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_1);
             b_play_afterlife_ramp_down = true;
           }
@@ -1839,7 +1869,7 @@ void wandOff() {
   }
 
   // Stop firing if the wand is turned off.
-  if(b_firing) {
+  if(firingState.firing) {
     modeFireStop();
   }
 
@@ -1891,7 +1921,7 @@ void wandOff() {
 
   // Clear counter until user begins firing again.
   i_bmash_count = 0;
-  b_sound_afterlife_idle_2_fade = true;
+  firingState.soundAfterlifeIdle2Fade = true;
 
   // Turn off some timers.
   ms_overheating.stop();
@@ -2005,7 +2035,7 @@ void fireControlCheck() {
               ms_bmash.start(i_bmash_delay);
             }
 
-            if(!b_firing_intensify) {
+            if(!firingState.intensify) {
               // Increase count each time the user presses a firing button.
               i_bmash_count++;
             }
@@ -2015,31 +2045,31 @@ void fireControlCheck() {
                 WAND_ACTION_STATUS = ACTION_FIRING;
               }
 
-              b_firing_intensify = true;
+              firingState.intensify = true;
             }
           break;
 
           case STASIS:
             // Handle Shock Blast fire start here.
-            if(!b_firing_semi_automatic && ms_semi_automatic_check.remaining() < 1 && WAND_ACTION_STATUS != ACTION_FIRING) {
+            if(!firingState.semiAutomatic && ms_semi_automatic_check.remaining() < 1 && WAND_ACTION_STATUS != ACTION_FIRING) {
               // Start rate-of-fire timer.
               ms_semi_automatic_check.start(i_shock_blast_rate);
 
               modePulseStart();
 
-              b_firing_semi_automatic = true;
+              firingState.semiAutomatic = true;
             }
           break;
 
           case MESON:
             // Handle Meson Collider fire start here.
-            if(!b_firing_semi_automatic && ms_semi_automatic_check.remaining() < 1 && WAND_ACTION_STATUS != ACTION_FIRING) {
+            if(!firingState.semiAutomatic && ms_semi_automatic_check.remaining() < 1 && WAND_ACTION_STATUS != ACTION_FIRING) {
               // Start rate-of-fire timer.
               ms_semi_automatic_check.start(i_meson_collider_rate);
 
               modePulseStart();
 
-              b_firing_semi_automatic = true;
+              firingState.semiAutomatic = true;
             }
           break;
         }
@@ -2054,7 +2084,7 @@ void fireControlCheck() {
             ms_bmash.start(i_bmash_delay);
           }
 
-          if(!b_firing_alt) {
+          if(!firingState.alt) {
             // Increase count each time the user presses a firing button.
             i_bmash_count++;
           }
@@ -2064,40 +2094,40 @@ void fireControlCheck() {
               WAND_ACTION_STATUS = ACTION_FIRING;
             }
 
-            b_firing_alt = true;
+            firingState.alt = true;
           }
         }
         else if(!switch_mode.on()) {
-          if(!b_firing_intensify && WAND_ACTION_STATUS == ACTION_FIRING) {
+          if(!firingState.intensify && WAND_ACTION_STATUS == ACTION_FIRING) {
             WAND_ACTION_STATUS = ACTION_IDLE;
           }
 
-          b_firing_alt = false;
+          firingState.alt = false;
         }
       }
       else {
         if(STREAM_MODE == PROTON && WAND_ACTION_STATUS == ACTION_FIRING) {
           if(switch_mode.on()) {
-            b_firing_alt = true;
+            firingState.alt = true;
           }
         }
         else if(switch_mode.on() && switch_wand.on() && switch_vent.on() && b_switch_barrel_extended) {
           switch(STREAM_MODE) {
             case PROTON:
               // Handle Boson Dart fire start here.
-              if(!b_firing_semi_automatic && ms_semi_automatic_check.remaining() < 1) {
+              if(!firingState.semiAutomatic && ms_semi_automatic_check.remaining() < 1) {
                 // Start rate-of-fire timer.
                 ms_semi_automatic_check.start(i_boson_dart_rate);
 
                 modePulseStart();
 
-                b_firing_semi_automatic = true;
+                firingState.semiAutomatic = true;
               }
             break;
 
             case SLIME:
               // Handle Slime Tether fire start here.
-              if(!b_firing_semi_automatic && WAND_ACTION_STATUS != ACTION_FIRING) {
+              if(!firingState.semiAutomatic && WAND_ACTION_STATUS != ACTION_FIRING) {
                 if(i_slime_tether_count < 1) {
                   // Start the rate-of-fire timer.
                   ms_semi_automatic_check.start(i_slime_tether_rate);
@@ -2114,7 +2144,7 @@ void fireControlCheck() {
                   i_slime_tether_count++;
                 }
 
-                b_firing_semi_automatic = true;
+                firingState.semiAutomatic = true;
               }
             break;
 
@@ -2126,7 +2156,7 @@ void fireControlCheck() {
                 ms_bmash.start(i_bmash_delay);
               }
 
-              if(!b_firing_intensify) {
+              if(!firingState.intensify) {
                 // Increase count each time the user presses a firing button.
                 i_bmash_count++;
               }
@@ -2136,7 +2166,7 @@ void fireControlCheck() {
                   WAND_ACTION_STATUS = ACTION_FIRING;
                 }
 
-                b_firing_intensify = true;
+                firingState.intensify = true;
               }
             break;
 
@@ -2156,19 +2186,19 @@ void fireControlCheck() {
           case HOLIDAY_HALLOWEEN:
           case HOLIDAY_CHRISTMAS:
           default:
-            if(b_firing && b_firing_intensify) {
-              if(!b_firing_alt || vgModeCheck()) {
+            if(firingState.firing && firingState.intensify) {
+              if(!firingState.alt || vgModeCheck()) {
                 WAND_ACTION_STATUS = ACTION_IDLE;
               }
 
-              b_firing_intensify = false;
+              firingState.intensify = false;
             }
           break;
 
           case STASIS:
           case MESON:
             // Handle resetting semi-auto bool here.
-            b_firing_semi_automatic = false;
+            firingState.semiAutomatic = false;
           break;
         }
       }
@@ -2178,14 +2208,14 @@ void fireControlCheck() {
           case PROTON:
           case SLIME:
             // Handle resetting semi-auto bool here.
-            b_firing_semi_automatic = false;
+            firingState.semiAutomatic = false;
           break;
 
           case STASIS:
           case MESON:
-            if(b_firing && b_firing_intensify) {
+            if(firingState.firing && firingState.intensify) {
               WAND_ACTION_STATUS = ACTION_IDLE;
-              b_firing_intensify = false;
+              firingState.intensify = false;
             }
           break;
 
@@ -2394,7 +2424,7 @@ void modeActivate() {
   // Clear counter until user begins firing.
   i_bmash_count = 0;
   b_wand_mash_error = false;
-  b_sound_afterlife_idle_2_fade = true;
+  firingState.soundAfterlifeIdle2Fade = true;
   setPowerOnReminder(false);
 
   switch(SYSTEM_MODE) {
@@ -2628,7 +2658,7 @@ void soundIdleLoopStop(bool stopAlts) {
 }
 
 void soundIdleStart() {
-  if(!b_sound_idle) {
+  if(!firingState.soundIdle) {
     switch(getNeutronaWandYearMode()) {
       case SYSTEM_1984:
       case SYSTEM_1989:
@@ -2658,7 +2688,7 @@ void soundIdleStart() {
 
         soundIdleLoop(true);
 
-        b_sound_idle = true;
+        firingState.soundIdle = true;
       break;
 
       case SYSTEM_AFTERLIFE:
@@ -2666,7 +2696,7 @@ void soundIdleStart() {
       default:
         // Ramp 2 -> Idle 2
         if(b_extra_pack_sounds) {
-          if(b_sound_afterlife_idle_2_fade) {
+          if(firingState.soundAfterlifeIdle2Fade) {
             wandSerialSend(W_AFTERLIFE_GUN_RAMP_2_FADE_IN);
           }
           else {
@@ -2677,7 +2707,7 @@ void soundIdleStart() {
         ms_gun_loop_1.stop();
         ms_gun_loop_2.start(i_gun_loop_2);
 
-        if(b_sound_afterlife_idle_2_fade) {
+        if(firingState.soundAfterlifeIdle2Fade) {
           if(AUDIO_DEVICE == A_GPSTAR_AUDIO_ADV) {
             playTransitionEffect(S_AFTERLIFE_WAND_RAMP_2_FADE_IN, S_AFTERLIFE_WAND_IDLE_2, true, 5);
           }
@@ -2685,7 +2715,7 @@ void soundIdleStart() {
             playEffect(S_AFTERLIFE_WAND_RAMP_2_FADE_IN);
           }
 
-          b_sound_afterlife_idle_2_fade = false;
+          firingState.soundAfterlifeIdle2Fade = false;
         }
         else {
           if(AUDIO_DEVICE == A_GPSTAR_AUDIO_ADV) {
@@ -2702,7 +2732,7 @@ void soundIdleStart() {
         stopEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2);
         stopEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT);
 
-        b_sound_idle = true;
+        firingState.soundIdle = true;
       break;
     }
   }
@@ -2725,7 +2755,7 @@ void soundIdleStart() {
 }
 
 void soundIdleStop() {
-  if(b_sound_idle) {
+  if(firingState.soundIdle) {
     switch(getNeutronaWandYearMode()) {
       case SYSTEM_1984:
       case SYSTEM_1989:
@@ -2781,20 +2811,20 @@ void soundIdleStop() {
     }
   }
 
-  b_sound_idle = false;
+  firingState.soundIdle = false;
 }
 
 void soundBeepLoopStop() {
-  if(b_beeping) {
-    b_beeping = false;
+  if(firingState.beeping) {
+    firingState.beeping = false;
 
     if(switch_wand.on()) {
       // Set all beep looping to false so they stop naturally.
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S1, false);
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S2, false);
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S3, false);
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S4, false);
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S5, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S1, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S2, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S3, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S4, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S5, false);
 
       if(b_extra_pack_sounds) {
         wandSerialSend(W_WAND_BEEP_STOP_LOOP);
@@ -2821,7 +2851,7 @@ void soundBeepLoopStop() {
 
 void soundBeepLoop() {
   if(ms_reset_sound_beep.justFinished() && WAND_ACTION_STATUS != ACTION_OVERHEATING) {
-    if(!b_beeping) {
+    if(!firingState.beeping) {
       // Quick check to know if effects belong to the next-gen movies (as opposed to the OG 80's themes).
       bool b_next_gen = (getNeutronaWandYearMode() == SYSTEM_AFTERLIFE || getNeutronaWandYearMode() == SYSTEM_FROZEN_EMPIRE);
 
@@ -2923,7 +2953,7 @@ void soundBeepLoop() {
         break;
       }
 
-      b_beeping = true;
+      firingState.beeping = true;
 
       ms_reset_sound_beep.stop();
     }
@@ -2985,7 +3015,7 @@ void modeFireStartSounds() {
       switch(i_power_level) {
         case 1 ... 4:
         default:
-          if(b_firing_intensify == true) {
+          if(firingState.intensify == true) {
             switch(getSystemYearMode()) {
               case SYSTEM_1984:
                 playEffect(S_GB1_1984_FIRE_START_SHORT, false, i_volume_effects, false, 0, false);
@@ -3009,13 +3039,13 @@ void modeFireStartSounds() {
               break;
             }
 
-            b_sound_firing_intensify_trigger = true;
+            firingState.soundIntensifyTrigger = true;
           }
           else {
-            b_sound_firing_intensify_trigger = false;
+            firingState.soundIntensifyTrigger = false;
           }
 
-          if(b_firing_alt == true) {
+          if(firingState.alt == true) {
             if(getSystemYearMode() == SYSTEM_1989) {
               playEffect(S_GB2_FIRE_START, false, i_volume_effects, false, 0, false);
               playEffect(S_FIRING_LOOP_GB1, true, i_volume_effects, true, 6500, false);
@@ -3029,10 +3059,10 @@ void modeFireStartSounds() {
               playEffect(S_FIRING_LOOP_GB1, true, i_volume_effects, true, 300, false);
             }
 
-            b_sound_firing_alt_trigger = true;
+            firingState.soundAltTrigger = true;
           }
           else {
-            b_sound_firing_alt_trigger = false;
+            firingState.soundAltTrigger = false;
           }
         break;
 
@@ -3056,9 +3086,9 @@ void modeFireStartSounds() {
             break;
           }
 
-          if(b_firing_intensify == true) {
+          if(firingState.intensify == true) {
             // Reset some sound triggers.
-            b_sound_firing_intensify_trigger = true;
+            firingState.soundIntensifyTrigger = true;
             if(getSystemYearMode() == SYSTEM_1984) {
               playEffect(S_GB1_1984_FIRE_HIGH_POWER_LOOP, true, i_volume_effects, true, 1700, false);
             }
@@ -3070,12 +3100,12 @@ void modeFireStartSounds() {
             }
           }
           else {
-            b_sound_firing_intensify_trigger = false;
+            firingState.soundIntensifyTrigger = false;
           }
 
-          if(b_firing_alt == true) {
+          if(firingState.alt == true) {
             // Reset some sound triggers.
-            b_sound_firing_alt_trigger = true;
+            firingState.soundAltTrigger = true;
             if(getSystemYearMode() == SYSTEM_1989) {
               playEffect(S_FIRING_LOOP_GB1, true, i_volume_effects, true, 700, false);
             }
@@ -3087,7 +3117,7 @@ void modeFireStartSounds() {
             }
           }
           else {
-            b_sound_firing_alt_trigger = false;
+            firingState.soundAltTrigger = false;
           }
         break;
       }
@@ -3149,7 +3179,7 @@ void modeFireStart() {
   modeFireStartSounds();
 
   // Tell the pack the wand is firing, and if in Intensify (1) or Alt (2) mode.
-  wandSerialSend(W_FIRING, b_firing_intensify ? 1 : 2);
+  wandSerialSend(W_FIRING, firingState.intensify ? 1 : 2);
 
   // Just in case a semi-auto was fired before we started firing a stream, stop its timer.
   ms_semi_automatic_firing.stop();
@@ -3179,7 +3209,7 @@ void modeFireStart() {
   // This will only overheat when enabled by using the alt firing when in crossing the streams mode.
   bool b_overheat_flag = true;
 
-  if(((FIRING_MODE == CTS_MODE || FIRING_MODE == CTS_MIX_MODE) && b_firing_alt != true) || !b_overheat_enabled) {
+  if(((FIRING_MODE == CTS_MODE || FIRING_MODE == CTS_MIX_MODE) && firingState.alt != true) || !b_overheat_enabled) {
     b_overheat_flag = false;
   }
 
@@ -3225,9 +3255,9 @@ void modeFireStart() {
 
 void modeFireStopSounds() {
   // Reset some sound triggers.
-  b_sound_firing_intensify_trigger = false;
-  b_sound_firing_alt_trigger = false;
-  b_sound_firing_cross_the_streams = false;
+  firingState.soundIntensifyTrigger = false;
+  firingState.soundAltTrigger = false;
+  firingState.soundCrossTheStreams = false;
 
   ms_meson_blast.stop();
 
@@ -3399,7 +3429,7 @@ void modeFireStopSounds() {
     break;
   }
 
-  if(b_firing_cross_streams == true) {
+  if(firingState.crossStreams == true) {
     switch(WAND_YEAR_CTS) {
       case CTS_AFTERLIFE:
         if(AUDIO_DEVICE == A_WAV_TRIGGER) {
@@ -3446,7 +3476,7 @@ void modeFireStopSounds() {
       break;
     }
 
-    b_firing_cross_streams = false;
+    firingState.crossStreams = false;
   }
 }
 
@@ -3458,9 +3488,9 @@ void modeFireStop() {
 
   WAND_ACTION_STATUS = ACTION_IDLE;
 
-  b_firing = false;
-  b_firing_intensify = false;
-  b_firing_alt = false;
+  firingState.firing = false;
+  firingState.intensify = false;
+  firingState.alt = false;
 
   ms_bargraph_firing.stop();
 
@@ -3534,8 +3564,8 @@ void modeFireStop() {
 
 void modeFiring() {
   // Sound trigger flags.
-  if(b_firing_intensify == true && b_sound_firing_intensify_trigger != true) {
-    b_sound_firing_intensify_trigger = true;
+  if(firingState.intensify == true && firingState.soundIntensifyTrigger != true) {
+    firingState.soundIntensifyTrigger = true;
 
     if(FIRING_MODE == CTS_MIX_MODE && STREAM_MODE == PROTON) {
       // Tell the Proton Pack that the Neutrona Wand is firing in Intensify mode mix.
@@ -3550,8 +3580,8 @@ void modeFiring() {
     }
   }
 
-  if(b_firing_intensify != true && b_sound_firing_intensify_trigger == true) {
-    b_sound_firing_intensify_trigger = false;
+  if(firingState.intensify != true && firingState.soundIntensifyTrigger == true) {
+    firingState.soundIntensifyTrigger = false;
 
     if(FIRING_MODE == CTS_MIX_MODE && STREAM_MODE == PROTON) {
       // Tell the Proton Pack that the Neutrona Wand is no longer firing in Intensify mode mix.
@@ -3566,8 +3596,8 @@ void modeFiring() {
     }
   }
 
-  if(b_firing_alt == true && b_sound_firing_alt_trigger != true) {
-    b_sound_firing_alt_trigger = true;
+  if(firingState.alt == true && firingState.soundAltTrigger != true) {
+    firingState.soundAltTrigger = true;
 
     if(FIRING_MODE == CTS_MIX_MODE && STREAM_MODE == PROTON) {
       // Tell the Proton Pack that the Neutrona Wand is firing in Alt mode mix.
@@ -3593,8 +3623,8 @@ void modeFiring() {
     }
   }
 
-  if(b_firing_alt != true && b_sound_firing_alt_trigger == true) {
-    b_sound_firing_alt_trigger = false;
+  if(firingState.alt != true && firingState.soundAltTrigger == true) {
+    firingState.soundAltTrigger = false;
 
     if(FIRING_MODE == CTS_MIX_MODE && STREAM_MODE == PROTON) {
       // Tell the Proton Pack that the Neutrona Wand is no longer firing in Alt mode mix.
@@ -3620,9 +3650,9 @@ void modeFiring() {
     }
   }
 
-  if(b_firing_alt == true && b_firing_intensify == true && b_sound_firing_cross_the_streams != true && b_firing_cross_streams != true) {
-    b_firing_cross_streams = true;
-    b_sound_firing_cross_the_streams = true;
+  if(firingState.alt == true && firingState.intensify == true && firingState.soundCrossTheStreams != true && firingState.crossStreams != true) {
+    firingState.crossStreams = true;
+    firingState.soundCrossTheStreams = true;
 
     switch(WAND_YEAR_CTS) {
       case CTS_AFTERLIFE:
@@ -3711,10 +3741,10 @@ void modeFiring() {
     }
   }
 
-  if((b_firing_alt != true || b_firing_intensify != true) && b_firing_cross_streams == true && FIRING_MODE == CTS_MIX_MODE) {
+  if((firingState.alt != true || firingState.intensify != true) && firingState.crossStreams == true && FIRING_MODE == CTS_MIX_MODE) {
     // In CTS Mix mode, you can release either Intensify or the Barrel Wing Button and firing will revert to the mode for the still-held button.
-    b_firing_cross_streams = false;
-    b_sound_firing_cross_the_streams = false;
+    firingState.crossStreams = false;
+    firingState.soundCrossTheStreams = false;
 
     switch(WAND_YEAR_CTS) {
       case CTS_AFTERLIFE:
@@ -3779,7 +3809,7 @@ void modeFiring() {
   // Overheat timers.
   bool b_overheat_flag = true;
 
-  if(((FIRING_MODE == CTS_MODE || FIRING_MODE == CTS_MIX_MODE) && b_firing_alt != true) || !b_overheat_enabled) {
+  if(((FIRING_MODE == CTS_MODE || FIRING_MODE == CTS_MIX_MODE) && firingState.alt != true) || !b_overheat_enabled) {
     b_overheat_flag = false;
   }
 
@@ -3816,7 +3846,7 @@ void modeFiring() {
   switch(STREAM_MODE) {
     case PROTON:
     default:
-      if(b_firing_cross_streams == true) {
+      if(firingState.crossStreams == true) {
         if(getSystemYearMode() == SYSTEM_FROZEN_EMPIRE && !b_pack_cyclotron_lid_on) {
           c_temp_start = C_CHARTREUSE;
           c_temp_effect = C_ORANGE;
@@ -3948,13 +3978,13 @@ void modeFiring() {
   }
 
   // Mix some impact sound every 10-15 seconds while firing.
-  if(ms_impact.justFinished() && STREAM_MODE == PROTON && b_firing_cross_streams != true && b_stream_effects == true) {
+  if(ms_impact.justFinished() && STREAM_MODE == PROTON && firingState.crossStreams != true && b_stream_effects == true) {
     playEffect(S_FIRE_LOOP_IMPACT, false, i_volume_effects, false, 0, false);
     ms_impact.start(random(10,16) * 1000);
   }
 
   // Standalone Neutrona Wand gets additional impact sounds which would normally be played by Proton Pack.
-  if(ms_firing_sound_mix.justFinished() && STREAM_MODE == PROTON && b_firing_cross_streams != true && b_stream_effects == true && b_gpstar_benchtest == true) {
+  if(ms_firing_sound_mix.justFinished() && STREAM_MODE == PROTON && firingState.crossStreams != true && b_stream_effects == true && b_gpstar_benchtest == true) {
     uint8_t i_random = 0;
 
     switch(i_last_firing_effect_mix) {
@@ -4968,7 +4998,7 @@ void fireStreamEffect(CRGB c_colour) {
           switch(STREAM_MODE) {
             case PROTON:
             default:
-              if(b_firing_cross_streams == true) {
+              if(firingState.crossStreams == true) {
                 if(getSystemYearMode() == SYSTEM_FROZEN_EMPIRE && !b_pack_cyclotron_lid_on) {
                   barrel_leds[PROGMEM_READU8(gpstar_neutrona_barrel[i_barrel_light - 1])] = getHueColour(C_CHARTREUSE, WAND_BARREL_LED_COUNT);
                   //barrel_leds[PROGMEM_READU8(gpstar_neutrona_barrel[i_barrel_light - 2])] = c_colour;
@@ -5298,7 +5328,7 @@ void fireStreamEffect(CRGB c_colour) {
           switch(STREAM_MODE) {
             case PROTON:
             default:
-              if(b_firing_cross_streams == true) {
+              if(firingState.crossStreams == true) {
                 if(getSystemYearMode() == SYSTEM_FROZEN_EMPIRE && !b_pack_cyclotron_lid_on) {
                   barrel_leds[PROGMEM_READU8(frutto_barrel[i_barrel_light - 1])] = getHueColour(C_CHARTREUSE, WAND_BARREL_LED_COUNT);
                   //barrel_leds[PROGMEM_READU8(frutto_barrel[i_barrel_light - 2])] = c_colour;
@@ -5626,7 +5656,7 @@ void fireStreamEffect(CRGB c_colour) {
           switch(STREAM_MODE) {
             case PROTON:
             default:
-              if(b_firing_cross_streams == true) {
+              if(firingState.crossStreams == true) {
                 if(getSystemYearMode() == SYSTEM_FROZEN_EMPIRE && !b_pack_cyclotron_lid_on) {
                   barrel_leds[i_barrel_light - 1] = getHueColour(C_CHARTREUSE, WAND_BARREL_LED_COUNT);
                 }
@@ -5879,7 +5909,7 @@ void fireEffectEnd() {
     switch(STREAM_MODE) {
       case PROTON:
       default:
-        if(b_firing_cross_streams == true) {
+        if(firingState.crossStreams == true) {
           if(getSystemYearMode() == SYSTEM_FROZEN_EMPIRE && !b_pack_cyclotron_lid_on) {
             c_temp = C_ORANGE;
           }
@@ -6087,7 +6117,7 @@ void fireEffectEnd() {
     switch(STREAM_MODE) {
       case PROTON:
       default:
-        if(b_firing_cross_streams == true) {
+        if(firingState.crossStreams == true) {
           if(getSystemYearMode() == SYSTEM_FROZEN_EMPIRE && !b_pack_cyclotron_lid_on) {
             c_temp = C_CHARTREUSE;
           }
@@ -6255,8 +6285,8 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(14));
           ht_bargraph.setLed(bargraphLookupTable(15));
 
-          b_bargraph_status[14] = true;
-          b_bargraph_status[15] = true;
+          b_bargraph_status.set(14, true);
+          b_bargraph_status.set(15, true);
 
           i_bargraph_status_alt++;
 
@@ -6264,8 +6294,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(13));
             ht_bargraph.clearLed(bargraphLookupTable(16));
 
-            b_bargraph_status[13] = false;
-            b_bargraph_status[16] = false;
+            b_bargraph_status.set(13, false);
+            b_bargraph_status.set(16, false);
           }
 
           b_bargraph_up = true;
@@ -6280,15 +6310,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(13));
           ht_bargraph.setLed(bargraphLookupTable(16));
 
-          b_bargraph_status[13] = true;
-          b_bargraph_status[16] = true;
+          b_bargraph_status.set(13, true);
+          b_bargraph_status.set(16, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(14));
             ht_bargraph.clearLed(bargraphLookupTable(15));
 
-            b_bargraph_status[14] = false;
-            b_bargraph_status[15] = false;
+            b_bargraph_status.set(14, false);
+            b_bargraph_status.set(15, false);
 
             i_bargraph_status_alt++;
           }
@@ -6296,8 +6326,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(12));
             ht_bargraph.clearLed(bargraphLookupTable(17));
 
-            b_bargraph_status[12] = false;
-            b_bargraph_status[17] = false;
+            b_bargraph_status.set(12, false);
+            b_bargraph_status.set(17, false);
 
             i_bargraph_status_alt--;
           }
@@ -6312,15 +6342,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(12));
           ht_bargraph.setLed(bargraphLookupTable(17));
 
-          b_bargraph_status[12] = true;
-          b_bargraph_status[17] = true;
+          b_bargraph_status.set(12, true);
+          b_bargraph_status.set(17, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(13));
             ht_bargraph.clearLed(bargraphLookupTable(16));
 
-            b_bargraph_status[13] = false;
-            b_bargraph_status[16] = false;
+            b_bargraph_status.set(13, false);
+            b_bargraph_status.set(16, false);
 
             i_bargraph_status_alt++;
           }
@@ -6328,8 +6358,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(11));
             ht_bargraph.clearLed(bargraphLookupTable(18));
 
-            b_bargraph_status[11] = false;
-            b_bargraph_status[18] = false;
+            b_bargraph_status.set(11, false);
+            b_bargraph_status.set(18, false);
 
             i_bargraph_status_alt--;
           }
@@ -6344,15 +6374,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(11));
           ht_bargraph.setLed(bargraphLookupTable(18));
 
-          b_bargraph_status[11] = true;
-          b_bargraph_status[18] = true;
+          b_bargraph_status.set(11, true);
+          b_bargraph_status.set(18, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(12));
             ht_bargraph.clearLed(bargraphLookupTable(17));
 
-            b_bargraph_status[12] = false;
-            b_bargraph_status[17] = false;
+            b_bargraph_status.set(12, false);
+            b_bargraph_status.set(17, false);
 
             i_bargraph_status_alt++;
           }
@@ -6360,8 +6390,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(10));
             ht_bargraph.clearLed(bargraphLookupTable(19));
 
-            b_bargraph_status[10] = false;
-            b_bargraph_status[19] = false;
+            b_bargraph_status.set(10, false);
+            b_bargraph_status.set(19, false);
 
             i_bargraph_status_alt--;
           }
@@ -6376,15 +6406,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(10));
           ht_bargraph.setLed(bargraphLookupTable(19));
 
-          b_bargraph_status[10] = true;
-          b_bargraph_status[19] = true;
+          b_bargraph_status.set(10, true);
+          b_bargraph_status.set(19, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(11));
             ht_bargraph.clearLed(bargraphLookupTable(18));
 
-            b_bargraph_status[11] = false;
-            b_bargraph_status[18] = false;
+            b_bargraph_status.set(11, false);
+            b_bargraph_status.set(18, false);
 
             i_bargraph_status_alt++;
           }
@@ -6392,8 +6422,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(9));
             ht_bargraph.clearLed(bargraphLookupTable(20));
 
-            b_bargraph_status[9] = false;
-            b_bargraph_status[20] = false;
+            b_bargraph_status.set(9, false);
+            b_bargraph_status.set(20, false);
 
             i_bargraph_status_alt--;
           }
@@ -6408,15 +6438,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(9));
           ht_bargraph.setLed(bargraphLookupTable(20));
 
-          b_bargraph_status[9] = true;
-          b_bargraph_status[20] = true;
+          b_bargraph_status.set(9, true);
+          b_bargraph_status.set(20, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(10));
             ht_bargraph.clearLed(bargraphLookupTable(19));
 
-            b_bargraph_status[10] = false;
-            b_bargraph_status[19] = false;
+            b_bargraph_status.set(10, false);
+            b_bargraph_status.set(19, false);
 
             i_bargraph_status_alt++;
           }
@@ -6424,8 +6454,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(8));
             ht_bargraph.clearLed(bargraphLookupTable(21));
 
-            b_bargraph_status[8] = false;
-            b_bargraph_status[21] = false;
+            b_bargraph_status.set(8, false);
+            b_bargraph_status.set(21, false);
 
             i_bargraph_status_alt--;
           }
@@ -6440,15 +6470,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(8));
           ht_bargraph.setLed(bargraphLookupTable(21));
 
-          b_bargraph_status[8] = true;
-          b_bargraph_status[21] = true;
+          b_bargraph_status.set(8, true);
+          b_bargraph_status.set(21, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(9));
             ht_bargraph.clearLed(bargraphLookupTable(20));
 
-            b_bargraph_status[9] = false;
-            b_bargraph_status[20] = false;
+            b_bargraph_status.set(9, false);
+            b_bargraph_status.set(20, false);
 
             i_bargraph_status_alt++;
           }
@@ -6456,8 +6486,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(7));
             ht_bargraph.clearLed(bargraphLookupTable(22));
 
-            b_bargraph_status[7] = false;
-            b_bargraph_status[22] = false;
+            b_bargraph_status.set(7, false);
+            b_bargraph_status.set(22, false);
 
             i_bargraph_status_alt--;
           }
@@ -6472,15 +6502,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(7));
           ht_bargraph.setLed(bargraphLookupTable(22));
 
-          b_bargraph_status[7] = true;
-          b_bargraph_status[22] = true;
+          b_bargraph_status.set(7, true);
+          b_bargraph_status.set(22, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(8));
             ht_bargraph.clearLed(bargraphLookupTable(21));
 
-            b_bargraph_status[8] = false;
-            b_bargraph_status[21] = false;
+            b_bargraph_status.set(8, false);
+            b_bargraph_status.set(21, false);
 
             i_bargraph_status_alt++;
           }
@@ -6488,8 +6518,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(6));
             ht_bargraph.clearLed(bargraphLookupTable(23));
 
-            b_bargraph_status[6] = false;
-            b_bargraph_status[23] = false;
+            b_bargraph_status.set(6, false);
+            b_bargraph_status.set(23, false);
 
             i_bargraph_status_alt--;
           }
@@ -6504,15 +6534,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(6));
           ht_bargraph.setLed(bargraphLookupTable(23));
 
-          b_bargraph_status[6] = true;
-          b_bargraph_status[23] = true;
+          b_bargraph_status.set(6, true);
+          b_bargraph_status.set(23, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(7));
             ht_bargraph.clearLed(bargraphLookupTable(22));
 
-            b_bargraph_status[7] = false;
-            b_bargraph_status[22] = false;
+            b_bargraph_status.set(7, false);
+            b_bargraph_status.set(22, false);
 
             i_bargraph_status_alt++;
           }
@@ -6520,8 +6550,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(5));
             ht_bargraph.clearLed(bargraphLookupTable(24));
 
-            b_bargraph_status[5] = false;
-            b_bargraph_status[24] = false;
+            b_bargraph_status.set(5, false);
+            b_bargraph_status.set(24, false);
 
             i_bargraph_status_alt--;
           }
@@ -6536,15 +6566,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(5));
           ht_bargraph.setLed(bargraphLookupTable(24));
 
-          b_bargraph_status[5] = true;
-          b_bargraph_status[24] = true;
+          b_bargraph_status.set(5, true);
+          b_bargraph_status.set(24, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(6));
             ht_bargraph.clearLed(bargraphLookupTable(23));
 
-            b_bargraph_status[6] = false;
-            b_bargraph_status[23] = false;
+            b_bargraph_status.set(6, false);
+            b_bargraph_status.set(23, false);
 
             i_bargraph_status_alt++;
           }
@@ -6552,8 +6582,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(4));
             ht_bargraph.clearLed(bargraphLookupTable(25));
 
-            b_bargraph_status[4] = false;
-            b_bargraph_status[25] = false;
+            b_bargraph_status.set(4, false);
+            b_bargraph_status.set(25, false);
 
             i_bargraph_status_alt--;
           }
@@ -6568,15 +6598,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(4));
           ht_bargraph.setLed(bargraphLookupTable(25));
 
-          b_bargraph_status[4] = true;
-          b_bargraph_status[25] = true;
+          b_bargraph_status.set(4, true);
+          b_bargraph_status.set(25, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(5));
             ht_bargraph.clearLed(bargraphLookupTable(24));
 
-            b_bargraph_status[5] = false;
-            b_bargraph_status[24] = false;
+            b_bargraph_status.set(5, false);
+            b_bargraph_status.set(24, false);
 
             i_bargraph_status_alt++;
           }
@@ -6584,8 +6614,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(3));
             ht_bargraph.clearLed(bargraphLookupTable(26));
 
-            b_bargraph_status[3] = false;
-            b_bargraph_status[26] = false;
+            b_bargraph_status.set(3, false);
+            b_bargraph_status.set(26, false);
 
             i_bargraph_status_alt--;
           }
@@ -6600,15 +6630,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(3));
           ht_bargraph.setLed(bargraphLookupTable(26));
 
-          b_bargraph_status[3] = true;
-          b_bargraph_status[26] = true;
+          b_bargraph_status.set(3, true);
+          b_bargraph_status.set(26, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(4));
             ht_bargraph.clearLed(bargraphLookupTable(25));
 
-            b_bargraph_status[4] = false;
-            b_bargraph_status[25] = false;
+            b_bargraph_status.set(4, false);
+            b_bargraph_status.set(25, false);
 
             i_bargraph_status_alt++;
           }
@@ -6616,8 +6646,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(2));
             ht_bargraph.clearLed(bargraphLookupTable(27));
 
-            b_bargraph_status[2] = false;
-            b_bargraph_status[27] = false;
+            b_bargraph_status.set(2, false);
+            b_bargraph_status.set(27, false);
 
             i_bargraph_status_alt--;
           }
@@ -6632,15 +6662,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(2));
           ht_bargraph.setLed(bargraphLookupTable(27));
 
-          b_bargraph_status[2] = false;
-          b_bargraph_status[27] = false;
+          b_bargraph_status.set(2, false);
+          b_bargraph_status.set(27, false);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(3));
             ht_bargraph.clearLed(bargraphLookupTable(26));
 
-            b_bargraph_status[3] = false;
-            b_bargraph_status[26] = false;
+            b_bargraph_status.set(3, false);
+            b_bargraph_status.set(26, false);
 
             i_bargraph_status_alt++;
           }
@@ -6648,8 +6678,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(1));
             ht_bargraph.clearLed(bargraphLookupTable(28));
 
-            b_bargraph_status[1] = false;
-            b_bargraph_status[28] = false;
+            b_bargraph_status.set(1, false);
+            b_bargraph_status.set(28, false);
 
             i_bargraph_status_alt--;
           }
@@ -6664,15 +6694,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(1));
           ht_bargraph.setLed(bargraphLookupTable(28));
 
-          b_bargraph_status[1] = true;
-          b_bargraph_status[28] = true;
+          b_bargraph_status.set(1, true);
+          b_bargraph_status.set(28, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(2));
             ht_bargraph.clearLed(bargraphLookupTable(27));
 
-            b_bargraph_status[2] = false;
-            b_bargraph_status[27] = false;
+            b_bargraph_status.set(2, false);
+            b_bargraph_status.set(27, false);
 
             i_bargraph_status_alt++;
           }
@@ -6680,8 +6710,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(0));
             ht_bargraph.clearLed(bargraphLookupTable(29));
 
-            b_bargraph_status[0] = false;
-            b_bargraph_status[29] = false;
+            b_bargraph_status.set(0, false);
+            b_bargraph_status.set(29, false);
 
             i_bargraph_status_alt--;
           }
@@ -6696,14 +6726,14 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(0));
           ht_bargraph.setLed(bargraphLookupTable(29));
 
-          b_bargraph_status[0] = true;
-          b_bargraph_status[29] = true;
+          b_bargraph_status.set(0, true);
+          b_bargraph_status.set(29, true);
 
           ht_bargraph.clearLed(bargraphLookupTable(1));
           ht_bargraph.clearLed(bargraphLookupTable(28));
 
-          b_bargraph_status[1] = false;
-          b_bargraph_status[28] = false;
+          b_bargraph_status.set(1, false);
+          b_bargraph_status.set(28, false);
 
           i_bargraph_status_alt--;
 
@@ -6726,8 +6756,8 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(13));
           ht_bargraph.setLed(bargraphLookupTable(14));
 
-          b_bargraph_status[13] = true;
-          b_bargraph_status[14] = true;
+          b_bargraph_status.set(13, true);
+          b_bargraph_status.set(14, true);
 
           i_bargraph_status_alt++;
 
@@ -6735,8 +6765,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(12));
             ht_bargraph.clearLed(bargraphLookupTable(15));
 
-            b_bargraph_status[12] = false;
-            b_bargraph_status[15] = false;
+            b_bargraph_status.set(12, false);
+            b_bargraph_status.set(15, false);
           }
 
           b_bargraph_up = true;
@@ -6751,15 +6781,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(12));
           ht_bargraph.setLed(bargraphLookupTable(15));
 
-          b_bargraph_status[12] = true;
-          b_bargraph_status[15] = true;
+          b_bargraph_status.set(12, true);
+          b_bargraph_status.set(15, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(13));
             ht_bargraph.clearLed(bargraphLookupTable(14));
 
-            b_bargraph_status[13] = false;
-            b_bargraph_status[14] = false;
+            b_bargraph_status.set(13, false);
+            b_bargraph_status.set(14, false);
 
             i_bargraph_status_alt++;
           }
@@ -6767,8 +6797,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(11));
             ht_bargraph.clearLed(bargraphLookupTable(16));
 
-            b_bargraph_status[11] = false;
-            b_bargraph_status[16] = false;
+            b_bargraph_status.set(11, false);
+            b_bargraph_status.set(16, false);
 
             i_bargraph_status_alt--;
           }
@@ -6783,15 +6813,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(11));
           ht_bargraph.setLed(bargraphLookupTable(16));
 
-          b_bargraph_status[11] = true;
-          b_bargraph_status[16] = true;
+          b_bargraph_status.set(11, true);
+          b_bargraph_status.set(16, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(12));
             ht_bargraph.clearLed(bargraphLookupTable(15));
 
-            b_bargraph_status[12] = false;
-            b_bargraph_status[15] = false;
+            b_bargraph_status.set(12, false);
+            b_bargraph_status.set(15, false);
 
             i_bargraph_status_alt++;
           }
@@ -6799,8 +6829,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(10));
             ht_bargraph.clearLed(bargraphLookupTable(17));
 
-            b_bargraph_status[10] = false;
-            b_bargraph_status[17] = false;
+            b_bargraph_status.set(10, false);
+            b_bargraph_status.set(17, false);
 
             i_bargraph_status_alt--;
           }
@@ -6815,15 +6845,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(10));
           ht_bargraph.setLed(bargraphLookupTable(17));
 
-          b_bargraph_status[10] = true;
-          b_bargraph_status[17] = true;
+          b_bargraph_status.set(10, true);
+          b_bargraph_status.set(17, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(11));
             ht_bargraph.clearLed(bargraphLookupTable(16));
 
-            b_bargraph_status[11] = false;
-            b_bargraph_status[16] = false;
+            b_bargraph_status.set(11, false);
+            b_bargraph_status.set(16, false);
 
             i_bargraph_status_alt++;
           }
@@ -6831,8 +6861,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(9));
             ht_bargraph.clearLed(bargraphLookupTable(18));
 
-            b_bargraph_status[9] = false;
-            b_bargraph_status[18] = false;
+            b_bargraph_status.set(9, false);
+            b_bargraph_status.set(18, false);
 
             i_bargraph_status_alt--;
           }
@@ -6847,15 +6877,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(9));
           ht_bargraph.setLed(bargraphLookupTable(18));
 
-          b_bargraph_status[9] = true;
-          b_bargraph_status[18] = true;
+          b_bargraph_status.set(9, true);
+          b_bargraph_status.set(18, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(10));
             ht_bargraph.clearLed(bargraphLookupTable(17));
 
-            b_bargraph_status[10] = false;
-            b_bargraph_status[17] = false;
+            b_bargraph_status.set(10, false);
+            b_bargraph_status.set(17, false);
 
             i_bargraph_status_alt++;
           }
@@ -6863,8 +6893,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(8));
             ht_bargraph.clearLed(bargraphLookupTable(19));
 
-            b_bargraph_status[8] = false;
-            b_bargraph_status[19] = false;
+            b_bargraph_status.set(8, false);
+            b_bargraph_status.set(19, false);
 
             i_bargraph_status_alt--;
           }
@@ -6879,15 +6909,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(8));
           ht_bargraph.setLed(bargraphLookupTable(19));
 
-          b_bargraph_status[8] = true;
-          b_bargraph_status[19] = true;
+          b_bargraph_status.set(8, true);
+          b_bargraph_status.set(19, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(9));
             ht_bargraph.clearLed(bargraphLookupTable(18));
 
-            b_bargraph_status[9] = false;
-            b_bargraph_status[18] = false;
+            b_bargraph_status.set(9, false);
+            b_bargraph_status.set(18, false);
 
             i_bargraph_status_alt++;
           }
@@ -6895,8 +6925,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(7));
             ht_bargraph.clearLed(bargraphLookupTable(20));
 
-            b_bargraph_status[7] = false;
-            b_bargraph_status[20] = false;
+            b_bargraph_status.set(7, false);
+            b_bargraph_status.set(20, false);
 
             i_bargraph_status_alt--;
           }
@@ -6911,15 +6941,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(7));
           ht_bargraph.setLed(bargraphLookupTable(20));
 
-          b_bargraph_status[7] = true;
-          b_bargraph_status[20] = true;
+          b_bargraph_status.set(7, true);
+          b_bargraph_status.set(20, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(8));
             ht_bargraph.clearLed(bargraphLookupTable(19));
 
-            b_bargraph_status[8] = false;
-            b_bargraph_status[19] = false;
+            b_bargraph_status.set(8, false);
+            b_bargraph_status.set(19, false);
 
             i_bargraph_status_alt++;
           }
@@ -6927,8 +6957,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(6));
             ht_bargraph.clearLed(bargraphLookupTable(21));
 
-            b_bargraph_status[6] = false;
-            b_bargraph_status[21] = false;
+            b_bargraph_status.set(6, false);
+            b_bargraph_status.set(21, false);
 
             i_bargraph_status_alt--;
           }
@@ -6943,15 +6973,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(6));
           ht_bargraph.setLed(bargraphLookupTable(21));
 
-          b_bargraph_status[6] = true;
-          b_bargraph_status[21] = true;
+          b_bargraph_status.set(6, true);
+          b_bargraph_status.set(21, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(7));
             ht_bargraph.clearLed(bargraphLookupTable(20));
 
-            b_bargraph_status[7] = false;
-            b_bargraph_status[20] = false;
+            b_bargraph_status.set(7, false);
+            b_bargraph_status.set(20, false);
 
             i_bargraph_status_alt++;
           }
@@ -6959,8 +6989,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(5));
             ht_bargraph.clearLed(bargraphLookupTable(22));
 
-            b_bargraph_status[5] = false;
-            b_bargraph_status[22] = false;
+            b_bargraph_status.set(5, false);
+            b_bargraph_status.set(22, false);
 
             i_bargraph_status_alt--;
           }
@@ -6975,15 +7005,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(5));
           ht_bargraph.setLed(bargraphLookupTable(22));
 
-          b_bargraph_status[5] = true;
-          b_bargraph_status[22] = true;
+          b_bargraph_status.set(5, true);
+          b_bargraph_status.set(22, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(6));
             ht_bargraph.clearLed(bargraphLookupTable(21));
 
-            b_bargraph_status[6] = false;
-            b_bargraph_status[21] = false;
+            b_bargraph_status.set(6, false);
+            b_bargraph_status.set(21, false);
 
             i_bargraph_status_alt++;
           }
@@ -6991,8 +7021,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(4));
             ht_bargraph.clearLed(bargraphLookupTable(23));
 
-            b_bargraph_status[4] = false;
-            b_bargraph_status[23] = false;
+            b_bargraph_status.set(4, false);
+            b_bargraph_status.set(23, false);
 
             i_bargraph_status_alt--;
           }
@@ -7007,15 +7037,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(4));
           ht_bargraph.setLed(bargraphLookupTable(23));
 
-          b_bargraph_status[4] = true;
-          b_bargraph_status[23] = true;
+          b_bargraph_status.set(4, true);
+          b_bargraph_status.set(23, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(5));
             ht_bargraph.clearLed(bargraphLookupTable(22));
 
-            b_bargraph_status[5] = false;
-            b_bargraph_status[22] = false;
+            b_bargraph_status.set(5, false);
+            b_bargraph_status.set(22, false);
 
             i_bargraph_status_alt++;
           }
@@ -7023,8 +7053,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(3));
             ht_bargraph.clearLed(bargraphLookupTable(24));
 
-            b_bargraph_status[3] = false;
-            b_bargraph_status[24] = false;
+            b_bargraph_status.set(3, false);
+            b_bargraph_status.set(24, false);
 
             i_bargraph_status_alt--;
           }
@@ -7039,15 +7069,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(3));
           ht_bargraph.setLed(bargraphLookupTable(24));
 
-          b_bargraph_status[3] = true;
-          b_bargraph_status[24] = true;
+          b_bargraph_status.set(3, true);
+          b_bargraph_status.set(24, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(4));
             ht_bargraph.clearLed(bargraphLookupTable(23));
 
-            b_bargraph_status[4] = false;
-            b_bargraph_status[23] = false;
+            b_bargraph_status.set(4, false);
+            b_bargraph_status.set(23, false);
 
             i_bargraph_status_alt++;
           }
@@ -7055,8 +7085,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(2));
             ht_bargraph.clearLed(bargraphLookupTable(25));
 
-            b_bargraph_status[2] = false;
-            b_bargraph_status[25] = false;
+            b_bargraph_status.set(2, false);
+            b_bargraph_status.set(25, false);
 
             i_bargraph_status_alt--;
           }
@@ -7071,15 +7101,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(2));
           ht_bargraph.setLed(bargraphLookupTable(25));
 
-          b_bargraph_status[2] = false;
-          b_bargraph_status[25] = false;
+          b_bargraph_status.set(2, false);
+          b_bargraph_status.set(25, false);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(3));
             ht_bargraph.clearLed(bargraphLookupTable(24));
 
-            b_bargraph_status[3] = false;
-            b_bargraph_status[24] = false;
+            b_bargraph_status.set(3, false);
+            b_bargraph_status.set(24, false);
 
             i_bargraph_status_alt++;
           }
@@ -7087,8 +7117,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(1));
             ht_bargraph.clearLed(bargraphLookupTable(26));
 
-            b_bargraph_status[1] = false;
-            b_bargraph_status[26] = false;
+            b_bargraph_status.set(1, false);
+            b_bargraph_status.set(26, false);
 
             i_bargraph_status_alt--;
           }
@@ -7103,15 +7133,15 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(1));
           ht_bargraph.setLed(bargraphLookupTable(26));
 
-          b_bargraph_status[1] = true;
-          b_bargraph_status[26] = true;
+          b_bargraph_status.set(1, true);
+          b_bargraph_status.set(26, true);
 
           if(b_bargraph_up == true) {
             ht_bargraph.clearLed(bargraphLookupTable(2));
             ht_bargraph.clearLed(bargraphLookupTable(25));
 
-            b_bargraph_status[2] = false;
-            b_bargraph_status[25] = false;
+            b_bargraph_status.set(2, false);
+            b_bargraph_status.set(25, false);
 
             i_bargraph_status_alt++;
           }
@@ -7119,8 +7149,8 @@ void bargraphSuperHeroRampFiringAnimation() {
             ht_bargraph.clearLed(bargraphLookupTable(0));
             ht_bargraph.clearLed(bargraphLookupTable(27));
 
-            b_bargraph_status[0] = false;
-            b_bargraph_status[27] = false;
+            b_bargraph_status.set(0, false);
+            b_bargraph_status.set(27, false);
 
             i_bargraph_status_alt--;
           }
@@ -7135,14 +7165,14 @@ void bargraphSuperHeroRampFiringAnimation() {
           ht_bargraph.setLed(bargraphLookupTable(0));
           ht_bargraph.setLed(bargraphLookupTable(27));
 
-          b_bargraph_status[0] = true;
-          b_bargraph_status[27] = true;
+          b_bargraph_status.set(0, true);
+          b_bargraph_status.set(27, true);
 
           ht_bargraph.clearLed(bargraphLookupTable(1));
           ht_bargraph.clearLed(bargraphLookupTable(26));
 
-          b_bargraph_status[1] = false;
-          b_bargraph_status[26] = false;
+          b_bargraph_status.set(1, false);
+          b_bargraph_status.set(26, false);
 
           i_bargraph_status_alt--;
 
@@ -7287,7 +7317,7 @@ void bargraphModeOriginalRampFiringAnimation() {
     bool b_tmp_down = true;
 
     for(uint8_t i = 0; i < i_bargraph_segments - i_segment_adjust; i++) {
-      if(b_bargraph_status[i] != true && i < i_bargraph_status_alt) {
+      if(b_bargraph_status.get(i) != true && i < i_bargraph_status_alt) {
         b_tmp_down = false;
         break;
       }
@@ -7323,9 +7353,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == true) {
+            if(b_bargraph_status.get(i) == true) {
               ht_bargraph.clearLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = false;
+              b_bargraph_status.set(i, false);
 
               break;
             }
@@ -7364,9 +7394,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == false) {
+            if(b_bargraph_status.get(i) == false) {
               ht_bargraph.setLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = true;
+              b_bargraph_status.set(i, true);
 
               break;
             }
@@ -7408,9 +7438,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == true) {
+            if(b_bargraph_status.get(i) == true) {
               ht_bargraph.clearLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = false;
+              b_bargraph_status.set(i, false);
 
               break;
             }
@@ -7449,9 +7479,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == false) {
+            if(b_bargraph_status.get(i) == false) {
               ht_bargraph.setLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = true;
+              b_bargraph_status.set(i, true);
 
               break;
             }
@@ -7493,9 +7523,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == true) {
+            if(b_bargraph_status.get(i) == true) {
               ht_bargraph.clearLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = false;
+              b_bargraph_status.set(i, false);
 
               break;
             }
@@ -7534,9 +7564,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == false) {
+            if(b_bargraph_status.get(i) == false) {
               ht_bargraph.setLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = true;
+              b_bargraph_status.set(i, true);
 
               break;
             }
@@ -7572,9 +7602,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == true) {
+            if(b_bargraph_status.get(i) == true) {
               ht_bargraph.clearLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = false;
+              b_bargraph_status.set(i, false);
 
               break;
             }
@@ -7607,9 +7637,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == false) {
+            if(b_bargraph_status.get(i) == false) {
               ht_bargraph.setLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = true;
+              b_bargraph_status.set(i, true);
 
               break;
             }
@@ -7646,9 +7676,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == true) {
+            if(b_bargraph_status.get(i) == true) {
               ht_bargraph.clearLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = false;
+              b_bargraph_status.set(i, false);
 
               break;
             }
@@ -7681,9 +7711,9 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status[i] == false) {
+            if(b_bargraph_status.get(i) == false) {
               ht_bargraph.setLed(bargraphLookupTable(i));
-              b_bargraph_status[i] = true;
+              b_bargraph_status.set(i, true);
 
               break;
             }
@@ -7735,7 +7765,7 @@ void bargraphModeOriginalRampFiringAnimation() {
     bool b_tmp_down = true;
 
     for(uint8_t i = 0; i < i_bargraph_segments_5_led; i++) {
-      if(b_bargraph_status_5[i] != true && i <= i_bargraph_status) {
+      if(b_bargraph_status_5.get(i) != true && i <= i_bargraph_status) {
         b_tmp_down = false;
         break;
       }
@@ -7772,7 +7802,7 @@ void bargraphModeOriginalRampFiringAnimation() {
             }
 
 
-            if(b_bargraph_status_5[i-1] == true) {
+            if(b_bargraph_status_5.get(i-1) == true) {
               wandBargraphControl(i-1);
               break;
             }
@@ -7806,7 +7836,7 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status_5[i] == false) {
+            if(b_bargraph_status_5.get(i) == false) {
               wandBargraphControl(i+1);
               break;
             }
@@ -7844,7 +7874,7 @@ void bargraphModeOriginalRampFiringAnimation() {
             }
 
 
-            if(b_bargraph_status_5[i-1] == true) {
+            if(b_bargraph_status_5.get(i-1) == true) {
               wandBargraphControl(i-1);
               break;
             }
@@ -7878,7 +7908,7 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status_5[i] == false) {
+            if(b_bargraph_status_5.get(i) == false) {
               wandBargraphControl(i+1);
               break;
             }
@@ -7916,7 +7946,7 @@ void bargraphModeOriginalRampFiringAnimation() {
             }
 
 
-            if(b_bargraph_status_5[i-1] == true) {
+            if(b_bargraph_status_5.get(i-1) == true) {
               wandBargraphControl(i-1);
               break;
             }
@@ -7950,7 +7980,7 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status_5[i] == false) {
+            if(b_bargraph_status_5.get(i) == false) {
               wandBargraphControl(i+1);
               break;
             }
@@ -7988,7 +8018,7 @@ void bargraphModeOriginalRampFiringAnimation() {
             }
 
 
-            if(b_bargraph_status_5[i-1] == true) {
+            if(b_bargraph_status_5.get(i-1) == true) {
               wandBargraphControl(i-1);
               break;
             }
@@ -8022,7 +8052,7 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status_5[i] == false) {
+            if(b_bargraph_status_5.get(i) == false) {
               wandBargraphControl(i+1);
               break;
             }
@@ -8060,7 +8090,7 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status_5[i-1] == true) {
+            if(b_bargraph_status_5.get(i-1) == true) {
               wandBargraphControl(i-1);
               break;
             }
@@ -8094,7 +8124,7 @@ void bargraphModeOriginalRampFiringAnimation() {
               }
             }
 
-            if(b_bargraph_status_5[i] == false) {
+            if(b_bargraph_status_5.get(i) == false) {
               wandBargraphControl(i+1);
               break;
             }
@@ -8406,7 +8436,7 @@ void bargraphClearAll() {
   ht_bargraph.clearAll();
 
   for(uint8_t i = 0; i < i_bargraph_segments; i++) {
-    b_bargraph_status[i] = false;
+    b_bargraph_status.set(i, false);
   }
 }
 
@@ -8490,7 +8520,7 @@ void bargraphRedraw() {
       case 5:
         for(uint8_t i = 0; i < i_bargraph_segments - i_segment_adjust; i++) {
           ht_bargraph.setLed(bargraphLookupTable(i));
-          b_bargraph_status[i] = true;
+          b_bargraph_status.set(i, true);
         }
 
         ht_bargraph.sendLed(); // Commit the changes.
@@ -8505,11 +8535,11 @@ void bargraphRedraw() {
         for(uint8_t i = 0; i < i_bargraph_segments - i_segment_adjust; i++) {
           if(i <= bargraphPowerLookupTable(i_power_level)) {
             ht_bargraph.setLed(bargraphLookupTable(i));
-            b_bargraph_status[i] = true;
+            b_bargraph_status.set(i, true);
           }
           else {
             ht_bargraph.clearLed(bargraphLookupTable(i));
-            b_bargraph_status[i] = false;
+            b_bargraph_status.set(i, false);
           }
         }
 
@@ -8584,7 +8614,7 @@ void bargraphPowerCheck() {
       if(b_bargraph_up == true) {
         if(i_bargraph_status_alt < i_bargraph_segments - i_segment_adjust) {
           ht_bargraph.setLedNow(bargraphLookupTable(i_bargraph_status_alt));
-          b_bargraph_status[i_bargraph_status_alt] = true;
+          b_bargraph_status.set(i_bargraph_status_alt, true);
         }
 
         switch(i_power_level) {
@@ -8638,7 +8668,7 @@ void bargraphPowerCheck() {
       else {
         if(i_bargraph_status_alt < i_bargraph_segments - i_segment_adjust) {
           ht_bargraph.clearLedNow(bargraphLookupTable(i_bargraph_status_alt));
-          b_bargraph_status[i_bargraph_status_alt] = false;
+          b_bargraph_status.set(i_bargraph_status_alt, false);
         }
 
         if(i_bargraph_status_alt == 0) {
@@ -8723,7 +8753,7 @@ void bargraphFull() {
 
     for(uint8_t i = 0; i < i_bargraph_segments - i_segment_adjust; i++) {
       ht_bargraph.setLed(bargraphLookupTable(i));
-      b_bargraph_status[i] = true;
+      b_bargraph_status.set(i, true);
     }
 
     ht_bargraph.sendLed(); // Commit the changes.
@@ -8751,7 +8781,7 @@ void bargraphRampUp() {
     switch(i_bargraph_status_alt) {
       case 0 ... 27:
         ht_bargraph.setLedNow(bargraphLookupTable(i_bargraph_status_alt));
-        b_bargraph_status[i_bargraph_status_alt] = true;
+        b_bargraph_status.set(i_bargraph_status_alt, true);
 
         if(i_bargraph_status_alt > 22) {
           vibrationWand(i_vibration_level + 80);
@@ -8793,7 +8823,7 @@ void bargraphRampUp() {
           vibrationOff();
 
           ht_bargraph.clearLedNow(bargraphLookupTable(i_tmp));
-          b_bargraph_status[i_tmp] = false;
+          b_bargraph_status.set(i_tmp, false);
 
           if(i_bargraph_status_alt == 55) {
             ms_bargraph.stop();
@@ -8808,7 +8838,7 @@ void bargraphRampUp() {
         else {
           if((i_power_level < 5 && BARGRAPH_MODE == BARGRAPH_ORIGINAL) || BARGRAPH_MODE == BARGRAPH_SUPER_HERO) {
             ht_bargraph.clearLedNow(bargraphLookupTable(i_tmp));
-            b_bargraph_status[i_tmp] = false;
+            b_bargraph_status.set(i_tmp, false);
           }
 
           switch(BARGRAPH_MODE) {
@@ -8967,7 +8997,7 @@ void bargraphRampUp() {
     switch(i_bargraph_status_alt) {
       case 0 ... 29:
         ht_bargraph.setLedNow(bargraphLookupTable(i_bargraph_status_alt));
-        b_bargraph_status[i_bargraph_status_alt] = true;
+        b_bargraph_status.set(i_bargraph_status_alt, true);
 
         if(i_bargraph_status_alt > 23) {
           vibrationWand(i_vibration_level + 80);
@@ -9009,7 +9039,7 @@ void bargraphRampUp() {
             vibrationOff();
 
             ht_bargraph.clearLedNow(bargraphLookupTable(i_tmp));
-            b_bargraph_status[i_tmp] = false;
+            b_bargraph_status.set(i_tmp, false);
 
             if(i_bargraph_status_alt == 59) {
               ms_bargraph.stop();
@@ -9024,7 +9054,7 @@ void bargraphRampUp() {
         else {
           if((i_power_level < 5 && BARGRAPH_MODE == BARGRAPH_ORIGINAL) || BARGRAPH_MODE == BARGRAPH_SUPER_HERO) {
             ht_bargraph.clearLedNow(bargraphLookupTable(i_tmp));
-            b_bargraph_status[i_tmp] = false;
+            b_bargraph_status.set(i_tmp, false);
           }
 
           switch(BARGRAPH_MODE) {
@@ -9467,48 +9497,48 @@ void wandBargraphControl(uint8_t i_t_level) {
   if(i_t_level > 4) {
     // On
     digitalWriteFast(bargraphLookupTable(5-1), LOW);
-    b_bargraph_status_5[4] = true;
+    b_bargraph_status_5.set(4, true);
   }
   else {
     // Off
     digitalWriteFast(bargraphLookupTable(5-1), HIGH);
-    b_bargraph_status_5[4] = false;
+    b_bargraph_status_5.set(4, false);
   }
 
   if(i_t_level > 3) {
     digitalWriteFast(bargraphLookupTable(4-1), LOW);
-    b_bargraph_status_5[3] = true;
+    b_bargraph_status_5.set(3, true);
   }
   else {
     digitalWriteFast(bargraphLookupTable(4-1), HIGH);
-    b_bargraph_status_5[3] = false;
+    b_bargraph_status_5.set(3, false);
   }
 
   if(i_t_level > 2) {
     digitalWriteFast(bargraphLookupTable(3-1), LOW);
-    b_bargraph_status_5[2] = true;
+    b_bargraph_status_5.set(2, true);
   }
   else {
     digitalWriteFast(bargraphLookupTable(3-1), HIGH);
-    b_bargraph_status_5[2] = false;
+    b_bargraph_status_5.set(2, false);
   }
 
   if(i_t_level > 1) {
     digitalWriteFast(bargraphLookupTable(2-1), LOW);
-    b_bargraph_status_5[1] = true;
+    b_bargraph_status_5.set(1, true);
   }
   else {
     digitalWriteFast(bargraphLookupTable(2-1), HIGH);
-    b_bargraph_status_5[1] = false;
+    b_bargraph_status_5.set(1, false);
   }
 
   if(i_t_level > 0) {
     digitalWriteFast(bargraphLookupTable(1-1), LOW);
-    b_bargraph_status_5[0] = true;
+    b_bargraph_status_5.set(0, true);
   }
   else {
     digitalWriteFast(bargraphLookupTable(1-1), HIGH);
-    b_bargraph_status_5[0] = false;
+    b_bargraph_status_5.set(0, false);
   }
 }
 
@@ -9576,6 +9606,43 @@ int8_t readRotary() {
   return 0;
 }
 
+// Runs once per millisecond (Timer0 drives the millis() clock), independent of the loop.
+ISR(TIMER0_COMPB_vect) {
+  int8_t i_step = readRotary();
+
+  if(i_step < 0 && i_rotary_detents > -i_rotary_max_detents) {
+    i_rotary_detents--;
+  }
+  else if(i_step > 0 && i_rotary_detents < i_rotary_max_detents) {
+    i_rotary_detents++;
+  }
+}
+
+// Discard any detents counted while nothing was consuming them.
+void clearRotaryDetents() {
+  noInterrupts();
+  i_rotary_detents = 0;
+  interrupts();
+}
+
+// Take a single detent counted by the interrupt, so every menu step is acted on in turn.
+int8_t takeRotaryDetent() {
+  int8_t i_step = 0;
+
+  noInterrupts();
+  if(i_rotary_detents < 0) {
+    i_rotary_detents++;
+    i_step = -1;
+  }
+  else if(i_rotary_detents > 0) {
+    i_rotary_detents--;
+    i_step = 1;
+  }
+  interrupts();
+
+  return i_step;
+}
+
 void wandBarrelSpectralCustomConfigOn() {
   for(uint8_t i = 0; i < i_num_barrel_leds; i++) {
     barrel_leds[i] = getHueColour(C_CUSTOM, WAND_BARREL_LED_COUNT);
@@ -9706,19 +9773,13 @@ void overheatTimerDecrement(uint8_t i_tmp_power_level) {
 
 // Top rotary dial on the wand.
 void checkRotaryEncoder() {
-  if(readRotary() != 0) {
-    // Only continue if the limiter has expired.
-    if(ms_rotary_encoder.remaining() > 0) {
-      return;
-    }
-    else {
-      ms_rotary_encoder.start(i_rotary_encoder_delay);
-    }
+  int8_t i_rotary_step = takeRotaryDetent();
 
+  if(i_rotary_step != 0) {
     switch(WAND_ACTION_STATUS) {
       case ACTION_CONFIG_EEPROM_MENU:
         // Counter clockwise.
-        if(prev_next_code == 0x0b) {
+        if(i_rotary_step < 0) {
           if(WAND_MENU_LEVEL == MENU_LEVEL_3 && i_wand_menu == 5 && switch_intensify.on() && !switch_mode.on()) {
             // Adjust the default bootup system volume.
             wandSerialSend(W_VOLUME_DECREASE_EEPROM);
@@ -9883,7 +9944,7 @@ void checkRotaryEncoder() {
         }
 
         // Clockwise.
-        if(prev_next_code == 0x07) {
+        if(i_rotary_step > 0) {
           if(WAND_MENU_LEVEL == MENU_LEVEL_3 && i_wand_menu == 5 && switch_intensify.on() && !switch_mode.on()) {
             // Adjust the default bootup system volume.
             wandSerialSend(W_VOLUME_INCREASE_EEPROM);
@@ -10050,7 +10111,7 @@ void checkRotaryEncoder() {
 
       case ACTION_LED_EEPROM_MENU:
         // Counter clockwise.
-        if(prev_next_code == 0x0b) {
+        if(i_rotary_step < 0) {
           if(WAND_MENU_LEVEL == MENU_LEVEL_1 && i_wand_menu == 4 && !switch_intensify.on() && switch_mode.on()) {
             // Change colour of the wand barrel spectral custom colour.
             if(i_spectral_wand_custom_colour > 1 && i_spectral_wand_custom_saturation > 253) {
@@ -10124,7 +10185,7 @@ void checkRotaryEncoder() {
         }
 
         // Clockwise.
-        if(prev_next_code == 0x07) {
+        if(i_rotary_step > 0) {
           if(WAND_MENU_LEVEL == MENU_LEVEL_1 && i_wand_menu == 4 && !switch_intensify.on() && switch_mode.on()) {
             // Change colour of the Wand Barrel Spectral custom colour.
             if(i_spectral_wand_custom_saturation < 254) {
@@ -10205,7 +10266,7 @@ void checkRotaryEncoder() {
 
       case ACTION_SETTINGS:
         // Counter clockwise.
-        if(prev_next_code == 0x0b) {
+        if(i_rotary_step < 0) {
           if(i_wand_menu == 4 && WAND_MENU_LEVEL == MENU_LEVEL_1 && switch_intensify.on() && !switch_mode.on()) {
             // Tell pack to dim the selected lighting. (Power Cell, Cyclotron or Inner Cyclotron)
             wandSerialSend(W_DIMMING_DECREASE);
@@ -10268,7 +10329,7 @@ void checkRotaryEncoder() {
         }
 
         // Clockwise.
-        if(prev_next_code == 0x07) {
+        if(i_rotary_step > 0) {
           if(i_wand_menu == 4 && WAND_MENU_LEVEL == MENU_LEVEL_1 && switch_intensify.on() && !switch_mode.on()) {
             // Tell pack to dim the selected lighting. (Power Cell, Cyclotron or Inner Cyclotron)
             wandSerialSend(W_DIMMING_INCREASE);
@@ -10335,12 +10396,12 @@ void checkRotaryEncoder() {
       default:
         if(((WAND_STATUS == MODE_ON && SYSTEM_MODE != MODE_ORIGINAL) || WAND_STATUS == MODE_OFF) && switch_intensify.on() && !switch_vent.on() && !switch_wand.on()) {
             // Counter clockwise.
-            if(prev_next_code == 0x0b) {
+            if(i_rotary_step < 0) {
               // Decrease the master system volume of both the Proton Pack and Neutrona Wand.
               decreaseVolume();
               wandSerialSend(W_VOLUME_DECREASE);
             }
-            else if(prev_next_code == 0x07) {
+            else if(i_rotary_step > 0) {
               // Increase the master system volume of both the Proton Pack and Neutrona Wand.
               increaseVolume();
               wandSerialSend(W_VOLUME_INCREASE);
@@ -10351,7 +10412,7 @@ void checkRotaryEncoder() {
             // Do nothing, we are locked in full power level while firing.
           }
           // Counter clockwise.
-          else if(prev_next_code == 0x0b) {
+          else if(i_rotary_step < 0) {
             if(switch_wand.on() && switch_vent.on() && switch_activate.on() && WAND_STATUS == MODE_ON) {
               if(i_power_level - 1 >= (SYSTEM_MODE == MODE_ORIGINAL ? (i_power_level_min + 1) : i_power_level_min)) {
                 i_power_level_prev = i_power_level;
@@ -10362,7 +10423,7 @@ void checkRotaryEncoder() {
                 }
 
                 // Forces a redraw of the bargraph if firing while changing the power level in the BARGRAPH_ANIMATION_ORIGINAL.
-                if(b_firing && BARGRAPH_TYPE != SEGMENTS_5 && BARGRAPH_FIRING_ANIMATION == BARGRAPH_ANIMATION_ORIGINAL) {
+                if(firingState.firing && BARGRAPH_TYPE != SEGMENTS_5 && BARGRAPH_FIRING_ANIMATION == BARGRAPH_ANIMATION_ORIGINAL) {
                   bargraphRedraw();
                 }
 
@@ -10462,7 +10523,7 @@ void checkRotaryEncoder() {
             // Do nothing, we are locked in full power level while firing.
           }
           // Clockwise.
-          else if(prev_next_code == 0x07) {
+          else if(i_rotary_step > 0) {
             if(switch_wand.on() && switch_vent.on() && switch_activate.on() && WAND_STATUS == MODE_ON) {
               if(i_power_level + 1 <= i_power_level_max) {
                 if(i_power_level + 1 == i_power_level_max && WAND_ACTION_STATUS == ACTION_FIRING) {
@@ -10477,7 +10538,7 @@ void checkRotaryEncoder() {
                   }
 
                   // Forces a redraw of the bargraph if firing while changing the power level if using BARGRAPH_ANIMATION_ORIGINAL.
-                  if(b_firing && BARGRAPH_TYPE != SEGMENTS_5 && BARGRAPH_FIRING_ANIMATION == BARGRAPH_ANIMATION_ORIGINAL) {
+                  if(firingState.firing && BARGRAPH_TYPE != SEGMENTS_5 && BARGRAPH_FIRING_ANIMATION == BARGRAPH_ANIMATION_ORIGINAL) {
                     bargraphRedraw();
                   }
 
@@ -10755,22 +10816,20 @@ void vibrationOff() {
 }
 
 void switchLoops() {
-  switch_intensify.poll();
-  switch_activate.poll();
-  switch_vent.poll();
-  switch_wand.poll();
-  switch_mode.poll();
-  switch_barrel.poll();
-}
+  // Sample all of the switches together once per scan tick.
+  if(wandSwitches.due(millis())) {
+    wandSwitches.sample(readWandSwitches());
 
-void ventSwitched(void* n) {
-  (void)(n); // Suppress unused variable warning
-  ventSwitchedCount++;
-}
+    if(switch_vent.pushed()) {
+      ventSwitchedCount++;
+    }
 
-void wandSwitched(void* n) {
-  (void)(n); // Suppress unused variable warning
-  wandSwitchedCount++;
+    if(switch_wand.pushed()) {
+      wandSwitchedCount++;
+    }
+  }
+
+  switch_intensify.poll(millis());
 }
 
 void wandBarrelLightsOff() {
@@ -10977,7 +11036,7 @@ void afterlifeRampSound1() {
     playEffect(S_AFTERLIFE_WAND_RAMP_1);
   }
 
-  b_sound_afterlife_idle_2_fade = false;
+  firingState.soundAfterlifeIdle2Fade = false;
 }
 
 // Arms/Disarms the power-on reminder (if enabled).
@@ -11142,13 +11201,19 @@ void resetWhiteLEDBlinkRate() {
   }
 }
 
-// Rebuilds the overheat enable array.
+// Rebuilds the overheat enable and overheat timer arrays.
 void resetOverheatLevels() {
   b_overheat_level[0] = b_overheat_level_1;
   b_overheat_level[1] = b_overheat_level_2;
   b_overheat_level[2] = b_overheat_level_3;
   b_overheat_level[3] = b_overheat_level_4;
   b_overheat_level[4] = b_overheat_level_5;
+
+  i_ms_overheat_initiate[0] = i_ms_overheat_initiate_level_1;
+  i_ms_overheat_initiate[1] = i_ms_overheat_initiate_level_2;
+  i_ms_overheat_initiate[2] = i_ms_overheat_initiate_level_3;
+  i_ms_overheat_initiate[3] = i_ms_overheat_initiate_level_4;
+  i_ms_overheat_initiate[4] = i_ms_overheat_initiate_level_5;
 }
 
 // Included last as the contained logic will control all aspects of the pack using the defined functions above.
@@ -361,7 +361,8 @@ enum wand_messages : uint8_t {
   W_BARGRAPH_30_SEGMENTS,
   W_RGB_VENT_DISABLED,
   W_RGB_VENT_ENABLED,
-  W_COM_SOUND_NUMBER
+  W_COM_SOUND_NUMBER,
+  W_MEMORY_STATS
 };
 
 enum api_messages : uint8_t {
@@ -450,5 +451,6 @@ enum api_messages : uint8_t {
   A_SEND_PREFERENCES_SMOKE,
   A_SAVE_PREFERENCES_PACK,
   A_SAVE_PREFERENCES_WAND,
-  A_SAVE_PREFERENCES_SMOKE
+  A_SAVE_PREFERENCES_SMOKE,
+  A_MEMORY_STATS
 };
\ No newline at end of file
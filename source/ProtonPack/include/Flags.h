@@ -0,0 +1,52 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2023-2025 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * Packed Flags
+ *
+ * An array of bool costs a full byte of SRAM per flag. flagSet stores the same flags one per bit, so
+ * per-LED and per-segment state stays small as the LED counts grow. Scalar flags which change together
+ * are grouped into bitfield structs in Header.h for the same reason.
+ */
+template<uint8_t N>
+class flagSet {
+  public:
+    bool get(uint8_t i) const {
+      return (bits[i >> 3] >> (i & 0x07)) & 0x01;
+    }
+
+    void set(uint8_t i, bool b_value) {
+      if(b_value) {
+        bits[i >> 3] |= (1 << (i & 0x07));
+      }
+      else {
+        bits[i >> 3] &= ~(1 << (i & 0x07));
+      }
+    }
+
+    void setAll(bool b_value) {
+      memset(bits, b_value ? 0xFF : 0x00, sizeof(bits));
+    }
+
+  private:
+    uint8_t bits[(N + 7) / 8] = {};
+};
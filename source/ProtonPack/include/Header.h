@@ -177,14 +177,14 @@ CRGB cyclotron_leds[INNER_CYCLOTRON_LED_PANEL_MAX + INNER_CYCLOTRON_CAKE_LED_MAX
  */
 #define FAST_LED_UPDATE_MS 5
 uint8_t i_fast_led_delay = FAST_LED_UPDATE_MS;
-millisDelay ms_fast_led;
+millisTimer ms_fast_led;
 
 /*
  * Power Cell LEDs control.
  */
 uint8_t i_powercell_delay = i_powercell_delay_2021;
 int8_t i_powercell_led = 0;
-millisDelay ms_powercell;
+millisTimer ms_powercell;
 bool b_powercell_updating = false;
 uint8_t i_powercell_multiplier = 1;
 bool b_powercell_sound_loop = false;
@@ -219,18 +219,22 @@ const uint16_t i_2021_ramp_down_length = 10500;
 const uint16_t i_1984_ramp_down_length = 2500;
 uint16_t i_outer_current_ramp_speed = i_2021_ramp_delay;
 uint8_t i_cyclotron_multiplier = 1;
-millisDelay ms_cyclotron_auto_speed_timer; // A timer that is active while firing only in Afterlife and Frozen Empire. Used to speed up the Cyclotron by small increments based on the wand power level.
+millisTimer ms_cyclotron_auto_speed_timer; // A timer that is active while firing only in Afterlife and Frozen Empire. Used to speed up the Cyclotron by small increments based on the wand power level.
 const uint16_t i_cyclotron_auto_speed_timer_length = 15000;
-bool b_2021_ramp_up = true;
-bool b_2021_ramp_up_start = true;
-bool b_2021_ramp_down_start = false;
-bool b_2021_ramp_down = false;
-bool b_reset_start_led = true;
-bool b_1984_led_start = true;
-millisDelay ms_cyclotron;
-millisDelay ms_cyclotron_slime_effect;
+struct __attribute__((packed)) objCyclotronState {
+  bool ramp2021Up : 1;
+  bool ramp2021UpStart : 1;
+  bool ramp2021DownStart : 1;
+  bool ramp2021Down : 1;
+  bool resetStartLed : 1;
+  bool ledStart1984 : 1;
+  bool innerRampUp : 1; // Gotta start up before you can wind down.
+  bool innerRampDown : 1; // Opposite of the ramp_up value, naturally.
+} cyclotronState = { true, true, false, false, true, true, true, false };
+millisTimer ms_cyclotron;
+millisTimer ms_cyclotron_slime_effect;
 rampUnsignedInt r_outer_cyclotron_ramp;
-bool b_cyclotron_led_fading_in[OUTER_CYCLOTRON_LED_MAX] = { false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false };
+flagSet<OUTER_CYCLOTRON_LED_MAX> b_cyclotron_led_fading_in;
 ramp r_cyclotron_led_fade_out[OUTER_CYCLOTRON_LED_MAX] = {};
 ramp r_cyclotron_led_fade_in[OUTER_CYCLOTRON_LED_MAX] = {};
 uint8_t i_cyclotron_led_value[OUTER_CYCLOTRON_LED_MAX] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
@@ -257,13 +261,11 @@ enum INNER_CYC_PANEL_MODES INNER_CYC_PANEL_MODE;
 /*
  * Inner Cyclotron NeoPixel ring ramp control.
  */
-millisDelay ms_cyclotron_ring;
+millisTimer ms_cyclotron_ring;
 rampUnsignedInt r_inner_cyclotron_ramp;
 const uint16_t i_inner_ramp_delay = 300;
 int8_t i_led_cyclotron_ring = 0; // Current LED for the inner cyclotron ring.
 int8_t i_led_cyclotron_cavity = 0; // Current LED for the cyclotron cavity.
-bool b_inner_ramp_up = true; // Gotta start up before you can wind down.
-bool b_inner_ramp_down = false; // Opposite of the ramp_up value, naturally.
 uint16_t i_inner_current_ramp_speed = i_inner_ramp_delay; // Begin by defaulting to the inner ramp delay (this will be adjusted by the cyclotron multiplier at runtime).
 uint8_t i_inner_cyclotron_panel_num_leds = INNER_CYCLOTRON_LED_PANEL_MAX; // Addressable RGB LEDs on the optional inner cyclotron LED switch plate panel PCB, not the individual LEDs.
 const uint8_t i_ic_panel_start = 0; // Will always be 0 no matter what configuration is in use.
@@ -281,8 +283,8 @@ uint8_t i_cyclotron_switch_led_mulitplier = 1;
 const uint8_t i_cyclotron_switch_led_delay_base = 150;
 const uint16_t i_cyclotron_switch_plate_leds_delay = 1000;
 uint16_t i_cyclotron_switch_led_delay = i_cyclotron_switch_led_delay_base;
-millisDelay ms_cyclotron_switch_led; // Timer to control the 6 decorative LED patterns.
-millisDelay ms_cyclotron_switch_plate_leds; // Timer to control the 2 switch status indicator LEDs.
+millisTimer ms_cyclotron_switch_led; // Timer to control the 6 decorative LED patterns.
+millisTimer ms_cyclotron_switch_plate_leds; // Timer to control the 2 switch status indicator LEDs.
 
 /*
  * Alarm
@@ -290,17 +292,18 @@ millisDelay ms_cyclotron_switch_plate_leds; // Timer to control the 2 switch sta
  */
 const uint16_t i_alarm_delay = 500;
 bool b_alarm = false;
-millisDelay ms_alarm;
+millisTimer ms_alarm;
 
 /*
  * Switches
  */
-ezButton switch_alarm(RIBBON_CABLE_SWITCH_PIN); // Ribbon cable removal switch
-ezButton switch_mode(YEAR_TOGGLE_PIN); // 1984 / 2021 mode toggle switch
-ezButton switch_vibration(VIBRATION_TOGGLE_PIN); // Vibration toggle switch
-ezButton switch_cyclotron_direction(CYCLOTRON_DIRECTION_TOGGLE_PIN); // Newly added switch for controlling the direction of the Cyclotron lights. Not required. Defaults to clockwise.
-ezButton switch_power(ION_ARM_SWITCH_PIN); // Red power switch under the Ion Arm.
-ezButton switch_smoke(SMOKE_TOGGLE_PIN); // Switch to enable smoke effects. Not required. Defaults to off/disabled.
+switchBank packSwitches(15, 0, _BV(SWITCH_POWER)); // Sampled every 15ms, four agreeing samples to change. The Ion Arm switch is not debounced.
+bankedSwitch switch_alarm(packSwitches, SWITCH_ALARM); // Ribbon cable removal switch
+bankedSwitch switch_mode(packSwitches, SWITCH_MODE); // 1984 / 2021 mode toggle switch
+bankedSwitch switch_vibration(packSwitches, SWITCH_VIBRATION); // Vibration toggle switch
+bankedSwitch switch_cyclotron_direction(packSwitches, SWITCH_CYCLOTRON_DIRECTION); // Newly added switch for controlling the direction of the Cyclotron lights. Not required. Defaults to clockwise.
+bankedSwitch switch_power(packSwitches, SWITCH_POWER); // Red power switch under the Ion Arm.
+bankedSwitch switch_smoke(packSwitches, SWITCH_SMOKE); // Switch to enable smoke effects. Not required. Defaults to off/disabled.
 
 /*
  * Vibration motor settings
@@ -315,7 +318,7 @@ uint8_t i_vibration_level_prev = 0;
 const uint8_t i_vibration_idle_level_2021 = 60;
 const uint8_t i_vibration_idle_level_1984 = 35;
 const uint8_t i_vibration_lowest_level = 15;
-millisDelay ms_menu_vibration; // Timer to do non-blocking confirmation buzzing in the vibration menu.
+millisTimer ms_menu_vibration; // Timer to do non-blocking confirmation buzzing in the vibration menu.
 
 /*
  * Enable or disable vibration control for the Proton Pack.
@@ -326,26 +329,26 @@ bool b_vibration_switch_on = true;
 /*
  * Overheating and smoke timers for NFILTER_SMOKE_PIN.
  */
-millisDelay ms_overheating;
+millisTimer ms_overheating;
 const uint16_t i_overheating_delay = 4000;
 bool b_overheating = false;
 bool b_venting = false;
-millisDelay ms_smoke_timer;
-millisDelay ms_smoke_on;
+millisTimer ms_smoke_timer;
+millisTimer ms_smoke_on;
 const uint16_t sfx_smoke[5] PROGMEM = { S_VENT_SMOKE, S_VENT_SMOKE_1, S_VENT_SMOKE_2, S_VENT_SMOKE_3, S_VENT_SMOKE_4 };
 const uint16_t i_smoke_timer[5] PROGMEM = { i_smoke_timer_level_1, i_smoke_timer_level_2, i_smoke_timer_level_3, i_smoke_timer_level_4, i_smoke_timer_level_5 };
 const uint16_t i_smoke_on_time[5] PROGMEM = { i_smoke_on_time_level_1, i_smoke_on_time_level_2, i_smoke_on_time_level_3, i_smoke_on_time_level_4, i_smoke_on_time_level_5 };
 bool b_smoke_continuous_level[5] = { b_smoke_continuous_level_1, b_smoke_continuous_level_2, b_smoke_continuous_level_3, b_smoke_continuous_level_4, b_smoke_continuous_level_5 };
 const bool b_smoke_overheat_level[5] = { b_smoke_overheat_level_1, b_smoke_overheat_level_2, b_smoke_overheat_level_3, b_smoke_overheat_level_4, b_smoke_overheat_level_5 };
-millisDelay ms_overheating_length; // The total length of the when the fans turn on (or smoke if smoke synced to fan)
+millisTimer ms_overheating_length; // The total length of the when the fans turn on (or smoke if smoke synced to fan)
 const uint16_t i_overheat_delay_increment = 1000; // Used to increment the overheat delays by 1000 milliseconds.
 const uint16_t i_overheat_delay_max = 60000; // The max length a overheat can be.
 
 /*
  * Vent light timers and delay for overheating.
  */
-millisDelay ms_vent_light_on;
-millisDelay ms_vent_light_off;
+millisTimer ms_vent_light_on;
+millisTimer ms_vent_light_off;
 const uint8_t i_vent_light_delay = 50;
 bool b_vent_sounds; // A flag for playing smoke and vent sounds.
 bool b_vent_light_on = false; // To know if the light is on or off.
@@ -375,20 +378,22 @@ enum STATUS_CROSS_THE_STREAMS STATUS_CTS;
 /*
  * Wand Status
  */
-bool b_wand_firing = false;
-bool b_firing_alt = false;
-bool b_firing_intensify = false;
-bool b_sound_firing_intensify_trigger = false;
-bool b_sound_firing_alt_trigger = false;
-bool b_wand_connected = false;
-bool b_wand_syncing = false;
-bool b_wand_on = false;
-bool b_wand_mash_lockout = false;
-bool b_neutrona_wand_barrel_extended = true; // Assume barrel extended (safety off).
+struct __attribute__((packed)) objWandState {
+  bool firing : 1;
+  bool firingAlt : 1;
+  bool firingIntensify : 1;
+  bool soundIntensifyTrigger : 1;
+  bool soundAltTrigger : 1;
+  bool connected : 1;
+  bool syncing : 1;
+  bool on : 1;
+  bool mashLockout : 1;
+  bool barrelExtended : 1; // Assume barrel extended (safety off).
+} wandState = { false, false, false, false, false, false, false, false, false, true };
 const uint8_t i_wand_power_level_max = 5; // Max power level of the wand.
 uint8_t i_wand_power_level = 1; // Power level of the wand.
-millisDelay ms_wand_check; // Timer used to determine whether the wand has been disconnected.
-millisDelay ms_mash_lockout; // Timer for tracking the expected button-mash lockout on the wand.
+millisTimer ms_wand_check; // Timer used to determine whether the wand has been disconnected.
+millisTimer ms_mash_lockout; // Timer for tracking the expected button-mash lockout on the wand.
 const uint16_t i_wand_disconnect_delay = 8000; // Time until the pack considers a wand as disconnected.
 
 /*
@@ -396,8 +401,10 @@ const uint16_t i_wand_disconnect_delay = 8000; // Time until the pack considers
  */
 bool b_serial1_connected = false;
 bool b_serial1_syncing = false;
-millisDelay ms_serial1_check;
+millisTimer ms_serial1_check;
 const uint16_t i_serial1_disconnect_delay = 8000; // Time until the pack considers the Serial1 device disconnected.
+millisTimer ms_memory_check; // Timer for reporting SRAM usage to the Serial1 device.
+const uint16_t i_memory_check_delay = 5000; // Delay between SRAM usage reports.
 
 /*
  * Define Serial Communication Buffers
@@ -408,30 +415,40 @@ SerialTransfer packComs;
 /*
  * Firing timers
  */
-millisDelay ms_firing_length_timer;
+millisTimer ms_firing_length_timer;
 const uint16_t i_firing_timer_length = 15000; // 15 seconds. Used by ms_firing_length_timer to determine which tail_end sound effects to play.
-millisDelay ms_firing_sound_mix; // Used to play misc sound effects during firing.
+millisTimer ms_firing_sound_mix; // Used to play misc sound effects during firing.
 uint16_t i_last_firing_effect_mix = 0;
-millisDelay ms_idle_fire_fade; // Used for fading the Afterlife idling sound with firing, and determining whether to use "full" or "quick" bootup sequences.
+millisTimer ms_idle_fire_fade; // Used for fading the Afterlife idling sound with firing, and determining whether to use "full" or "quick" bootup sequences.
 
 /*
  * Rotary encoder for volume control
+ * Decoded every millisecond by the Timer0 compare interrupt, so detents are counted while the loop is busy with other work.
+ * FastLED.show() holds interrupts off while it writes the LEDs, so samples (and steps of a very fast turn) can be missed then.
+ * The loop consumes the net count, and a quick spin moves the volume several steps per detent.
  */
-millisDelay ms_rotary_encoder; // Timer for slowing the rotary encoder spin.
-const uint8_t i_rotary_encoder_delay = 50; // Time to delay adjusting volume.
 static uint8_t prev_next_code = 0;
 static uint16_t store = 0;
+volatile int8_t i_rotary_detents = 0; // Net detents counted by the interrupt, not yet consumed by the loop.
+const int8_t i_rotary_max_detents = 4; // Limit on the detents held for the loop, so a stalled loop does not keep turning the volume afterwards.
+uint32_t i_rotary_last_detent = 0; // Time (ms) when detents were last consumed.
+const uint8_t i_rotary_fast_interval = 25; // Detents closer than this (ms) move 4 steps each.
+const uint8_t i_rotary_medium_interval = 60; // Detents closer than this (ms) move 2 steps each.
+const uint8_t i_rotary_max_steps = 20; // Limit on the steps taken in one pass, to bound the serial traffic to the wand.
 
 /*
  * Proton Pack Bootup Post Animations
  */
 bool b_pack_post_finish = false;
+#if DEBUG == 1
+  bool b_first_light_reported = false; // Whether the time of the first LED update has been reported.
+#endif
 uint8_t i_post_powercell_up = 0;
 uint8_t i_post_powercell_down = 0;
 uint8_t i_post_fade = 255;
-millisDelay ms_delay_post; // Also used for Brass Pack shutdown steam effect.
-millisDelay ms_delay_post_2;
-millisDelay ms_delay_post_3;
+millisTimer ms_delay_post; // Also used for Brass Pack shutdown steam effect.
+millisTimer ms_delay_post_2;
+millisTimer ms_delay_post_3;
 
 /*
  * LED Dimming / Brightness Control.
@@ -476,7 +493,7 @@ bool b_spectral_lights_on = false;
 bool b_fade_out = false;
 const uint16_t i_gbfe_brass_shutdown_delay = 8796;
 const uint8_t i_fadeout_duration = 50;
-millisDelay ms_fadeout;
+millisTimer ms_fadeout;
 
 /*
  * Function prototypes.
@@ -495,7 +512,8 @@ void powercellDraw(uint8_t i_start = 0);
  * If you are compiling this for an Arduino Mega and the error message brings you here, go to the bottom of the Configuration.h file for more information.
  */
 #ifdef GPSTAR_PROTON_PACK_PCB
-  ezButton switch_cyclotron_lid(CYCLOTRON_LID_SWITCH_PIN); // Second Cyclotron ground pin (brown) that we detect if the lid is removed or not.
+  const uint8_t i_cyclotron_lid_switch_pin = CYCLOTRON_LID_SWITCH_PIN; // Second Cyclotron ground pin (brown) that we detect if the lid is removed or not.
 #else
-  ezButton switch_cyclotron_lid(CYCLOTRON_LID_SWITCH_PIN_DIY); // Alternate pin for legacy DIY builds.
-#endif
\ No newline at end of file
+  const uint8_t i_cyclotron_lid_switch_pin = CYCLOTRON_LID_SWITCH_PIN_DIY; // Alternate pin for legacy DIY builds.
+#endif
+bankedSwitch switch_cyclotron_lid(packSwitches, SWITCH_CYCLOTRON_LID); // Read from i_cyclotron_lid_switch_pin by readPackSwitches().
\ No newline at end of file
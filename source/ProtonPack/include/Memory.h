@@ -0,0 +1,102 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2023-2025 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * SRAM Monitor
+ *
+ * The heap grows up from __heap_start and the stack grows down from RAMEND, sharing whatever SRAM the globals leave.
+ * Before any constructor runs, paintStack() fills that gap with a canary byte. The stack overwrites the canary as it
+ * deepens, so the painted bytes still intact above the heap are the closest the two have come to colliding since boot.
+ */
+extern uint8_t __heap_start;
+extern char *__brkval; // Top of the heap, or null until malloc() is first used.
+
+// Blocks released by free() are kept on this list by avr-libc until they can be reused.
+struct __freelist {
+  size_t sz;
+  struct __freelist *nx;
+};
+
+extern struct __freelist *__flp;
+
+const uint8_t i_memory_canary = 0xC5;
+
+// Reported over serial, so both the ATmega2560 controllers and the Attenuator must agree on the layout.
+struct __attribute__((packed)) MemoryStats {
+  uint16_t freeRAM; // Bytes between the heap and the stack right now.
+  uint16_t minFreeRAM; // Fewest bytes ever left between the heap and the stack.
+  uint16_t heapFree; // Bytes held on the heap free list (fragmentation).
+  uint16_t stackPeak; // Deepest stack use since boot.
+};
+
+// Runs from .init3, after the stack pointer is set but before .data/.bss are initialised, so it cannot use either.
+void paintStack() __attribute__((naked, used, section(".init3")));
+void paintStack() {
+  uint8_t *p = &__heap_start;
+
+  while(p < (uint8_t *)SP) {
+    *p++ = i_memory_canary;
+  }
+}
+
+// Current top of the heap; the first byte the stack must never reach.
+uint8_t *memoryHeapEnd() {
+  return __brkval == nullptr ? &__heap_start : (uint8_t *)__brkval;
+}
+
+// Free SRAM at this instant, measured at the caller's stack depth.
+uint16_t memoryFreeNow() {
+  uint8_t i_marker = 0;
+
+  return (uint16_t)(&i_marker - memoryHeapEnd());
+}
+
+// High-water mark: count painted bytes above the heap which the stack has never touched.
+uint16_t memoryFreeMin() {
+  uint8_t *p = memoryHeapEnd();
+  uint16_t i_count = 0;
+
+  while(p <= (uint8_t *)RAMEND && *p == i_memory_canary) {
+    p++;
+    i_count++;
+  }
+
+  return i_count;
+}
+
+// Bytes released back to the heap but not yet returned to the free gap.
+uint16_t memoryHeapFree() {
+  uint16_t i_total = 0;
+
+  for(struct __freelist *p_block = __flp; p_block != nullptr; p_block = p_block->nx) {
+    i_total += p_block->sz + sizeof(size_t);
+  }
+
+  return i_total;
+}
+
+void updateMemoryStats(MemoryStats &stats) {
+  stats.freeRAM = memoryFreeNow();
+  stats.minFreeRAM = memoryFreeMin();
+  stats.heapFree = memoryHeapFree();
+  stats.stackPeak = (uint16_t)((uint8_t *)RAMEND - memoryHeapEnd()) + 1 - stats.minFreeRAM;
+}
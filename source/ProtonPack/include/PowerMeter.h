@@ -30,6 +30,7 @@
 
 // Custom values for calibrating the current-sensing device.
 #define SHUNT_R     0.1  // Shunt resistor in ohms (default: 0.1ohm)
+#define SHUNT_R_MO  100  // Shunt resistor in milliohms, for the integer conversions below (must match SHUNT_R)
 #define SHUNT_MAX_V 0.2  // Max voltage across shunt (default: 0.2V)
 #define BUS_MAX_V   16.0 // Sets max based on expected range (< 16V)
 #define MAX_CURRENT 2.0  // Sets the expected max amperage draw (2A)
@@ -39,36 +40,81 @@ INA219 monitor; // Power monitor object on i2c bus using the INA219 chip.
 bool b_power_meter_available = false; // Whether a power meter device exists on i2c bus, per setup() -> powerMeterInit()
 bool b_pack_started_by_meter = false; // Whether the pack was started via detection through the power meter.
 const uint16_t f_wand_power_up_delay = 1000; // How long to wait and ignore any wand firing events after initial power-up (ms).
-const float f_wand_power_on_threshold = 0.65; // Minimum power (W) to consider as to whether a stock Neutrona Wand is powered on.
-const float f_ema_alpha = 0.2; // Smoothing factor (<1) for Exponential Moving Average (EMA) [Lower Value = Smoother Averaging].
+
+/**
+ * Fixed-Point Readings
+ * The ATmega2560 has no FPU, so every reading below is kept as an integer in the unit noted beside it.
+ * Smoothed power is held in Q8 (milliwatts x 256) so the moving average keeps its fractional part between reads.
+ */
+const uint8_t i_power_q_bits = 8; // Fractional bits for smoothed power values.
+const int32_t i_wand_power_on_threshold = 650L << i_power_q_bits; // Minimum power (650mW) to consider as to whether a stock Neutrona Wand is powered on.
+const uint8_t i_ema_alpha = 51; // Smoothing factor (51/256 = ~0.2) for Exponential Moving Average (EMA) [Lower Value = Smoother Averaging].
+const uint32_t i_charge_per_mah = 36000000UL; // Shunt current (0.1mA) x time (ms) in one milliamp-hour.
+
+/**
+ * Stock Wand Current Profiles (0.1mA)
+ * Idle and firing current ranges per power level, as measured from a stock Neutrona Wand (see updateWandPowerState).
+ * The idle baseline selects a level, and the midpoint between that level's idle maximum and firing minimum becomes
+ * the trigger threshold. Each sample adds its distance from the threshold to a cumulative sum (CUSUM), so a clear
+ * step trips the detector within a sample or two while brief noise is absorbed by the limit.
+ */
+const uint16_t i_wand_idle_current_max[5] PROGMEM = { 1500, 1800, 2000, 2200, 2500 };
+const uint16_t i_wand_fire_current_min[5] PROGMEM = { 2300, 2600, 2900, 3000, 3400 };
+const int16_t i_wand_fire_cusum_limit = 300; // Cumulative current (0.1mA x samples) beyond the threshold to start or stop firing.
 
 // Special Timers and Timeouts
-millisDelay ms_powerup_debounce; // Timer to lock out firing when the wand powers on.
+millisTimer ms_powerup_debounce; // Timer to lock out firing when the wand powers on.
+
+/**
+ * Power Meter Sampling
+ * Rather than reading every register (and rewriting the configuration) on a timer, the wand meter is sampled by a
+ * small state machine which performs at most one short i2c transaction per pass of the loop. The bus voltage register
+ * is polled until its conversion-ready flag is set, so each conversion is used exactly once and never re-read stale.
+ * The configuration is only restored when the calibration register shows the INA219 was reset by a transient.
+ */
+const uint8_t i_power_meter_address = 0x40; // Default INA219 address (A0/A1 to GND), as used by the INA219 library.
+const uint8_t i_power_meter_poll_delay = 2; // How often (ms) to poll for a completed conversion (~8.5ms at 8 samples).
+const uint8_t i_power_meter_reset_interval = 8; // Conversions between checks for a device reset.
+
+enum INA219_REGISTERS : uint8_t {
+  INA219_SHUNT_VOLTAGE = 0x01,
+  INA219_BUS_VOLTAGE = 0x02,
+  INA219_POWER = 0x03,
+  INA219_CALIBRATION = 0x05
+};
+
+enum POWER_METER_STEPS : uint8_t {
+  METER_WAIT_READY,  // Poll the bus voltage register for the conversion-ready flag.
+  METER_READ_SHUNT,  // Read the shunt voltage from the same conversion, then act on the new sample.
+  METER_CLEAR_READY, // Read the power register, which clears the conversion-ready flag.
+  METER_CHECK_RESET  // Read the calibration register, which is zero after a device reset.
+};
+enum POWER_METER_STEPS METER_STEP;
+uint8_t i_power_meter_conversions = 0; // Conversions since the last check for a device reset.
 
 // Define an object which can store
 struct PowerMeter {
   const static uint16_t StateChangeDuration = 80; // Duration (ms) for a current change to persist for action
-  const static float StateChangeThreshold; // Minimum change in current (A) to consider as a potential state change
-  float ShuntVoltage = 0; // mV - Millivolts read to calculate the amperage draw across the shunt resistor
-  float ShuntCurrent = 0; // A - The current (amperage) reading via the shunt resistor
-  float BusVoltage = 0;   // mV - Voltage reading from the measured device
-  float BattVoltage = 0;  // V - Reference voltage from device power source
-  float BusPower = 0;     // W - Calculation of power based on the bus mV*A values
-  float AmpHours = 0;     // Ah - An estimation of power consumed over regular intervals
-  float RawPower = 0;     // W - Calculation of power based on raw V*A values (non-smoothed)
-  float AvgPower = 0;     // A - Running average from the RawPower value (smoothed)
-  float LastAverage = 0;  // A - Last average used when determining a state change
+  const static int32_t StateChangeThreshold = 200L << i_power_q_bits; // mW (Q8) - Minimum change in power to consider as a potential state change
+  int16_t ShuntVoltage = 0;   // 10uV - Raw reading used to calculate the amperage draw across the shunt resistor
+  int16_t ShuntCurrent = 0;   // 0.1mA - The current (amperage) reading via the shunt resistor
+  uint16_t BusVoltage = 0;    // mV - Voltage reading from the measured device
+  uint16_t BattVoltage = 0;   // mV - Reference voltage from device power source
+  uint16_t MilliAmpHours = 0; // mAh - An estimation of charge consumed over regular intervals
+  uint32_t Charge = 0;        // 0.1mA x ms - Charge consumed toward the next whole mAh
+  int32_t RawPower = 0;       // mW - Calculation of power based on raw V*A values (non-smoothed)
+  int32_t AvgPower = 0;       // mW (Q8) - Running average from the RawPower value (smoothed)
+  int32_t LastAverage = 0;    // mW (Q8) - Last average used when determining a state change
+  int16_t IdleCurrent = 0;    // 0.1mA - Smoothed current while idle, used to select the power level profile
+  int16_t FireSum = 0;        // 0.1mA x samples - Cumulative current above the trigger threshold
+  int16_t StopSum = 0;        // 0.1mA x samples - Cumulative current below the trigger threshold while firing
   uint16_t PowerReadDelay = StateChangeDuration / 4; // How often (ms) to read levels for changes
   unsigned long StateChanged = 0; // Time when a potential state change was detected
   unsigned long LastRead = 0;     // Used to calculate Ah consumed since battery power-on
   unsigned long ReadTick = 0;     // Difference of current read time - last read
-  millisDelay ReadTimer;          // Timer for reading latest values from power meter
+  millisTimer ReadTimer;          // Timer for reading latest values from power meter
 };
 
-// Set the static constant for considering a "change" based on latest current reading average.
-// IOW, if we measure a difference of this much since the last average, the user initiated input.
-const float PowerMeter::StateChangeThreshold = 0.2;
-
 // Create instances of the PowerMeter object.
 PowerMeter wandReading;
 PowerMeter packReading;
@@ -78,13 +124,15 @@ void packStartup(bool firstStart);
 void wandFiring();
 void wandStoppedFiring();
 void cyclotronSpeedRevert();
+void startPackVoltageSampling();
 
 // Configure and calibrate the power meter device.
 void powerMeterConfig() {
   debugln(F("Configure Power Meter"));
 
   // Custom configuration, defaults are RANGE_32V, GAIN_8_320MV, ADC_12BIT, ADC_12BIT, CONT_SH_BUS
-  monitor.configure(INA219::RANGE_16V, INA219::GAIN_1_40MV, INA219::ADC_64SAMP, INA219::ADC_64SAMP, INA219::CONT_SH_BUS);
+  // 8 samples per channel completes a conversion pair every ~8.5ms; the trigger detector and moving average provide any further smoothing.
+  monitor.configure(INA219::RANGE_16V, INA219::GAIN_1_40MV, INA219::ADC_8SAMP, INA219::ADC_8SAMP, INA219::CONT_SH_BUS);
 
   // Calibrate with our chosen values
   monitor.calibrate(SHUNT_R, SHUNT_MAX_V, BUS_MAX_V, MAX_CURRENT);
@@ -93,6 +141,7 @@ void powerMeterConfig() {
 // Initialize the power meter device on the i2c bus.
 void powerMeterInit() {
   // Configure the PowerMeter object(s).
+  wandReading.PowerReadDelay = i_power_meter_poll_delay;
   packReading.PowerReadDelay = 4000;
 
   uint8_t i_monitor_status = monitor.begin();
@@ -105,6 +154,7 @@ void powerMeterInit() {
     // Result of 0 indicates no problems from device detection.
     b_power_meter_available = true;
     powerMeterConfig();
+    METER_STEP = METER_WAIT_READY;
     wandReading.LastRead = millis(); // For use with the Ah readings.
     wandReading.ReadTimer.start(wandReading.PowerReadDelay);
   }
@@ -113,76 +163,185 @@ void powerMeterInit() {
     debugln(F("Unable to find power monitoring device on i2c."));
   }
 
-  // Always obtain a voltage reading directly from the pack PCB.
+  // Always obtain a voltage reading directly from the pack PCB, sampled in the background between reads.
+  startPackVoltageSampling();
   packReading.ReadTimer.start(packReading.PowerReadDelay);
 }
 
-// Perform a reading of values from the power meter for the wand.
+// Read a 16-bit register from the power meter, returning false if the device did not respond.
+bool readPowerMeterRegister(uint8_t i_register, uint16_t &i_value) {
+  Wire.beginTransmission(i_power_meter_address);
+  Wire.write(i_register);
+
+  if(Wire.endTransmission() != 0 || Wire.requestFrom(i_power_meter_address, (uint8_t) 2) != 2) {
+    return false;
+  }
+
+  i_value = (uint16_t) Wire.read() << 8;
+  i_value |= (uint8_t) Wire.read();
+
+  return true;
+}
+
+// Update the values for the wand from the latest raw shunt (10uV) and bus (mV) readings.
 void doWandPowerReading() {
   if(b_power_meter_available) {
     // Only uncomment this debug if absolutely needed!
     //debugln(F("Reading Power Meter"));
 
-    // Reads the latest values from the monitor.
-    wandReading.ShuntVoltage = monitor.shuntVoltage();
-    wandReading.ShuntCurrent = monitor.shuntCurrent();
-    wandReading.BusVoltage = monitor.busVoltage();
-    wandReading.BusPower = monitor.busPower();
+    wandReading.ShuntCurrent = ((int32_t)wandReading.ShuntVoltage * 100) / SHUNT_R_MO; // I(0.1mA) = V(10uV) / R
 
-    // Update the smoothed current (A) values using the latest reading using an exponential moving average.
-    wandReading.BattVoltage = wandReading.BusVoltage + wandReading.ShuntVoltage; // Total Volts
-    wandReading.RawPower = wandReading.BattVoltage * wandReading.ShuntCurrent; // P(W) = V*A
-    wandReading.AvgPower = (f_ema_alpha * wandReading.RawPower) + ((1 - f_ema_alpha) * wandReading.AvgPower);
+    // Update the smoothed power (mW) values using the latest reading using an exponential moving average.
+    wandReading.BattVoltage = wandReading.BusVoltage + (wandReading.ShuntVoltage / 100); // Total millivolts
+    wandReading.RawPower = ((int32_t)wandReading.BattVoltage * wandReading.ShuntCurrent) / 10000; // P(mW) = mV * 0.1mA / 10000
+    wandReading.AvgPower += ((((wandReading.RawPower << i_power_q_bits) - wandReading.AvgPower) * i_ema_alpha) + 128) >> 8; // Rounded
 
-    // Use time and current (A) values to calculate amp-hours consumed.
+    // Use time and current values to calculate milliamp-hours consumed.
     unsigned long i_new_time = millis();
     wandReading.ReadTick = i_new_time - wandReading.LastRead;
-    wandReading.AmpHours += (wandReading.ShuntCurrent * wandReading.ReadTick) / 3600000.0; // Div. by 1000 x 60 x 60
+    if(wandReading.ShuntCurrent > 0) {
+      wandReading.Charge += (uint32_t)wandReading.ShuntCurrent * wandReading.ReadTick;
+      while(wandReading.Charge >= i_charge_per_mah) {
+        wandReading.Charge -= i_charge_per_mah;
+        wandReading.MilliAmpHours++;
+      }
+    }
     wandReading.LastRead = i_new_time;
+  }
+}
+
+/**
+ * Pack Voltage Sampling
+ * The bandgap is measured against AVcc by the ADC in the background: a burst of free-running conversions is
+ * accumulated by the ADC interrupt, which stops the free-running conversions once the burst is complete. The ADC
+ * stays enabled but idle until the next burst is started. The loop only collects the finished sum, so it never
+ * waits on a conversion. Oversampling 64 conversions adds 3 bits of resolution and averages out the noise of any
+ * single reading. Nothing else on the pack uses the ADC.
+ */
+const uint16_t i_bandgap_reference = 1115; // Adjust this value to your board's specific internal BG voltage x1000 (mV).
+const uint8_t i_pack_voltage_samples = 64; // Conversions accumulated per reading.
+const uint8_t i_pack_voltage_settle = 4; // Conversions discarded while the bandgap settles after being selected.
+volatile uint16_t i_pack_voltage_sum = 0; // Sum of the accumulated conversions (64 x 1023 fits in 16 bits).
+volatile uint8_t i_pack_voltage_count = 0; // Conversions completed in the current burst, including those discarded.
+volatile bool b_pack_voltage_ready = false; // Set by the ADC interrupt when the burst is complete.
+
+ISR(ADC_vect) {
+  uint16_t i_sample = ADC;
+
+  if(i_pack_voltage_count >= i_pack_voltage_settle) {
+    i_pack_voltage_sum += i_sample;
+  }
 
-    // Prepare for next read -- this is security just in case the INA219 is reset by transient current.
-    monitor.recalibrate();
-    monitor.reconfig();
+  if(++i_pack_voltage_count >= i_pack_voltage_settle + i_pack_voltage_samples) {
+    // Stop free-running; the conversion already under way finishes without raising another interrupt.
+    ADCSRA &= ~(_BV(ADATE) | _BV(ADIE));
+    b_pack_voltage_ready = true;
   }
 }
 
+// Start a background burst of bandgap conversions.
+void startPackVoltageSampling() {
+  // REFS1 REFS0                    --> 0 1, AVcc internal ref. -Selects AVcc reference
+  // MUX5 MUX4 MUX3 MUX2 MUX1 MUX0  --> 011110 1.1V (VBG)       -Selects channel 30, bandgap voltage, to measure
+  ADMUX = (0<<REFS1) | (1<<REFS0) | (0<<ADLAR) | (1<<MUX4) | (1<<MUX3) | (1<<MUX2) | (1<<MUX1) | (0<<MUX0);
+  ADCSRB &= ~(_BV(MUX5) | _BV(ADTS2) | _BV(ADTS1) | _BV(ADTS0)); // Upper mux bit clear, auto-trigger in free-running mode.
+
+  i_pack_voltage_sum = 0;
+  i_pack_voltage_count = 0;
+  b_pack_voltage_ready = false;
+
+  // Clear any stale completion flag, then start converting with the interrupt enabled.
+  ADCSRA |= _BV(ADEN) | _BV(ADIF) | _BV(ADATE) | _BV(ADIE) | _BV(ADSC);
+}
+
 // Sourced from https://community.particle.io/t/battery-voltage-checking/5467
 // Obtains the ATMega chip's actual Vcc voltage value, using internal bandgap reference.
 // This demonstrates ability to read MCU's Vcc voltage and the ability to maintain A/D calibration with changing Vcc.
-void doPackVoltageReading() {
-  // REFS1 REFS0               --> 0 1, AVcc internal ref. -Selects AVcc reference
-  // MUX4 MUX3 MUX2 MUX1 MUX0  --> 11110 1.1V (VBG)        -Selects channel 30, bandgap voltage, to measure
-  ADMUX = (0<<REFS1) | (1<<REFS0) | (0<<ADLAR)| (0<<MUX5) | (1<<MUX4) | (1<<MUX3) | (1<<MUX2) | (1<<MUX1) | (0<<MUX0);
+// Returns true when a new value is available from the last burst of conversions.
+bool doPackVoltageReading() {
+  if(!b_pack_voltage_ready) {
+    // The previous burst is still running (or none was started), so keep the last value.
+    return false;
+  }
 
-  // This appears to work without the delay, but for more accurate readings it may be necessary.
-  // delay(50); // Let mux settle a little to get a more stable A/D conversion.
+  // The interrupt is disabled once ready, so the sum can be read without a race.
+  // Vcc = Vbg x 1023 / ADC, where the mean ADC value is the sum divided by the sample count.
+  if(i_pack_voltage_sum > 0) {
+    packReading.BusVoltage = ((uint32_t)i_bandgap_reference * 1023UL * i_pack_voltage_samples) / i_pack_voltage_sum; // mV
+  }
 
-  ADCSRA |= _BV( ADSC ); // Start a conversion.
-  while( ( (ADCSRA & (1<<ADSC)) != 0 ) ); // Wait for conversion to complete...
+  startPackVoltageSampling();
 
-  // Scale the value, which returns the actual value of Vcc x 100
-  const long InternalReferenceVoltage = 1115L; // Adjust this value to your boards specific internal BG voltage x1000.
-  packReading.BusVoltage = (((InternalReferenceVoltage * 1023L) / ADC) + 5L) / 10L; // Calculates for straight line value.
+  return true;
 }
 
 // Perform a reading of values from the power meter for the pack.
-void doPackPowerReading() {
+bool doPackPowerReading() {
   // Obtain bandgap voltage from the microcontroller.
-  doPackVoltageReading();
+  return doPackVoltageReading();
+}
+
+// Select the power level profile whose idle range covers the given idle current.
+uint8_t wandIdleLevel(int16_t i_idle_current) {
+  for(uint8_t i = 0; i < 4; i++) {
+    if(i_idle_current <= (int16_t) PROGMEM_READU16(i_wand_idle_current_max[i])) {
+      return i;
+    }
+  }
+
+  return 4;
+}
+
+// Detect the start and end of firing from each new current sample of a powered stock wand.
+void checkWandFiringCurrent() {
+  uint8_t i_level = wandIdleLevel(wandReading.IdleCurrent);
+  int16_t i_threshold = ((int16_t) PROGMEM_READU16(i_wand_idle_current_max[i_level]) + (int16_t) PROGMEM_READU16(i_wand_fire_current_min[i_level])) / 2;
+  int16_t i_excess = wandReading.ShuntCurrent - i_threshold;
+
+  if(!wandState.firing) {
+    wandReading.FireSum = constrain(wandReading.FireSum + i_excess, 0, i_wand_fire_cusum_limit);
+
+    if(wandReading.FireSum >= i_wand_fire_cusum_limit) {
+      // Current rose clearly above the idle profile, which means the wand is firing (via intensify only).
+      wandReading.FireSum = 0;
+      wandReading.StopSum = 0;
+      i_wand_power_level = 5;
+      wandState.firingIntensify = true;
+      wandFiring();
+    }
+    else if(wandReading.FireSum == 0) {
+      // Only follow the idle baseline while no rise is pending.
+      wandReading.IdleCurrent += (wandReading.ShuntCurrent - wandReading.IdleCurrent) >> 3;
+    }
+  }
+  else {
+    wandReading.StopSum = constrain(wandReading.StopSum - i_excess, 0, i_wand_fire_cusum_limit);
+
+    if(wandReading.StopSum >= i_wand_fire_cusum_limit) {
+      // Current fell back to the idle profile, which means the wand stopped firing.
+      wandReading.StopSum = 0;
+      wandReading.FireSum = 0;
+      wandStoppedFiring();
+
+      // Return cyclotron to normal speed.
+      cyclotronSpeedRevert();
+    }
+  }
 }
 
 // Take actions based on current power state, specifically when there is no GPStar Neutrona Wand connected.
 void updateWandPowerState() {
   static uint8_t si_update; // Static var to keep up with update requests for responding to the latest readings.
-  si_update = (si_update + 1) % 20; // Keep a count of updates, rolling over every 20th time.
+  si_update = (si_update + 1) % 40; // Keep a count of updates, rolling over every 40th time.
 
   // Only take action to read power consumption when wand is NOT connected (or syncing).
-  if (!b_wand_connected && !b_wand_syncing) {
+  if (!wandState.connected && !wandState.syncing) {
     /**
      * Amperage Ranges
      * Note there is some slight overlap between the highest power levels at idle and the lowest firing states.
      * Because of this, we cannot simply assume a value which falls into any given range is a specific event,
      * and we must use a state-change check based on a significant AND sustained change in amperage drawn.
+     * Power on/off uses the smoothed power; firing uses the faster per-level profiles in checkWandFiringCurrent().
      *
      * Level 1 Idle: 0.13-0.15A
      * Level 2 Idle: 0.14-0.18A
@@ -196,11 +355,11 @@ void updateWandPowerState() {
      * Level 4 Fire: 0.30-0.35A
      * Level 5 Fire: 0.34-0.45A
      */
-    float f_avg_power = wandReading.AvgPower;
+    int32_t i_avg_power = wandReading.AvgPower;
     unsigned long current_time = millis();
     unsigned long change_time;
-    bool b_state_change_lower = f_avg_power < wandReading.LastAverage - (PowerMeter::StateChangeThreshold * 1.4);
-    bool b_state_change_higher = f_avg_power > wandReading.LastAverage + PowerMeter::StateChangeThreshold;
+    bool b_state_change_lower = i_avg_power < wandReading.LastAverage - ((PowerMeter::StateChangeThreshold * 7) / 5);
+    bool b_state_change_higher = i_avg_power > wandReading.LastAverage + PowerMeter::StateChangeThreshold;
 
     // Check for a significant and sustained change in current (either higher or lower than the last state).
     if(b_state_change_lower || b_state_change_higher) {
@@ -213,11 +372,18 @@ void updateWandPowerState() {
       change_time = current_time - wandReading.StateChanged;
       if(change_time >= PowerMeter::StateChangeDuration) {
         // Update previous average current reading since we've had a sustained change in state.
-        wandReading.LastAverage = f_avg_power;
+        wandReading.LastAverage = i_avg_power;
 
         // Wand is considered "on" when above the base threshold.
-        if(f_avg_power > f_wand_power_on_threshold) {
-          b_wand_on = true;
+        if(i_avg_power > i_wand_power_on_threshold) {
+          if(!wandState.on) {
+            // Start the idle baseline for the firing detector from the current draw at power-on.
+            wandReading.IdleCurrent = wandReading.ShuntCurrent;
+            wandReading.FireSum = 0;
+            wandReading.StopSum = 0;
+          }
+
+          wandState.on = true;
 
           // Turn the pack on.
           if(PACK_STATE != MODE_ON) {
@@ -235,24 +401,6 @@ void updateWandPowerState() {
             ms_powerup_debounce.start(f_wand_power_up_delay);
           }
         }
-
-        // If the wand and pack are considered "on" then determine whether firing or not.
-        if(b_wand_on && PACK_STATE != MODE_OFF) {
-          if(b_state_change_higher && !b_wand_firing && ms_powerup_debounce.remaining() < 1) {
-            // State change was higher as means the wand is firing (via intensify only).
-            i_wand_power_level = 5;
-            b_firing_intensify = true;
-            wandFiring();
-          }
-
-          if(b_state_change_lower && b_wand_firing) {
-            // State change was lower as means the wand stopped firing.
-            wandStoppedFiring();
-
-            // Return cyclotron to normal speed.
-            cyclotronSpeedRevert();
-          }
-        }
       }
     }
     else {
@@ -260,22 +408,27 @@ void updateWandPowerState() {
       wandReading.StateChanged = 0;
     }
 
+    // If the wand and pack are considered "on" then determine whether firing or not, on every sample.
+    if(wandState.on && PACK_STATE != MODE_OFF && ms_powerup_debounce.remaining() < 1) {
+      checkWandFiringCurrent();
+    }
+
     // Every X updates send the averaged, stable value which would determine a state change.
     // This is called whenever the power meter is available--for wand hot-swapping purposes.
-    // Data is sent as integer so this is sent multiplied by 100 to get 2 decimal precision.
+    // Data is sent as integer so this is sent as watts multiplied by 100 to get 2 decimal precision.
     if(si_update == 0) {
-      serial1Send(A_WAND_POWER_AMPS, f_avg_power * 100);
+      serial1Send(A_WAND_POWER_AMPS, (i_avg_power >> i_power_q_bits) / 10);
     }
 
     // If the pack is currently off, or the wand has not been directly powered on, just leave immediately.
-    if(PACK_STATE == MODE_OFF || !b_wand_on) {
+    if(PACK_STATE == MODE_OFF || !wandState.on) {
       b_pack_started_by_meter = false; // Make sure this is kept as false since the wand is not powered.
       return;
     }
 
     // If the wand was powered on via the power meter, then stop firing and turn off the pack if below the power threshold.
-    if(b_wand_on && f_avg_power <= f_wand_power_on_threshold) {
-      if(b_wand_firing) {
+    if(wandState.on && i_avg_power <= i_wand_power_on_threshold) {
+      if(wandState.firing) {
         // Stop firing sequence if previously firing.
         wandStoppedFiring();
 
@@ -283,7 +436,7 @@ void updateWandPowerState() {
         cyclotronSpeedRevert();
       }
 
-      b_wand_on = false;
+      wandState.on = false;
 
       // Turn the pack off.
       if(PACK_STATE != MODE_OFF) {
@@ -294,7 +447,7 @@ void updateWandPowerState() {
 
       // Reset the state change timer and last average due to this significant event.
       wandReading.StateChanged = 0;
-      wandReading.LastAverage = f_avg_power;
+      wandReading.LastAverage = i_avg_power;
     }
   }
   else {
@@ -305,7 +458,7 @@ void updateWandPowerState() {
     // If previously started via the power meter but a GPStar wand is connected,
     // then we need to power down the pack immediately as this was unintended.
     if(b_pack_started_by_meter && PACK_STATE != MODE_OFF) {
-      b_wand_on = false;
+      wandState.on = false;
       b_pack_started_by_meter = false;
       PACK_ACTION_STATE = ACTION_OFF;
       serial1Send(A_PACK_OFF);
@@ -318,8 +471,8 @@ void updateWandPowerState() {
 // Send latest voltage value to the serial1 device, if connected.
 void updatePackPowerState() {
   if(b_serial1_connected) {
-    // Data is sent as uint16_t so this is already multiplied by 100 to get 2 decimal precision.
-    serial1Send(A_BATTERY_VOLTAGE_PACK, packReading.BusVoltage);
+    // Data is sent as uint16_t so this is volts multiplied by 100 to get 2 decimal precision.
+    serial1Send(A_BATTERY_VOLTAGE_PACK, (packReading.BusVoltage + 5) / 10);
   }
 }
 
@@ -327,57 +480,108 @@ void updatePackPowerState() {
 // Turn on the Serial Plotter in the ArduinoIDE to view graphed results.
 void wandPowerDisplay() {
   if(b_power_meter_available && b_show_power_data) {
-    // Serial.print(F("W.Shunt(mV):"));
+    // Serial.print(F("W.Shunt(10uV):"));
     // Serial.print(wandReading.ShuntVoltage);
     // Serial.print(F(","));
 
-    // Serial.print(F("W.Shunt(A):"));
+    // Serial.print(F("W.Shunt(0.1mA):"));
     // Serial.print(wandReading.ShuntCurrent);
     // Serial.print(F(","));
 
-    Serial.print(F("W.Raw(W):"));
+    Serial.print(F("W.Raw(mW):"));
     Serial.print(wandReading.RawPower);
     Serial.print(F(","));
 
-    // Serial.print(F("W.Bus(V)):"));
+    // Serial.print(F("W.Bus(mV)):"));
     // Serial.print(wandReading.BusVoltage);
     // Serial.print(F(","));
 
-    // Serial.print(F("W.Bus(W)):"));
-    // Serial.print(wandReading.BusPower);
-    // Serial.print(F(","));
-
-    // Serial.print(F("W.Batt(V):"));
+    // Serial.print(F("W.Batt(mV):"));
     // Serial.print(wandReading.BattVoltage);
     // Serial.print(F(","));
 
-    // Serial.print(F("W.AmpHours:"));
-    // Serial.print(wandReading.AmpHours);
+    // Serial.print(F("W.MilliAmpHours:"));
+    // Serial.print(wandReading.MilliAmpHours);
     // Serial.print(F(","));
 
-    Serial.print(F("W.AvgPow(W):"));
-    Serial.print(wandReading.AvgPower);
+    Serial.print(F("W.AvgPow(mW):"));
+    Serial.print(wandReading.AvgPower >> i_power_q_bits);
     Serial.print(F(","));
 
     Serial.print(F("W.State:"));
-    Serial.println(wandReading.LastAverage);
+    Serial.println(wandReading.LastAverage >> i_power_q_bits);
+  }
+}
+
+// Advance the wand power meter by one i2c transaction, acting on each completed conversion.
+void checkWandPowerMeter() {
+  uint16_t i_register = 0;
+
+  switch(METER_STEP) {
+    case METER_WAIT_READY:
+    default:
+      if(!wandReading.ReadTimer.justFinished()) {
+        // Not yet time to poll; a conversion takes several times longer than this interval.
+        return;
+      }
+
+      wandReading.ReadTimer.start(wandReading.PowerReadDelay);
+
+      // Bits 15-3 hold the bus voltage in 4mV steps; bit 1 is set when a new conversion is ready.
+      if(readPowerMeterRegister(INA219_BUS_VOLTAGE, i_register) && (i_register & 0x0002)) {
+        wandReading.BusVoltage = (i_register >> 3) * 4;
+        METER_STEP = METER_READ_SHUNT;
+      }
+    break;
+
+    case METER_READ_SHUNT:
+      if(readPowerMeterRegister(INA219_SHUNT_VOLTAGE, i_register)) {
+        wandReading.ShuntVoltage = (int16_t) i_register;
+
+        doWandPowerReading(); // Update the V/A values.
+        wandPowerDisplay(); // Show values on serial plotter.
+        updateWandPowerState(); // Take action on V/A values.
+      }
+
+      METER_STEP = METER_CLEAR_READY;
+    break;
+
+    case METER_CLEAR_READY:
+      readPowerMeterRegister(INA219_POWER, i_register);
+
+      // A reset is rare, so only look for one periodically to leave the bus free for new conversions.
+      if(++i_power_meter_conversions >= i_power_meter_reset_interval) {
+        i_power_meter_conversions = 0;
+        METER_STEP = METER_CHECK_RESET;
+      }
+      else {
+        METER_STEP = METER_WAIT_READY;
+      }
+    break;
+
+    case METER_CHECK_RESET:
+      if(readPowerMeterRegister(INA219_CALIBRATION, i_register) && i_register == 0) {
+        // The INA219 was reset by a transient, so restore the calibration and configuration.
+        debugln(F("Power Meter Reset Detected"));
+        monitor.recalibrate();
+        monitor.reconfig();
+      }
+
+      METER_STEP = METER_WAIT_READY;
+    break;
   }
 }
 
 // Check the available timers for reading power meter data.
 void checkPowerMeter() {
-  if(wandReading.ReadTimer.justFinished()) {
-    if(b_power_meter_available) {
-      doWandPowerReading(); // Get latest V/A readings.
-      wandPowerDisplay(); // Show values on serial plotter.
-      updateWandPowerState(); // Take action on V/A values.
-      wandReading.ReadTimer.start(wandReading.PowerReadDelay);
-    }
+  if(b_power_meter_available) {
+    checkWandPowerMeter(); // Get latest V/A readings and act on them.
   }
 
   if(packReading.ReadTimer.justFinished()) {
-      doPackPowerReading(); // Get latest voltage reading.
-      updatePackPowerState(); // Take action on V/A values.
+      if(doPackPowerReading()) {
+        updatePackPowerState(); // Take action on V/A values.
+      }
       packReading.ReadTimer.start(packReading.PowerReadDelay);
   }
 }
\ No newline at end of file
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <stddef.h>
+
 /*
  * User Preference Storage/Retrieval via EEPROM
  *
@@ -38,18 +40,12 @@ void clearConfigEEPROM();
 void clearLEDEEPROM();
 void saveConfigEEPROM();
 void saveLEDEEPROM();
-void updateCRCEEPROM();
 uint32_t eepromCRC(void);
 void resetCyclotronLEDs();
 void resetInnerCyclotronLEDs();
 void resetContinuousSmoke();
 void updateProtonPackLEDCounts();
 
-/*
- * General EEPROM Variables
- */
-uint16_t i_eepromAddress = 0; // The address in the EEPROM to start reading from.
-
 /*
  * Data structure object for LED settings which are saved into the EEPROM memory.
  */
@@ -104,453 +100,557 @@ struct objConfigEEPROM {
 };
 
 /*
- * Read all user preferences from Proton Pack controller EEPROM.
+ * EEPROM Preference Journal
+ *
+ * Rather than rewriting the same bytes at address 0, each save appends a record (header, object and
+ * its own CRC32) to the next slot of a ring spanning the EEPROM. At boot only the slot headers are
+ * scanned to find the newest record of each kind, and older copies are used only if its CRC fails.
+ * An interrupted save therefore loses only that save, and a save which changes nothing writes nothing.
  */
-void readEEPROM() {
-  // Get the stored CRC from the EEPROM.
-  uint32_t l_crc_check;
-  EEPROM.get(EEPROM.length() - sizeof(eepromCRC()), l_crc_check);
+enum EEPROM_RECORDS { EEPROM_RECORD_CONFIG, EEPROM_RECORD_LED, EEPROM_RECORD_KINDS };
+const uint8_t i_eeprom_record_tag = 0xA0; // Stored as (tag + kind) so records stand apart from erased or legacy bytes.
+const uint8_t i_eeprom_record_length[EEPROM_RECORD_KINDS] = { sizeof(objConfigEEPROM), sizeof(objLEDEEPROM) };
+const uint16_t i_eeprom_no_slot = 0xFFFF;
+
+struct objEEPROMRecordHeader {
+  uint8_t tag;       // i_eeprom_record_tag + the record kind.
+  uint8_t length;    // Size of the object which follows the header.
+  uint32_t sequence; // Incremented for every record written; the highest is the newest. Too wide to wrap within the EEPROM's write endurance.
+};
 
-  // Check if the calculated CRC matches the stored CRC value in the EEPROM.
-  if(eepromCRC() == l_crc_check) {
-    // Read our LED object from the EEPROM.
-    objLEDEEPROM obj_eeprom;
-    EEPROM.get(i_eepromAddress, obj_eeprom);
-
-    if(obj_eeprom.powercell_count > 0 && obj_eeprom.powercell_count != 255) {
-      i_powercell_leds = obj_eeprom.powercell_count;
-
-      switch(i_powercell_leds) {
-        case FRUTTO_POWERCELL_LED_COUNT:
-          // 15 Power Cell LEDs.
-          i_powercell_delay_1984 = POWERCELL_DELAY_1984_15_LED;
-          i_powercell_delay_2021 = POWERCELL_DELAY_2021_15_LED;
-        break;
-
-        case HASLAB_POWERCELL_LED_COUNT:
-        default:
-          // 13 Power Cell LEDs.
-          i_powercell_delay_1984 = POWERCELL_DELAY_1984_13_LED;
-          i_powercell_delay_2021 = POWERCELL_DELAY_2021_13_LED;
-        break;
-      }
-    }
-    else if(!b_power_meter_available) {
-      // If no EEPROM default set and not using a stock wand, assume Frutto upgrades instead.
-      i_powercell_leds = FRUTTO_POWERCELL_LED_COUNT;
-      i_powercell_delay_1984 = POWERCELL_DELAY_1984_15_LED;
-      i_powercell_delay_2021 = POWERCELL_DELAY_2021_15_LED;
-    }
+// Every slot fits a header, the largest preference object and a CRC32.
+const uint8_t i_eeprom_slot_size = sizeof(objEEPROMRecordHeader) + max(sizeof(objConfigEEPROM), sizeof(objLEDEEPROM)) + sizeof(uint32_t);
 
-    if(obj_eeprom.cyclotron_count > 0 && obj_eeprom.cyclotron_count != 255) {
-      i_cyclotron_leds = obj_eeprom.cyclotron_count;
-    }
-    else if(!b_power_meter_available) {
-      // If no EEPROM default set and not using a stock wand, assume Frutto upgrades instead.
-      i_cyclotron_leds = FRUTTO_MAX_CYCLOTRON_LED_COUNT;
-    }
+// The last 4 bytes of the EEPROM still hold the CRC used by the single-copy layout of earlier firmware.
+const uint16_t i_eeprom_slots = (E2END + 1 - sizeof(uint32_t)) / i_eeprom_slot_size;
 
-    if(obj_eeprom.inner_cyclotron_count > 0 && obj_eeprom.inner_cyclotron_count != 255) {
-      i_inner_cyclotron_cake_num_leds = obj_eeprom.inner_cyclotron_count;
-
-      switch(i_inner_cyclotron_cake_num_leds) {
-        case 12:
-          i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_12_LED;
-          i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_12_LED;
-        break;
-
-        case 23:
-          i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_23_LED;
-          i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_23_LED;
-        break;
-
-        case 24:
-          i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_24_LED;
-          i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_24_LED;
-        break;
-
-        case 26:
-          i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_26_LED;
-          i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_26_LED;
-        break;
-
-        case 35:
-          i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_35_LED;
-          i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_35_LED;
-        break;
-
-        case 36:
-        default:
-          i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_36_LED;
-          i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_36_LED;
-        break;
-      }
-    }
+// Slots overlapping that single-copy layout, which are left alone until the journal wraps around.
+const uint16_t i_eeprom_legacy_slots = (sizeof(objConfigEEPROM) + sizeof(objLEDEEPROM) + i_eeprom_slot_size - 1) / i_eeprom_slot_size;
 
-    if(obj_eeprom.cyclotron_cavity_count > 0 && obj_eeprom.cyclotron_cavity_count != 255) {
-      if(obj_eeprom.cyclotron_cavity_count > 20) {
-        i_inner_cyclotron_cavity_num_leds = 20;
-      }
-      else {
-        i_inner_cyclotron_cavity_num_leds = obj_eeprom.cyclotron_cavity_count;
-      }
-    }
+uint16_t i_eeprom_record_slot[EEPROM_RECORD_KINDS] = { i_eeprom_no_slot, i_eeprom_no_slot }; // Slot of the newest valid record of each kind.
+uint32_t i_eeprom_sequence = 0; // Sequence number of the newest record in the journal.
+uint16_t i_eeprom_next_slot = i_eeprom_legacy_slots; // Slot which receives the next record.
 
-    if(obj_eeprom.cyclotron_cavity_type > 0 && obj_eeprom.cyclotron_cavity_type != 255) {
-      if(obj_eeprom.cyclotron_cavity_type > 1) {
-        // 2 = RGB, 3 = GRB, 4 = GBR.
-        switch(obj_eeprom.cyclotron_cavity_type) {
-          case 2:
-          default:
-            CAVITY_LED_TYPE = RGB_LED;
-          break;
-
-          case 3:
-            CAVITY_LED_TYPE = GRB_LED;
-          break;
-
-          case 4:
-            CAVITY_LED_TYPE = GBR_LED;
-          break;
-        }
-      }
-    }
+// Whether sequence number a was written after sequence number b, allowing for wrap-around.
+bool eepromSequenceNewer(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b) > 0;
+}
 
-    if(obj_eeprom.powercell_inverted > 0 && obj_eeprom.powercell_inverted != 255) {
-      if(obj_eeprom.powercell_inverted > 1) {
-        b_powercell_invert = true;
-      }
-      else {
-        b_powercell_invert = false;
-      }
-    }
+uint16_t eepromSlotAddress(uint16_t i_slot) {
+  return i_slot * i_eeprom_slot_size;
+}
 
-    if(obj_eeprom.inner_cyclotron_led_panel > 0 && obj_eeprom.inner_cyclotron_led_panel != 255) {
-      if(obj_eeprom.inner_cyclotron_led_panel > 1) {
-        // 2 = Individual, 3 = RGB Static, 4 = RGB Dynamic.
-        switch(obj_eeprom.inner_cyclotron_led_panel) {
-          case 2:
-          default:
-            INNER_CYC_PANEL_MODE = PANEL_INDIVIDUAL;
-          break;
-
-          case 3:
-            INNER_CYC_PANEL_MODE = PANEL_RGB_STATIC;
-          break;
-
-          case 4:
-            INNER_CYC_PANEL_MODE = PANEL_RGB_DYNAMIC;
-          break;
-        }
-      }
-    }
+// Whether a slot header describes a record of the given kind.
+bool eepromRecordMatches(const objEEPROMRecordHeader &header, uint8_t i_kind) {
+  return header.tag == i_eeprom_record_tag + i_kind && header.length == i_eeprom_record_length[i_kind];
+}
 
-    if(obj_eeprom.grb_inner_cyclotron > 0 && obj_eeprom.grb_inner_cyclotron != 255) {
-      if(obj_eeprom.grb_inner_cyclotron > 1) {
-        CAKE_LED_TYPE = GRB_LED;
-      }
-      else {
-        CAKE_LED_TYPE = RGB_LED;
-      }
-    }
+// Calculate the CRC32 for a record header and the object which follows it.
+uint32_t eepromRecordCRC(const objEEPROMRecordHeader &header, const uint8_t *p_data) {
+  CRC32 crc;
+  const uint8_t *p_header = (const uint8_t*) &header;
 
-    if(obj_eeprom.powercell_spectral_custom > 0 && obj_eeprom.powercell_spectral_custom != 255) {
-      i_spectral_powercell_custom_colour = obj_eeprom.powercell_spectral_custom;
-    }
+  for(uint8_t i = 0; i < sizeof(objEEPROMRecordHeader); i++) {
+    crc.update(p_header[i]);
+  }
 
-    if(obj_eeprom.cyclotron_spectral_custom > 0 && obj_eeprom.cyclotron_spectral_custom != 255) {
-      i_spectral_cyclotron_custom_colour = obj_eeprom.cyclotron_spectral_custom;
-    }
+  for(uint8_t i = 0; i < header.length; i++) {
+    crc.update(p_data[i]);
+  }
 
-    if(obj_eeprom.cyclotron_inner_spectral_custom > 0 && obj_eeprom.cyclotron_inner_spectral_custom != 255) {
-      i_spectral_cyclotron_inner_custom_colour = obj_eeprom.cyclotron_inner_spectral_custom;
-    }
+  return (uint32_t)crc.finalize();
+}
 
-    if(obj_eeprom.powercell_spectral_saturation_custom > 0 && obj_eeprom.powercell_spectral_saturation_custom != 255) {
-      i_spectral_powercell_custom_saturation = obj_eeprom.powercell_spectral_saturation_custom;
-    }
+// Copy the object held by a slot into a buffer and check it against the CRC stored with it.
+bool readEEPROMRecord(uint16_t i_slot, uint8_t *p_data) {
+  uint16_t i_address = eepromSlotAddress(i_slot);
+  objEEPROMRecordHeader header;
+  uint32_t l_crc_check;
 
-    if(obj_eeprom.cyclotron_spectral_saturation_custom > 0 && obj_eeprom.cyclotron_spectral_saturation_custom != 255) {
-      i_spectral_cyclotron_custom_saturation = obj_eeprom.cyclotron_spectral_saturation_custom;
-    }
+  EEPROM.get(i_address, header);
+  i_address += sizeof(objEEPROMRecordHeader);
 
-    if(obj_eeprom.cyclotron_inner_spectral_saturation_custom > 0 && obj_eeprom.cyclotron_inner_spectral_saturation_custom != 255) {
-      i_spectral_cyclotron_inner_custom_saturation = obj_eeprom.cyclotron_inner_spectral_saturation_custom;
-    }
+  for(uint8_t i = 0; i < header.length; i++) {
+    p_data[i] = EEPROM.read(i_address + i);
+  }
 
-    // Update the LED counts for the Proton Pack.
-    resetCyclotronLEDs();
-    resetInnerCyclotronLEDs();
-    updateProtonPackLEDCounts();
+  EEPROM.get(i_address + header.length, l_crc_check);
 
-    // Read our configuration object from the EEPROM.
-    objConfigEEPROM obj_config_eeprom;
-    uint16_t i_eepromConfigAddress = i_eepromAddress + sizeof(objLEDEEPROM);
+  return eepromRecordCRC(header, p_data) == l_crc_check;
+}
 
-    EEPROM.get(i_eepromConfigAddress, obj_config_eeprom);
+// Find the newest record of a kind with an intact CRC, falling back to older copies if necessary.
+uint16_t findEEPROMRecord(uint8_t i_kind, uint8_t *p_data) {
+  bool b_bounded = false;
+  uint32_t i_older_than = 0;
 
-    if(obj_config_eeprom.stream_effects > 0 && obj_config_eeprom.stream_effects != 255) {
-      if(obj_config_eeprom.stream_effects > 1) {
-        b_stream_effects = true;
-      }
-      else {
-        b_stream_effects = false;
-      }
-    }
+  for(uint16_t i_attempt = 0; i_attempt < i_eeprom_slots; i_attempt++) {
+    uint16_t i_best_slot = i_eeprom_no_slot;
+    uint32_t i_best_sequence = 0;
 
-    if(obj_config_eeprom.cyclotron_direction > 0 && obj_config_eeprom.cyclotron_direction != 255) {
-      if(obj_config_eeprom.cyclotron_direction > 1) {
-        b_clockwise = true;
-      }
-      else {
-        b_clockwise = false;
-      }
-    }
+    for(uint16_t i_slot = 0; i_slot < i_eeprom_slots; i_slot++) {
+      objEEPROMRecordHeader header;
+      EEPROM.get(eepromSlotAddress(i_slot), header);
 
-    if(obj_config_eeprom.center_led_fade > 0 && obj_config_eeprom.center_led_fade != 255) {
-      if(obj_config_eeprom.center_led_fade > 1) {
-        b_fade_cyclotron_led = true;
+      if(!eepromRecordMatches(header, i_kind) || (b_bounded && !eepromSequenceNewer(i_older_than, header.sequence))) {
+        continue;
       }
-      else {
-        b_fade_cyclotron_led = false;
-      }
-    }
 
-    if(obj_config_eeprom.simulate_ring > 0 && obj_config_eeprom.simulate_ring != 255) {
-      if(obj_config_eeprom.simulate_ring > 1) {
-        b_cyclotron_simulate_ring = true;
-      }
-      else {
-        b_cyclotron_simulate_ring = false;
+      if(i_best_slot == i_eeprom_no_slot || eepromSequenceNewer(header.sequence, i_best_sequence)) {
+        i_best_slot = i_slot;
+        i_best_sequence = header.sequence;
       }
     }
 
-    if(obj_config_eeprom.smoke_setting > 0 && obj_config_eeprom.smoke_setting != 255) {
-      if(obj_config_eeprom.smoke_setting > 1) {
-        b_smoke_enabled = true;
-      }
-      else {
-        b_smoke_enabled = false;
-      }
+    if(i_best_slot == i_eeprom_no_slot || readEEPROMRecord(i_best_slot, p_data)) {
+      return i_best_slot;
     }
 
-    if(obj_config_eeprom.overheat_strobe > 0 && obj_config_eeprom.overheat_strobe != 255) {
-      if(obj_config_eeprom.overheat_strobe > 1) {
-        b_overheat_strobe = true;
-      }
-      else {
-        b_overheat_strobe = false;
-      }
-    }
+    // That record was torn or corrupted, so try the next newest copy.
+    b_bounded = true;
+    i_older_than = i_best_sequence;
+  }
 
-    if(obj_config_eeprom.overheat_lights_off > 0 && obj_config_eeprom.overheat_lights_off != 255) {
-      if(obj_config_eeprom.overheat_lights_off > 1) {
-        b_overheat_lights_off = true;
-      }
-      else {
-        b_overheat_lights_off = false;
-      }
-    }
+  return i_eeprom_no_slot;
+}
 
-    if(obj_config_eeprom.overheat_sync_to_fan > 0 && obj_config_eeprom.overheat_sync_to_fan != 255) {
-      if(obj_config_eeprom.overheat_sync_to_fan > 1) {
-        b_overheat_sync_to_fan = true;
-      }
-      else {
-        b_overheat_sync_to_fan = false;
+// Locate the newest record of each kind and the slot which the next record will be written to.
+void scanEEPROMJournal() {
+  bool b_found = false;
+
+  for(uint16_t i_slot = 0; i_slot < i_eeprom_slots; i_slot++) {
+    objEEPROMRecordHeader header;
+    EEPROM.get(eepromSlotAddress(i_slot), header);
+
+    for(uint8_t i_kind = 0; i_kind < EEPROM_RECORD_KINDS; i_kind++) {
+      if(eepromRecordMatches(header, i_kind) && (!b_found || eepromSequenceNewer(header.sequence, i_eeprom_sequence))) {
+        b_found = true;
+        i_eeprom_sequence = header.sequence;
+        i_eeprom_next_slot = (i_slot + 1) % i_eeprom_slots;
       }
     }
+  }
+}
 
-    if(obj_config_eeprom.year_mode > 1 && obj_config_eeprom.year_mode != 255) {
-      // 1 = toggle switch, 2 = 1984, 3 = 1989, 4 = Afterlife, 5 = Frozen Empire.
-      switch(obj_config_eeprom.year_mode) {
-        case 2:
-          SYSTEM_YEAR = SYSTEM_1984;
-        break;
-
-        case 3:
-          SYSTEM_YEAR = SYSTEM_1989;
-        break;
-
-        case 4:
-        default:
-          SYSTEM_YEAR = SYSTEM_AFTERLIFE;
-        break;
-
-        case 5:
-          SYSTEM_YEAR = SYSTEM_FROZEN_EMPIRE;
-        break;
-      }
+// Append a record for an object, unless the newest record of that kind already holds the same data.
+void writeEEPROMRecord(uint8_t i_kind, const uint8_t *p_data) {
+  uint8_t i_length = i_eeprom_record_length[i_kind];
+  uint16_t i_current = i_eeprom_record_slot[i_kind];
 
-      // Update additional variables once the system year is set from the stored EEPROM preferences.
-      SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
-      SYSTEM_EEPROM_YEAR = SYSTEM_YEAR;
+  if(i_current != i_eeprom_no_slot) {
+    uint16_t i_address = eepromSlotAddress(i_current) + sizeof(objEEPROMRecordHeader);
+    bool b_changed = false;
 
-      // Set the switch override to true, so the toggle switch in the Proton Pack does not override the year settings during the bootup process.
-      b_switch_mode_override = true;
+    for(uint8_t i = 0; i < i_length && !b_changed; i++) {
+      b_changed = EEPROM.read(i_address + i) != p_data[i];
     }
 
-    if(obj_config_eeprom.system_mode > 0 && obj_config_eeprom.system_mode != 255) {
-      if(obj_config_eeprom.system_mode > 1) {
-        SYSTEM_MODE = MODE_ORIGINAL;
-      }
-      else {
-        SYSTEM_MODE = MODE_SUPER_HERO;
-      }
+    if(!b_changed) {
+      return;
     }
+  }
 
-    if(obj_config_eeprom.vg_powercell > 0 && obj_config_eeprom.vg_powercell != 255) {
-      if(obj_config_eeprom.vg_powercell > 1) {
-        b_powercell_colour_toggle = true;
-      }
-      else {
-        b_powercell_colour_toggle = false;
-      }
-    }
+  // Never overwrite the newest record of any kind.
+  uint16_t i_slot = i_eeprom_next_slot;
+  bool b_in_use = true;
 
-    if(obj_config_eeprom.vg_cyclotron > 0 && obj_config_eeprom.vg_cyclotron != 255) {
-      if(obj_config_eeprom.vg_cyclotron > 1) {
-        b_cyclotron_colour_toggle = true;
-      }
-      else {
-        b_cyclotron_colour_toggle = false;
-      }
-    }
+  while(b_in_use) {
+    b_in_use = false;
 
-    if(obj_config_eeprom.demo_light_mode > 0 && obj_config_eeprom.demo_light_mode != 255) {
-      if(obj_config_eeprom.demo_light_mode > 1) {
-        b_demo_light_mode = true;
-      }
-      else {
-        b_demo_light_mode = false;
+    for(uint8_t i_kind_check = 0; i_kind_check < EEPROM_RECORD_KINDS; i_kind_check++) {
+      if(i_eeprom_record_slot[i_kind_check] == i_slot) {
+        b_in_use = true;
       }
     }
 
-    if(obj_config_eeprom.use_ribbon_cable > 0 && obj_config_eeprom.use_ribbon_cable != 255) {
-      if(obj_config_eeprom.use_ribbon_cable > 1) {
-        b_use_ribbon_cable = true;
-      }
-      else {
-        b_use_ribbon_cable = false;
-      }
+    if(b_in_use) {
+      i_slot = (i_slot + 1) % i_eeprom_slots;
     }
+  }
 
-    if(obj_config_eeprom.cyclotron_three_led_toggle > 0 && obj_config_eeprom.cyclotron_three_led_toggle != 255) {
-      if(obj_config_eeprom.cyclotron_three_led_toggle > 1) {
-        b_cyclotron_single_led = false;
-      }
-      else {
-        b_cyclotron_single_led = true;
-      }
-    }
+  objEEPROMRecordHeader header = { (uint8_t)(i_eeprom_record_tag + i_kind), i_length, i_eeprom_sequence + 1 };
+  uint16_t i_address = eepromSlotAddress(i_slot);
 
-    if(obj_config_eeprom.default_system_volume > 0 && obj_config_eeprom.default_system_volume <= 101) {
-      // EEPROM value is from 1 to 101; subtract 1 to get the correct percentage.
-      i_volume_master_percentage = obj_config_eeprom.default_system_volume - 1;
-      i_volume_master_eeprom = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * i_volume_master_percentage / 100);
-      i_volume_revert = i_volume_master_eeprom;
-      i_volume_master = i_volume_master_eeprom;
-    }
+  EEPROM.put(i_address, header);
 
-    if(obj_config_eeprom.overheat_smoke_duration_level_5 > 0 && obj_config_eeprom.overheat_smoke_duration_level_5 != 255) {
-      i_ms_overheating_length_5 = obj_config_eeprom.overheat_smoke_duration_level_5 * 1000;
-    }
+  for(uint8_t i = 0; i < i_length; i++) {
+    EEPROM.update(i_address + sizeof(objEEPROMRecordHeader) + i, p_data[i]);
+  }
 
-    if(obj_config_eeprom.overheat_smoke_duration_level_4 > 0 && obj_config_eeprom.overheat_smoke_duration_level_4 != 255) {
-      i_ms_overheating_length_4 = obj_config_eeprom.overheat_smoke_duration_level_4 * 1000;
-    }
+  // The CRC is written last so that an interrupted save never looks valid.
+  EEPROM.put(i_address + sizeof(objEEPROMRecordHeader) + i_length, eepromRecordCRC(header, p_data));
 
-    if(obj_config_eeprom.overheat_smoke_duration_level_3 > 0 && obj_config_eeprom.overheat_smoke_duration_level_3 != 255) {
-      i_ms_overheating_length_3 = obj_config_eeprom.overheat_smoke_duration_level_3 * 1000;
-    }
+  i_eeprom_sequence = header.sequence;
+  i_eeprom_record_slot[i_kind] = i_slot;
+  i_eeprom_next_slot = (i_slot + 1) % i_eeprom_slots;
+}
 
-    if(obj_config_eeprom.overheat_smoke_duration_level_2 > 0 && obj_config_eeprom.overheat_smoke_duration_level_2 != 255) {
-      i_ms_overheating_length_2 = obj_config_eeprom.overheat_smoke_duration_level_2 * 1000;
-    }
+// Fetch the newest stored LED and configuration objects. Objects never saved are left zeroed (defaults).
+bool loadEEPROM(objLEDEEPROM &obj_led_eeprom, objConfigEEPROM &obj_config_eeprom) {
+  scanEEPROMJournal();
 
-    if(obj_config_eeprom.overheat_smoke_duration_level_1 > 0 && obj_config_eeprom.overheat_smoke_duration_level_1 != 255) {
-      i_ms_overheating_length_1 = obj_config_eeprom.overheat_smoke_duration_level_1 * 1000;
-    }
+  i_eeprom_record_slot[EEPROM_RECORD_LED] = findEEPROMRecord(EEPROM_RECORD_LED, (uint8_t*) &obj_led_eeprom);
+  i_eeprom_record_slot[EEPROM_RECORD_CONFIG] = findEEPROMRecord(EEPROM_RECORD_CONFIG, (uint8_t*) &obj_config_eeprom);
 
-    if(obj_config_eeprom.smoke_continuous_level_5 > 0 && obj_config_eeprom.smoke_continuous_level_5 != 255) {
-      if(obj_config_eeprom.smoke_continuous_level_5 > 1) {
-        b_smoke_continuous_level_5 = true;
-      }
-      else {
-        b_smoke_continuous_level_5 = false;
-      }
-    }
+  if(i_eeprom_record_slot[EEPROM_RECORD_LED] != i_eeprom_no_slot || i_eeprom_record_slot[EEPROM_RECORD_CONFIG] != i_eeprom_no_slot) {
+    return true;
+  }
 
-    if(obj_config_eeprom.smoke_continuous_level_4 > 0 && obj_config_eeprom.smoke_continuous_level_4 != 255) {
-      if(obj_config_eeprom.smoke_continuous_level_4 > 1) {
-        b_smoke_continuous_level_4 = true;
-      }
-      else {
-        b_smoke_continuous_level_4 = false;
-      }
-    }
+  // Nothing journaled yet, so fall back to the single-copy layout used by earlier firmware.
+  uint32_t l_crc_check;
+  EEPROM.get(EEPROM.length() - sizeof(eepromCRC()), l_crc_check);
 
-    if(obj_config_eeprom.smoke_continuous_level_3 > 0 && obj_config_eeprom.smoke_continuous_level_3 != 255) {
-      if(obj_config_eeprom.smoke_continuous_level_3 > 1) {
-        b_smoke_continuous_level_3 = true;
-      }
-      else {
-        b_smoke_continuous_level_3 = false;
-      }
-    }
+  if(eepromCRC() == l_crc_check) {
+    EEPROM.get(0, obj_led_eeprom);
+    EEPROM.get(sizeof(objLEDEEPROM), obj_config_eeprom);
 
-    if(obj_config_eeprom.smoke_continuous_level_2 > 0 && obj_config_eeprom.smoke_continuous_level_2 != 255) {
-      if(obj_config_eeprom.smoke_continuous_level_2 > 1) {
-        b_smoke_continuous_level_2 = true;
-      }
-      else {
-        b_smoke_continuous_level_2 = false;
-      }
-    }
+    // Carry the stored preferences over into the journal.
+    writeEEPROMRecord(EEPROM_RECORD_LED, (const uint8_t*) &obj_led_eeprom);
+    writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_config_eeprom);
 
-    if(obj_config_eeprom.smoke_continuous_level_1 > 0 && obj_config_eeprom.smoke_continuous_level_1 != 255) {
-      if(obj_config_eeprom.smoke_continuous_level_1 > 1) {
-        b_smoke_continuous_level_1 = true;
-      }
-      else {
-        b_smoke_continuous_level_1 = false;
-      }
-    }
+    return true;
+  }
 
-    if(obj_config_eeprom.pack_vibration > 0 && obj_config_eeprom.pack_vibration != 255) {
-      switch(obj_config_eeprom.pack_vibration) {
-        case 5:
-          VIBRATION_MODE_EEPROM = CYCLOTRON_MOTOR;
-          VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-        break;
-
-        case 4:
-        default:
-          // Vibrate while firing only, on/off determined by switch.
-          VIBRATION_MODE_EEPROM = VIBRATION_DEFAULT;
-        break;
-
-        case 3:
-          VIBRATION_MODE_EEPROM = VIBRATION_NONE;
-          VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-        break;
-
-        case 2:
-          b_vibration_switch_on = true; // Override the vibration toggle switch.
-          VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
-          VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-        break;
-
-        case 1:
-          b_vibration_switch_on = true; // Override the vibration toggle switch.
-          VIBRATION_MODE_EEPROM = VIBRATION_ALWAYS;
-          VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-        break;
-      }
+  return false;
+}
+
+/*
+ * Preference Schema
+ *
+ * Every stored preference is a single byte, described by one PROGMEM entry holding the record and offset
+ * of that byte, the range of stored values which are accepted, and how an accepted value is applied.
+ * Stored values outside of that range (0 and 255 mean "never set") keep the defaults from Configuration.h.
+ */
+enum PREFERENCE_TYPES { PREF_FLAG, PREF_FLAG_INVERTED, PREF_BYTE, PREF_SECONDS, PREF_APPLY };
+
+struct objPreferenceField {
+  uint8_t record;         // EEPROM record which holds the value.
+  uint8_t offset;         // Byte offset of the value within that record.
+  uint8_t type;           // How an accepted value is applied.
+  uint8_t min;            // Lowest stored value which is accepted.
+  uint8_t max;            // Highest stored value which is accepted.
+  void *p_target;         // Variable updated by the PREF_FLAG, PREF_FLAG_INVERTED, PREF_BYTE and PREF_SECONDS types.
+  void (*apply)(uint8_t); // Called with the stored value by the PREF_APPLY type.
+};
+
+#define PREF_CONFIG(field, type, min, max, target, apply) { EEPROM_RECORD_CONFIG, offsetof(objConfigEEPROM, field), type, min, max, target, apply }
+#define PREF_LED(field, type, min, max, target, apply) { EEPROM_RECORD_LED, offsetof(objLEDEEPROM, field), type, min, max, target, apply }
+
+void applyPowercellCount(uint8_t i_value) {
+  if(i_value > 0 && i_value != 255) {
+    i_powercell_leds = i_value;
+
+    switch(i_powercell_leds) {
+      case FRUTTO_POWERCELL_LED_COUNT:
+        // 15 Power Cell LEDs.
+        i_powercell_delay_1984 = POWERCELL_DELAY_1984_15_LED;
+        i_powercell_delay_2021 = POWERCELL_DELAY_2021_15_LED;
+      break;
+
+      case HASLAB_POWERCELL_LED_COUNT:
+      default:
+        // 13 Power Cell LEDs.
+        i_powercell_delay_1984 = POWERCELL_DELAY_1984_13_LED;
+        i_powercell_delay_2021 = POWERCELL_DELAY_2021_13_LED;
+      break;
     }
   }
+  else if(!b_power_meter_available) {
+    // If no EEPROM default set and not using a stock wand, assume Frutto upgrades instead.
+    i_powercell_leds = FRUTTO_POWERCELL_LED_COUNT;
+    i_powercell_delay_1984 = POWERCELL_DELAY_1984_15_LED;
+    i_powercell_delay_2021 = POWERCELL_DELAY_2021_15_LED;
+  }
+}
+
+void applyCyclotronCount(uint8_t i_value) {
+  if(i_value > 0 && i_value != 255) {
+    i_cyclotron_leds = i_value;
+  }
+  else if(!b_power_meter_available) {
+    // If no EEPROM default set and not using a stock wand, assume Frutto upgrades instead.
+    i_cyclotron_leds = FRUTTO_MAX_CYCLOTRON_LED_COUNT;
+  }
+}
+
+void applyInnerCyclotronCount(uint8_t i_value) {
+  i_inner_cyclotron_cake_num_leds = i_value;
+
+  switch(i_inner_cyclotron_cake_num_leds) {
+    case 12:
+      i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_12_LED;
+      i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_12_LED;
+    break;
+
+    case 23:
+      i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_23_LED;
+      i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_23_LED;
+    break;
+
+    case 24:
+      i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_24_LED;
+      i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_24_LED;
+    break;
+
+    case 26:
+      i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_26_LED;
+      i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_26_LED;
+    break;
+
+    case 35:
+      i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_35_LED;
+      i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_35_LED;
+    break;
+
+    case 36:
+    default:
+      i_1984_inner_delay = INNER_CYCLOTRON_DELAY_1984_36_LED;
+      i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_36_LED;
+    break;
+  }
+}
+
+void applyCakeLEDType(uint8_t i_value) {
+  if(i_value > 1) {
+    CAKE_LED_TYPE = GRB_LED;
+  }
+  else {
+    CAKE_LED_TYPE = RGB_LED;
+  }
+}
+
+void applyCavityCount(uint8_t i_value) {
+  if(i_value > 20) {
+    i_inner_cyclotron_cavity_num_leds = 20;
+  }
+  else {
+    i_inner_cyclotron_cavity_num_leds = i_value;
+  }
+}
+
+void applyCavityLEDType(uint8_t i_value) {
+  // 2 = RGB, 3 = GRB, 4 = GBR.
+  switch(i_value) {
+    case 2:
+    default:
+      CAVITY_LED_TYPE = RGB_LED;
+    break;
+
+    case 3:
+      CAVITY_LED_TYPE = GRB_LED;
+    break;
+
+    case 4:
+      CAVITY_LED_TYPE = GBR_LED;
+    break;
+  }
+}
+
+void applyInnerPanelMode(uint8_t i_value) {
+  // 2 = Individual, 3 = RGB Static, 4 = RGB Dynamic.
+  switch(i_value) {
+    case 2:
+    default:
+      INNER_CYC_PANEL_MODE = PANEL_INDIVIDUAL;
+    break;
+
+    case 3:
+      INNER_CYC_PANEL_MODE = PANEL_RGB_STATIC;
+    break;
+
+    case 4:
+      INNER_CYC_PANEL_MODE = PANEL_RGB_DYNAMIC;
+    break;
+  }
+}
+
+void applyYearMode(uint8_t i_value) {
+  // 1 = toggle switch, 2 = 1984, 3 = 1989, 4 = Afterlife, 5 = Frozen Empire.
+  switch(i_value) {
+    case 2:
+      SYSTEM_YEAR = SYSTEM_1984;
+    break;
+
+    case 3:
+      SYSTEM_YEAR = SYSTEM_1989;
+    break;
+
+    case 4:
+    default:
+      SYSTEM_YEAR = SYSTEM_AFTERLIFE;
+    break;
+
+    case 5:
+      SYSTEM_YEAR = SYSTEM_FROZEN_EMPIRE;
+    break;
+  }
+
+  // Update additional variables once the system year is set from the stored EEPROM preferences.
+  SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
+  SYSTEM_EEPROM_YEAR = SYSTEM_YEAR;
+
+  // Set the switch override to true, so the toggle switch in the Proton Pack does not override the year settings during the bootup process.
+  b_switch_mode_override = true;
+}
+
+void applySystemMode(uint8_t i_value) {
+  if(i_value > 1) {
+    SYSTEM_MODE = MODE_ORIGINAL;
+  }
   else {
-    // CRC doesn't match; let's clear the EEPROMs to be safe.
+    SYSTEM_MODE = MODE_SUPER_HERO;
+  }
+}
+
+void applyDefaultVolume(uint8_t i_value) {
+  // EEPROM value is from 1 to 101; subtract 1 to get the correct percentage.
+  i_volume_master_percentage = i_value - 1;
+  i_volume_master_eeprom = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * i_volume_master_percentage / 100);
+  i_volume_revert = i_volume_master_eeprom;
+  i_volume_master = i_volume_master_eeprom;
+}
+
+void applyPackVibration(uint8_t i_value) {
+  switch(i_value) {
+    case 5:
+      VIBRATION_MODE_EEPROM = CYCLOTRON_MOTOR;
+      VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+    break;
+
+    case 4:
+    default:
+      // Vibrate while firing only, on/off determined by switch.
+      VIBRATION_MODE_EEPROM = VIBRATION_DEFAULT;
+    break;
+
+    case 3:
+      VIBRATION_MODE_EEPROM = VIBRATION_NONE;
+      VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+    break;
+
+    case 2:
+      b_vibration_switch_on = true; // Override the vibration toggle switch.
+      VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
+      VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+    break;
+
+    case 1:
+      b_vibration_switch_on = true; // Override the vibration toggle switch.
+      VIBRATION_MODE_EEPROM = VIBRATION_ALWAYS;
+      VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+    break;
+  }
+}
+
+const objPreferenceField preferenceFields[] PROGMEM = {
+  // The LED counts also fall back to the Frutto upgrades when never set, so they accept every stored value.
+  PREF_LED(powercell_count, PREF_APPLY, 0, 255, nullptr, applyPowercellCount),
+  PREF_LED(cyclotron_count, PREF_APPLY, 0, 255, nullptr, applyCyclotronCount),
+  PREF_LED(inner_cyclotron_count, PREF_APPLY, 1, 254, nullptr, applyInnerCyclotronCount),
+  PREF_LED(cyclotron_cavity_count, PREF_APPLY, 1, 254, nullptr, applyCavityCount),
+  PREF_LED(cyclotron_cavity_type, PREF_APPLY, 2, 254, nullptr, applyCavityLEDType),
+  PREF_LED(powercell_inverted, PREF_FLAG, 1, 254, &b_powercell_invert, nullptr),
+  PREF_LED(inner_cyclotron_led_panel, PREF_APPLY, 2, 254, nullptr, applyInnerPanelMode),
+  PREF_LED(grb_inner_cyclotron, PREF_APPLY, 1, 254, nullptr, applyCakeLEDType),
+  PREF_LED(powercell_spectral_custom, PREF_BYTE, 1, 254, &i_spectral_powercell_custom_colour, nullptr),
+  PREF_LED(cyclotron_spectral_custom, PREF_BYTE, 1, 254, &i_spectral_cyclotron_custom_colour, nullptr),
+  PREF_LED(cyclotron_inner_spectral_custom, PREF_BYTE, 1, 254, &i_spectral_cyclotron_inner_custom_colour, nullptr),
+  PREF_LED(powercell_spectral_saturation_custom, PREF_BYTE, 1, 254, &i_spectral_powercell_custom_saturation, nullptr),
+  PREF_LED(cyclotron_spectral_saturation_custom, PREF_BYTE, 1, 254, &i_spectral_cyclotron_custom_saturation, nullptr),
+  PREF_LED(cyclotron_inner_spectral_saturation_custom, PREF_BYTE, 1, 254, &i_spectral_cyclotron_inner_custom_saturation, nullptr),
+  PREF_CONFIG(stream_effects, PREF_FLAG, 1, 254, &b_stream_effects, nullptr),
+  PREF_CONFIG(cyclotron_direction, PREF_FLAG, 1, 254, &b_clockwise, nullptr),
+  PREF_CONFIG(center_led_fade, PREF_FLAG, 1, 254, &b_fade_cyclotron_led, nullptr),
+  PREF_CONFIG(simulate_ring, PREF_FLAG, 1, 254, &b_cyclotron_simulate_ring, nullptr),
+  PREF_CONFIG(smoke_setting, PREF_FLAG, 1, 254, &b_smoke_enabled, nullptr),
+  PREF_CONFIG(overheat_strobe, PREF_FLAG, 1, 254, &b_overheat_strobe, nullptr),
+  PREF_CONFIG(overheat_lights_off, PREF_FLAG, 1, 254, &b_overheat_lights_off, nullptr),
+  PREF_CONFIG(overheat_sync_to_fan, PREF_FLAG, 1, 254, &b_overheat_sync_to_fan, nullptr),
+  PREF_CONFIG(year_mode, PREF_APPLY, 2, 254, nullptr, applyYearMode), // 1 leaves the year to the toggle switch.
+  PREF_CONFIG(system_mode, PREF_APPLY, 1, 254, nullptr, applySystemMode),
+  PREF_CONFIG(vg_powercell, PREF_FLAG, 1, 254, &b_powercell_colour_toggle, nullptr),
+  PREF_CONFIG(vg_cyclotron, PREF_FLAG, 1, 254, &b_cyclotron_colour_toggle, nullptr),
+  PREF_CONFIG(demo_light_mode, PREF_FLAG, 1, 254, &b_demo_light_mode, nullptr),
+  PREF_CONFIG(use_ribbon_cable, PREF_FLAG, 1, 254, &b_use_ribbon_cable, nullptr),
+  PREF_CONFIG(cyclotron_three_led_toggle, PREF_FLAG_INVERTED, 1, 254, &b_cyclotron_single_led, nullptr),
+  PREF_CONFIG(default_system_volume, PREF_APPLY, 1, 101, nullptr, applyDefaultVolume),
+  PREF_CONFIG(overheat_smoke_duration_level_5, PREF_SECONDS, 1, 254, &i_ms_overheating_length_5, nullptr),
+  PREF_CONFIG(overheat_smoke_duration_level_4, PREF_SECONDS, 1, 254, &i_ms_overheating_length_4, nullptr),
+  PREF_CONFIG(overheat_smoke_duration_level_3, PREF_SECONDS, 1, 254, &i_ms_overheating_length_3, nullptr),
+  PREF_CONFIG(overheat_smoke_duration_level_2, PREF_SECONDS, 1, 254, &i_ms_overheating_length_2, nullptr),
+  PREF_CONFIG(overheat_smoke_duration_level_1, PREF_SECONDS, 1, 254, &i_ms_overheating_length_1, nullptr),
+  PREF_CONFIG(smoke_continuous_level_5, PREF_FLAG, 1, 254, &b_smoke_continuous_level_5, nullptr),
+  PREF_CONFIG(smoke_continuous_level_4, PREF_FLAG, 1, 254, &b_smoke_continuous_level_4, nullptr),
+  PREF_CONFIG(smoke_continuous_level_3, PREF_FLAG, 1, 254, &b_smoke_continuous_level_3, nullptr),
+  PREF_CONFIG(smoke_continuous_level_2, PREF_FLAG, 1, 254, &b_smoke_continuous_level_2, nullptr),
+  PREF_CONFIG(smoke_continuous_level_1, PREF_FLAG, 1, 254, &b_smoke_continuous_level_1, nullptr),
+  PREF_CONFIG(pack_vibration, PREF_APPLY, 1, 254, nullptr, applyPackVibration)
+};
+
+const uint8_t i_preference_fields = sizeof(preferenceFields) / sizeof(objPreferenceField);
+
+// Apply a single stored value to the runtime variables described by its schema entry.
+void applyPreferenceField(const objPreferenceField &field, uint8_t i_value) {
+  if(i_value < field.min || i_value > field.max) {
+    return;
+  }
+
+  switch(field.type) {
+    case PREF_FLAG:
+      // 1 = false, 2 = true.
+      *(bool*) field.p_target = i_value > 1;
+    break;
+
+    case PREF_FLAG_INVERTED:
+      // 1 = true, 2 = false.
+      *(bool*) field.p_target = i_value < 2;
+    break;
+
+    case PREF_BYTE:
+      *(uint8_t*) field.p_target = i_value;
+    break;
+
+    case PREF_SECONDS:
+      *(uint16_t*) field.p_target = (uint16_t) i_value * 1000;
+    break;
+
+    case PREF_APPLY:
+    default:
+      field.apply(i_value);
+    break;
+  }
+}
+
+// Validate and apply every field in the schema from the loaded preference objects.
+void applyPreferences(const uint8_t *p_records[EEPROM_RECORD_KINDS]) {
+  objPreferenceField field;
+
+  for(uint8_t i = 0; i < i_preference_fields; i++) {
+    memcpy_P(&field, &preferenceFields[i], sizeof(objPreferenceField));
+    applyPreferenceField(field, p_records[field.record][field.offset]);
+  }
+}
+
+/*
+ * Read all user preferences from Proton Pack controller EEPROM.
+ */
+void readEEPROM() {
+  objLEDEEPROM obj_eeprom = {};
+  objConfigEEPROM obj_config_eeprom = {};
+
+  // Locate the newest stored copy of each preference object.
+  if(loadEEPROM(obj_eeprom, obj_config_eeprom)) {
+    const uint8_t *p_records[EEPROM_RECORD_KINDS] = { (const uint8_t*) &obj_config_eeprom, (const uint8_t*) &obj_eeprom };
+
+    applyPreferences(p_records);
+
+    // Update the LED counts for the Proton Pack.
+    resetCyclotronLEDs();
+    resetInnerCyclotronLEDs();
+    updateProtonPackLEDCounts();
+  }
+  else {
+    // Nothing valid was found; let's clear the EEPROMs to be safe.
     playEffect(S_VOICE_EEPROM_LOADING_FAILED_RESET);
 
     clearConfigEEPROM();
@@ -561,12 +661,10 @@ void readEEPROM() {
 }
 
 void clearLEDEEPROM() {
-  // Clear out the EEPROM only in the memory addresses used for our EEPROM data object.
-  for(uint16_t i = 0; i < sizeof(objLEDEEPROM); i++) {
-    EEPROM.update(i, 0);
-  }
+  // Store an empty LED object so that defaults are used.
+  objLEDEEPROM obj_led_eeprom = {};
 
-  updateCRCEEPROM();
+  writeEEPROMRecord(EEPROM_RECORD_LED, (const uint8_t*) &obj_led_eeprom);
 }
 
 void saveLEDEEPROM() {
@@ -639,23 +737,15 @@ void saveLEDEEPROM() {
     i_powercell_inverted
   };
 
-  // Save and update our object in the EEPROM.
-  EEPROM.put(i_eepromAddress, obj_eeprom);
-
-  updateCRCEEPROM();
+  // Append the object to the EEPROM journal if any of the values have changed.
+  writeEEPROMRecord(EEPROM_RECORD_LED, (const uint8_t*) &obj_eeprom);
 }
 
 void clearConfigEEPROM() {
-  // Clear out the EEPROM data for the configuration settings only.
-  uint16_t i_eepromConfigAddress = i_eepromAddress + sizeof(objLEDEEPROM);
-
-  for(uint16_t i = 0; i < sizeof(objConfigEEPROM); i++) {
-    EEPROM.update(i_eepromConfigAddress, 0);
-
-    i_eepromConfigAddress++;
-  }
+  // Store an empty configuration object so that defaults are used.
+  objConfigEEPROM obj_config_eeprom = {};
 
-  updateCRCEEPROM();
+  writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_config_eeprom);
 }
 
 void saveConfigEEPROM() {
@@ -799,8 +889,6 @@ void saveConfigEEPROM() {
     break;
   }
 
-  uint16_t i_eepromConfigAddress = i_eepromAddress + sizeof(objLEDEEPROM);
-
   objConfigEEPROM obj_eeprom = {
     i_proton_stream_effects,
     i_cyclotron_direction,
@@ -831,21 +919,15 @@ void saveConfigEEPROM() {
     i_use_ribbon_cable
   };
 
-  // Save and update our object in the EEPROM.
-  EEPROM.put(i_eepromConfigAddress, obj_eeprom);
-
-  updateCRCEEPROM();
-}
-
-// Update the CRC in the EEPROM.
-void updateCRCEEPROM() {
-  EEPROM.put(EEPROM.length() - sizeof(eepromCRC()), eepromCRC());
+  // Append the object to the EEPROM journal if any of the values have changed.
+  writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_eeprom);
 }
 
+// CRC of the single-copy layout used by earlier firmware, kept only to migrate it into the journal.
 uint32_t eepromCRC(void) {
   CRC32 crc;
 
-  for(uint16_t index = 0; index < (i_eepromAddress + sizeof(objConfigEEPROM) + sizeof(objLEDEEPROM)); index++) {
+  for(uint16_t index = 0; index < (sizeof(objConfigEEPROM) + sizeof(objLEDEEPROM)); index++) {
     crc.update(EEPROM[index]);
   }
 
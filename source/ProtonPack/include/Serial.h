@@ -28,7 +28,8 @@ enum PACKET_TYPE : uint8_t {
   PACKET_PACK = 3,
   PACKET_WAND = 4,
   PACKET_SMOKE = 5,
-  PACKET_SYNC = 6
+  PACKET_SYNC = 6,
+  PACKET_MEMORY = 7
 };
 
 // For command signals (1 byte ID, 2 byte optional data).
@@ -182,6 +183,12 @@ struct __attribute__((packed)) AttenuatorSyncData {
   uint16_t packVoltage;
 } attenuatorSyncData;
 
+// SRAM usage of both ATmega2560 controllers, sent to the Attenuator.
+struct __attribute__((packed)) AttenuatorMemoryData {
+  MemoryStats pack;
+  MemoryStats wand;
+} attenuatorMemoryData;
+
 // Adjusts which year mode the Proton Pack and Neutrona Wand are in, as switched by the Neutrona Wand.
 void toggleYearModes() {
   // Toggle between the year modes.
@@ -313,6 +320,18 @@ void serial1SendData(uint8_t i_message) {
       serial1Coms.sendData(i_send_size, (uint8_t) PACKET_SYNC);
     break;
 
+    case A_MEMORY_STATS:
+      updateMemoryStats(attenuatorMemoryData.pack);
+
+      if(!wandState.connected) {
+        // Don't report stale figures from a wand which is no longer present.
+        memset(&attenuatorMemoryData.wand, 0, sizeof(attenuatorMemoryData.wand));
+      }
+
+      i_send_size = serial1Coms.txObj(attenuatorMemoryData);
+      serial1Coms.sendData(i_send_size, (uint8_t) PACKET_MEMORY);
+    break;
+
     case A_VOLUME_SYNC:
       // Send the current volume levels.
       sendDataS.d[0] = i_volume_master_percentage;
@@ -438,7 +457,7 @@ void serial1SendData(uint8_t i_message) {
       // Enable or disable smoke effects overall.
       smokeConfig.smokeEnabled = b_smoke_enabled ? 1 : 0;
 
-      if(!b_wand_connected) {
+      if(!wandState.connected) {
         // Provide some default values when a wand is not attached.
         // TODO: The pack should control these in this situation.
         smokeConfig.overheatLevel5 = 1; // true|false
@@ -587,7 +606,7 @@ void checkSerial1() {
               packSerialSend(P_MODE_ORIGINAL);
               serial1Send(A_MODE_ORIGINAL);
 
-              if(!b_wand_connected && STREAM_MODE != PROTON) {
+              if(!wandState.connected && STREAM_MODE != PROTON) {
                 // If no wand is connected we need to make sure we're in Proton Stream.
                 STREAM_MODE = PROTON;
                 serial1Send(A_PROTON_MODE);
@@ -853,9 +872,9 @@ void doSerial1Sync() {
   serial1Send(A_SYNC_START);
 
   // Tell the serial1 device about the wand status.
-  attenuatorSyncData.wandPresent = b_wand_connected ? 1 : 0;
-  attenuatorSyncData.barrelExtended = b_neutrona_wand_barrel_extended ? 1 : 0;
-  attenuatorSyncData.wandFiring = b_wand_firing ? 1 : 0;
+  attenuatorSyncData.wandPresent = wandState.connected ? 1 : 0;
+  attenuatorSyncData.barrelExtended = wandState.barrelExtended ? 1 : 0;
+  attenuatorSyncData.wandFiring = wandState.firing ? 1 : 0;
 
   switch(SYSTEM_YEAR) {
     case SYSTEM_1984:
@@ -878,7 +897,7 @@ void doSerial1Sync() {
   attenuatorSyncData.systemMode = (SYSTEM_MODE == MODE_ORIGINAL) ? 2 : 1;
   attenuatorSyncData.ionArmSwitch = (switch_power.getState() == LOW) ? 2 : 1;
   attenuatorSyncData.powerLevel = i_wand_power_level;
-  attenuatorSyncData.packVoltage = packReading.BusVoltage;
+  attenuatorSyncData.packVoltage = (packReading.BusVoltage + 5) / 10; // Volts x 100.
 
   // Synchronise the firing modes.
   switch(STREAM_MODE) {
@@ -949,7 +968,7 @@ void doSerial1Sync() {
 
 void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
   if(!b_serial1_connected) {
-    // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
+    // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
     if(i_command != A_SYNC_START && i_command != A_HANDSHAKE && i_command != A_SYNC_END) {
       // This applies for any action other than those responsible for sync operations.
       return;
@@ -986,7 +1005,7 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
       }
 
       // Tell the Neutrona Wand that power to the Proton Pack is on.
-      if(b_wand_connected) {
+      if(wandState.connected) {
         packSerialSend(P_ION_ARM_SWITCH_ON);
       }
 
@@ -1004,7 +1023,7 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
       }
 
       // Tell the Neutrona Wand that power to the Proton Pack is off.
-      if(b_wand_connected) {
+      if(wandState.connected) {
         packSerialSend(P_ION_ARM_SWITCH_OFF);
       }
 
@@ -1019,7 +1038,7 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
 
     case A_MANUAL_OVERHEAT:
       // Trigger a manual overheat vent.
-      if(b_wand_connected) {
+      if(wandState.connected) {
         packSerialSend(P_MANUAL_OVERHEAT);
       }
       else if(b_pack_on) {
@@ -1155,13 +1174,13 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
     case A_REQUEST_PREFERENCES_WAND:
       // If requested by the serial device, tell the wand we need its EEPROM preferences.
       // This is merely a command to the wand which tells it to send back a data payload.
-      if(b_wand_connected) {
+      if(wandState.connected) {
         packSerialSend(P_SEND_PREFERENCES_WAND);
       }
     break;
 
     case A_REQUEST_PREFERENCES_SMOKE:
-      if(b_wand_connected) {
+      if(wandState.connected) {
         // If requested by the serial device, tell the wand we need its EEPROM preferences.
         // This is merely a command to the wand which tells it to send back a data payload.
         packSerialSend(P_SEND_PREFERENCES_SMOKE);
@@ -1223,7 +1242,7 @@ void checkWand() {
     // debugln(i_packet_id);
 
     if(i_packet_id > 0) {
-      if(ms_wand_check.isRunning() && b_wand_connected) {
+      if(ms_wand_check.isRunning() && wandState.connected) {
         // If the timer is still running and wand is connected, consider any request as proof of life.
         ms_wand_check.restart();
       }
@@ -1240,7 +1259,7 @@ void checkWand() {
         break;
 
         case PACKET_DATA:
-          if(!b_wand_connected) {
+          if(!wandState.connected) {
             // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
             return;
           }
@@ -1254,7 +1273,7 @@ void checkWand() {
         break;
 
         case PACKET_WAND:
-          if(!b_wand_connected) {
+          if(!wandState.connected) {
             // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
             return;
           }
@@ -1267,7 +1286,7 @@ void checkWand() {
         break;
 
         case PACKET_SMOKE:
-          if(!b_wand_connected) {
+          if(!wandState.connected) {
             // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
             return;
           }
@@ -1279,6 +1298,16 @@ void checkWand() {
           // This data will combine with the pack's smoke settings.
           serial1SendData(A_SEND_PREFERENCES_SMOKE);
         break;
+
+        case PACKET_MEMORY:
+          if(!wandState.connected) {
+            // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
+            return;
+          }
+
+          // Held until the next report to the Serial1 device.
+          packComs.rxObj(attenuatorMemoryData.wand);
+        break;
       }
     }
   }
@@ -1288,8 +1317,8 @@ void checkWand() {
 void doWandSync() {
   // Denote sync in progress, don't run this code again if we get another handshake.
   // This will be cleared once the wand responds back that it has been synchronized.
-  b_wand_syncing = true;
-  b_wand_connected = false;
+  wandState.syncing = true;
+  wandState.connected = false;
   ms_wand_check.stop();
 
   if(b_diagnostic) {
@@ -1411,7 +1440,7 @@ void doWandSync() {
 
   if(b_pack_on != true) {
     // Set this flag to false to force a full reset of the pack if a new wand is connected.
-    b_reset_start_led = false;
+    cyclotronState.resetStartLed = false;
   }
 
   // Synchronise the volume settings.
@@ -1435,7 +1464,7 @@ void doWandSync() {
 }
 
 void handleWandCommand(uint8_t i_command, uint16_t i_value) {
-  if(!b_wand_connected) {
+  if(!wandState.connected) {
     // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
     if(i_command != W_SYNC_NOW && i_command != W_HANDSHAKE && i_command != W_SYNCHRONIZED) {
       // This applies for any action other than those responsible for sync operations.
@@ -1454,8 +1483,8 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
     break;
 
     case W_HANDSHAKE:
-      b_wand_syncing = false; // No longer attempting to force a sync w/ wand.
-      b_wand_connected = true; // If we're receiving handshake instead of SYNC_NOW we must be connected
+      wandState.syncing = false; // No longer attempting to force a sync w/ wand.
+      wandState.connected = true; // If we're receiving handshake instead of SYNC_NOW we must be connected
 
       // Tell the serial1 device the wand is still connected.
       serial1Send(A_WAND_CONNECTED);
@@ -1468,15 +1497,15 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_SYNCHRONIZED:
       debugln(F("Wand Synchronized"));
-      b_wand_syncing = false; // Stop trying to sync since we've successfully synchronized.
-      b_wand_connected = true; // Wand sent sync confirmation, so it must be connected.
+      wandState.syncing = false; // Stop trying to sync since we've successfully synchronized.
+      wandState.connected = true; // Wand sent sync confirmation, so it must be connected.
       ms_wand_check.start(i_wand_disconnect_delay); // Wand is synchronized, so start the keep-alive timer.
       serial1Send(A_WAND_CONNECTED); // Tell the serial1 device the wand is (re-)connected.
     break;
 
     case W_ON:
       // The wand has been turned on.
-      b_wand_on = true;
+      wandState.on = true;
 
       // Turn the pack on.
       if(PACK_STATE != MODE_ON) {
@@ -1489,7 +1518,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_OFF:
       // The wand has been turned off.
-      b_wand_on = false;
+      wandState.on = false;
 
       // Turn the pack off.
       if(PACK_STATE != MODE_OFF) {
@@ -1503,7 +1532,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_BARREL_EXTENDED:
       // Remember the last state sent from the wand (for re-sync with the Serial1 device).
-      b_neutrona_wand_barrel_extended = true;
+      wandState.barrelExtended = true;
 
       // Tell the serial1 device that the Neutrona Wand barrel is extended.
       serial1Send(A_BARREL_EXTENDED);
@@ -1511,7 +1540,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_BARREL_RETRACTED:
       // Remember the last state sent from the wand (for re-sync with the Serial1 device).
-      b_neutrona_wand_barrel_extended = false;
+      wandState.barrelExtended = false;
 
       // Tell the serial1 device that the Neutrona Wand barrel is retracted.
       serial1Send(A_BARREL_RETRACTED);
@@ -1796,17 +1825,17 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
     case W_FIRING:
       // Wand is firing.
       if(i_value == 1) {
-        b_firing_intensify = true;
+        wandState.firingIntensify = true;
 
-        if(b_wand_firing && !b_sound_firing_intensify_trigger) {
-          b_sound_firing_intensify_trigger = true;
+        if(wandState.firing && !wandState.soundIntensifyTrigger) {
+          wandState.soundIntensifyTrigger = true;
         }
       }
       else {
-        b_firing_alt = true;
+        wandState.firingAlt = true;
 
-        if(b_wand_firing && !b_sound_firing_alt_trigger) {
-          b_sound_firing_alt_trigger = true;
+        if(wandState.firing && !wandState.soundAltTrigger) {
+          wandState.soundAltTrigger = true;
         }
       }
 
@@ -1815,7 +1844,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_FIRING_STOPPED:
       // Wand just stopped firing.
-      if(b_wand_firing == true) {
+      if(wandState.firing == true) {
         wandStoppedFiring();
 
         // Return cyclotron to normal speed.
@@ -2364,7 +2393,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       i_wand_power_level = 1;
 
       // Reset the smoke timer and cyclotron speed timer if the wand is firing.
-      if(b_wand_firing == true) {
+      if(wandState.firing == true) {
         if(ms_smoke_timer.isRunning()) {
           ms_smoke_timer.start(PROGMEM_READU16(i_smoke_timer[i_wand_power_level - 1]));
         }
@@ -2382,7 +2411,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       i_wand_power_level = 2;
 
       // Reset the smoke timer and cyclotron speed timer if the wand is firing.
-      if(b_wand_firing == true) {
+      if(wandState.firing == true) {
         if(ms_smoke_timer.isRunning()) {
           ms_smoke_timer.start(PROGMEM_READU16(i_smoke_timer[i_wand_power_level - 1]));
         }
@@ -2400,7 +2429,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       i_wand_power_level = 3;
 
       // Reset the smoke timer and cyclotron speed timer if the wand is firing.
-      if(b_wand_firing == true) {
+      if(wandState.firing == true) {
         if(ms_smoke_timer.isRunning()) {
           ms_smoke_timer.start(PROGMEM_READU16(i_smoke_timer[i_wand_power_level - 1]));
         }
@@ -2418,7 +2447,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       i_wand_power_level = 4;
 
       // Reset the smoke timer and cyclotron speed timer if the wand is firing.
-      if(b_wand_firing == true) {
+      if(wandState.firing == true) {
         if(ms_smoke_timer.isRunning()) {
           ms_smoke_timer.start(PROGMEM_READU16(i_smoke_timer[i_wand_power_level - 1]));
         }
@@ -2437,7 +2466,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
       // Reset the smoke timer and cyclotron speed timer if the wand is firing.
       // Note that since the wand cannot enter or exit Power Level 5 while firing, this should never be necessary.
-      if(b_wand_firing == true) {
+      if(wandState.firing == true) {
         if(ms_smoke_timer.isRunning()) {
           ms_smoke_timer.start(PROGMEM_READU16(i_smoke_timer[i_wand_power_level - 1]));
         }
@@ -2492,22 +2521,22 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_FIRING_INTENSIFY_MIX:
       // Wand firing in intensify mode mix.
-      b_firing_intensify = true;
+      wandState.firingIntensify = true;
 
-      if(b_wand_firing == true && b_sound_firing_intensify_trigger != true) {
+      if(wandState.firing == true && wandState.soundIntensifyTrigger != true) {
         if(SYSTEM_YEAR == SYSTEM_1984) {
           playEffect(S_GB1_1984_FIRE_HIGH_POWER_LOOP, true, i_volume_effects, false, 0, false);
         }
         else {
           playEffect(S_GB1_FIRE_HIGH_POWER_LOOP, true, i_volume_effects, false, 0, false);
         }
-        b_sound_firing_intensify_trigger = true;
+        wandState.soundIntensifyTrigger = true;
       }
     break;
 
     case W_FIRING_INTENSIFY_STOPPED_MIX:
       // Wand no longer firing in intensify mode; drop back to alt fire mix.
-      if(b_firing_intensify == true) {
+      if(wandState.firingIntensify == true) {
         if(SYSTEM_YEAR == SYSTEM_1984) {
           stopEffect(S_GB1_1984_FIRE_HIGH_POWER_LOOP);
         }
@@ -2516,16 +2545,16 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
         }
       }
 
-      b_firing_intensify = false;
-      b_sound_firing_intensify_trigger = false;
+      wandState.firingIntensify = false;
+      wandState.soundIntensifyTrigger = false;
     break;
 
     case W_FIRING_ALT_MIX:
       // Wand firing in alt mode mix.
-      b_firing_alt = true;
+      wandState.firingAlt = true;
 
-      if(b_wand_firing == true && b_sound_firing_alt_trigger != true) {
-        b_sound_firing_alt_trigger = true;
+      if(wandState.firing == true && wandState.soundAltTrigger != true) {
+        wandState.soundAltTrigger = true;
 
         if(i_wand_power_level != i_wand_power_level_max) {
           if(SYSTEM_YEAR == SYSTEM_1989) {
@@ -2549,7 +2578,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_FIRING_ALT_STOPPED_MIX:
       // Wand no longer firing in alt mode; drop back to intensify fire mix.
-      if(b_firing_alt == true) {
+      if(wandState.firingAlt == true) {
         stopEffect(S_FIRING_LOOP_GB1);
 
         // Since Intensify is still held, turn back on its firing loop sounds.
@@ -2577,8 +2606,8 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
         }
       }
 
-      b_firing_alt = false;
-      b_sound_firing_alt_trigger = false;
+      wandState.firingAlt = false;
+      wandState.soundAltTrigger = false;
     break;
 
     case W_FIRING_CROSSING_THE_STREAMS_1984:
@@ -3842,7 +3871,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
     break;
 
     case W_CLEAR_CONFIG_EEPROM_SETTINGS:
-      if(b_wand_connected) {
+      if(wandState.connected) {
         // Only proceed if a wand is connected.
         stopEffect(S_VOICE_EEPROM_ERASE);
         playEffect(S_VOICE_EEPROM_ERASE);
@@ -3852,7 +3881,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
     break;
 
     case W_SAVE_CONFIG_EEPROM_SETTINGS:
-      if(b_wand_connected) {
+      if(wandState.connected) {
         // Only proceed if a wand is connected.
         stopEffect(S_VOICE_EEPROM_SAVE);
         playEffect(S_VOICE_EEPROM_SAVE);
@@ -3862,7 +3891,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
     break;
 
     case W_CLEAR_LED_EEPROM_SETTINGS:
-      if(b_wand_connected) {
+      if(wandState.connected) {
         // Only proceed if a wand is connected.
         stopEffect(S_VOICE_EEPROM_ERASE);
         playEffect(S_VOICE_EEPROM_ERASE);
@@ -3872,7 +3901,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
     break;
 
     case W_SAVE_LED_EEPROM_SETTINGS:
-      if(b_wand_connected) {
+      if(wandState.connected) {
         // Only proceed if a wand is connected.
         stopEffect(S_VOICE_EEPROM_SAVE);
         playEffect(S_VOICE_EEPROM_SAVE);
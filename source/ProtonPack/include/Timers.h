@@ -0,0 +1,109 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2023-2025 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * Loop Timers
+ *
+ * A drop-in replacement for millisDelay which reads the clock once per pass of the loop rather than once per check.
+ * updateTimers() caches millis() at the start of each pass, and every justFinished() or remaining() during that pass
+ * compares against the cached time. A timer started part way through a pass counts from the live clock, and is seen
+ * as having no time elapsed until the next pass. Until updateTimers() first runs (during setup()) the live clock is
+ * used, so behaviour there is unchanged. Each timer holds the same state as a millisDelay.
+ */
+uint32_t i_timer_now = 0; // Time of the latest call to updateTimers().
+bool b_timer_now_cached = false; // Whether i_timer_now holds the time for this pass.
+
+// Time to compare timers against: the start of this pass, or the live clock before the loop first runs.
+uint32_t timerNow() {
+  return b_timer_now_cached ? i_timer_now : millis();
+}
+
+class millisTimer {
+  public:
+    void start(uint32_t i_delay) {
+      i_delay_ms = i_delay;
+      i_start_time = millis();
+      b_running = true;
+    }
+
+    // Start again with the same delay, counting from now.
+    void restart() {
+      start(i_delay_ms);
+    }
+
+    // Start again with the same delay, counting from when the last delay ended so repeats do not drift.
+    void repeat() {
+      i_start_time += i_delay_ms;
+      b_running = true;
+    }
+
+    void stop() {
+      b_running = false;
+    }
+
+    bool isRunning() {
+      return b_running;
+    }
+
+    uint32_t delay() {
+      return i_delay_ms;
+    }
+
+    // Returns true once when the delay has expired, and stops the timer.
+    bool justFinished() {
+      if(b_running && elapsed() >= i_delay_ms) {
+        b_running = false;
+        return true;
+      }
+
+      return false;
+    }
+
+    // Time left before the delay expires, never more than the delay itself. Zero when stopped or expired.
+    uint32_t remaining() {
+      if(!b_running) {
+        return 0;
+      }
+
+      uint32_t i_elapsed = elapsed();
+
+      return (i_elapsed >= i_delay_ms) ? 0 : i_delay_ms - i_elapsed;
+    }
+
+  private:
+    uint32_t i_start_time = 0;
+    uint32_t i_delay_ms = 0;
+    bool b_running = false;
+
+    // Time since the timer was started. A timer started later in this pass than the cached time has no time elapsed.
+    uint32_t elapsed() {
+      int32_t i_elapsed = (int32_t)(timerNow() - i_start_time);
+
+      return (i_elapsed > 0) ? (uint32_t)i_elapsed : 0;
+    }
+};
+
+// Called once at the start of every pass of the loop to read the clock for all timer checks in that pass.
+void updateTimers() {
+  i_timer_now = millis();
+  b_timer_now_cached = true;
+}
@@ -41,15 +41,17 @@
 #include <CRC32.h>
 #include <digitalWriteFast.h>
 #include <EEPROM.h>
-#include <millisDelay.h>
 #include <FastLED.h>
-#include <ezButton.h>
 #include <Ramp.h>
 #include <SerialTransfer.h>
 #include <Wire.h>
 
 // Local Files
+#include "Timers.h"
+#include "Memory.h"
+#include "Flags.h"
 #include "Configuration.h"
+#include "Inputs.h"
 #include "MusicSounds.h"
 #include "Communication.h"
 #include "Header.h"
@@ -64,6 +66,7 @@ void checkMenuVibration();
 void checkRotaryEncoder();
 void checkSwitches();
 void clearCyclotronFades();
+void clearRotaryDetents();
 void cyclotron1984(uint16_t speed);
 void cyclotron2021(uint16_t speed);
 void cyclotron84LightOn(uint8_t index);
@@ -147,16 +150,23 @@ void setup() {
   pinModeFast(ROTARY_ENCODER_A, INPUT_PULLUP);
   pinModeFast(ROTARY_ENCODER_B, INPUT_PULLUP);
 
+  // Decode the rotary encoder from the Timer0 compare B interrupt, midway between the millis() updates.
+  OCR0B = 0x80;
+  TIMSK0 |= _BV(OCIE0B);
+
   // Status indicator LED on the v1.5 GPStar Proton Pack Board.
   pinModeFast(PACK_STATUS_LED_PIN, OUTPUT);
 
   // Configure the various switches on the pack.
-  switch_alarm.setDebounceTime(50);
-  switch_mode.setDebounceTime(50);
-  switch_vibration.setDebounceTime(50);
-  switch_cyclotron_direction.setDebounceTime(50);
-  switch_cyclotron_lid.setDebounceTime(50);
-  switch_smoke.setDebounceTime(50);
+  pinModeFast(RIBBON_CABLE_SWITCH_PIN, INPUT_PULLUP);
+  pinModeFast(YEAR_TOGGLE_PIN, INPUT_PULLUP);
+  pinModeFast(VIBRATION_TOGGLE_PIN, INPUT_PULLUP);
+  pinModeFast(CYCLOTRON_DIRECTION_TOGGLE_PIN, INPUT_PULLUP);
+  pinModeFast(ION_ARM_SWITCH_PIN, INPUT_PULLUP);
+  pinModeFast(SMOKE_TOGGLE_PIN, INPUT_PULLUP);
+  pinModeFast(i_cyclotron_lid_switch_pin, INPUT_PULLUP);
+  delayMicroseconds(10); // Let the pull-ups settle before the first sample.
+  packSwitches.begin(readPackSwitches(), millis());
 
   // Change PWM frequency of pin 45 for the vibration motor, we do not want it high pitched.
   TCCR5B = (TCCR5B & B11111000) | B00000100;  // for PWM frequency of 122.55 Hz
@@ -266,6 +276,7 @@ void setup() {
   ms_fast_led.start(i_fast_led_delay);
   ms_check_music.start(i_music_check_delay);
   ms_serial1_check.start(i_serial1_disconnect_delay);
+  ms_memory_check.start(i_memory_check_delay);
   ms_cyclotron_switch_plate_leds.start(i_cyclotron_switch_plate_leds_delay);
 
   // Perform initial pack reset.
@@ -285,8 +296,7 @@ void setup() {
 
   // Perform power-on sequence if demo light mode is not enabled per user preferences.
   if(b_demo_light_mode != true) {
-    // System Power On Self Test
-    playEffect(S_POWER_ON);
+    // System Power On Self Test. The POST sound plays as soon as the audio device is ready.
     ms_delay_post.start(0);
   }
   else {
@@ -295,6 +305,9 @@ void setup() {
 }
 
 void loop() {
+  // Check whether any timers have come due since the last pass.
+  updateTimers();
+
   // Update the available audio device.
   updateAudio();
 
@@ -316,6 +329,15 @@ void loop() {
   // Check if any new serial commands were received.
   checkSerial1();
 
+  // Periodically report SRAM usage to the Serial1 device.
+  if(ms_memory_check.justFinished()) {
+    if(b_serial1_connected) {
+      serial1SendData(A_MEMORY_STATS);
+    }
+
+    ms_memory_check.restart();
+  }
+
   if(b_pack_post_finish) {
     checkMusic();
     checkSwitches();
@@ -333,9 +355,9 @@ void loop() {
         }
 
         if(b_pack_on == true) {
-          b_2021_ramp_up = false;
-          b_2021_ramp_up_start = false;
-          b_inner_ramp_up = false;
+          cyclotronState.ramp2021Up = false;
+          cyclotronState.ramp2021UpStart = false;
+          cyclotronState.innerRampUp = false;
           b_fade_out = true;
 
           reset2021RampDown();
@@ -351,7 +373,7 @@ void loop() {
           b_pack_on = false;
         }
 
-        if(b_2021_ramp_down == true && b_overheating == false && b_alarm == false) {
+        if(cyclotronState.ramp2021Down == true && b_overheating == false && b_alarm == false) {
           if(b_spectral_lights_on == true) {
             // If we enter the LED EEPROM menu while the pack is ramping off, stop it right away.
             packOffReset();
@@ -375,7 +397,7 @@ void loop() {
               }
             }
 
-            if(b_reset_start_led == false && ms_fadeout.isRunning() != true) {
+            if(cyclotronState.resetStartLed == false && ms_fadeout.isRunning() != true) {
               packOffReset();
             }
           }
@@ -404,10 +426,10 @@ void loop() {
           b_pack_on = true;
         }
 
-        if(b_2021_ramp_down == true && !ms_mash_lockout.isRunning()) {
-          b_2021_ramp_down = false;
-          b_2021_ramp_down_start = false;
-          b_inner_ramp_down = false;
+        if(cyclotronState.ramp2021Down == true && !ms_mash_lockout.isRunning()) {
+          cyclotronState.ramp2021Down = false;
+          cyclotronState.ramp2021DownStart = false;
+          cyclotronState.innerRampDown = false;
 
           reset2021RampUp();
         }
@@ -445,7 +467,7 @@ void loop() {
         checkCyclotronAutoSpeed();
 
         // Play a little bit of smoke and N-Filter vent lights while firing and other misc sound effects.
-        if(b_wand_firing == true) {
+        if(wandState.firing == true) {
           // Mix some impact sound effects.
           if(ms_firing_sound_mix.justFinished() && STREAM_MODE == PROTON && STATUS_CTS == CTS_NOT_FIRING && b_stream_effects == true) {
             uint8_t i_random = 0;
@@ -575,7 +597,7 @@ void loop() {
 
         cyclotronControl(); // Set timers for the cyclotron.
 
-        if(b_wand_mash_lockout && ms_mash_lockout.isRunning()) {
+        if(wandState.mashLockout && ms_mash_lockout.isRunning()) {
           if((ms_mash_lockout.delay() / 1.5) > ms_mash_lockout.remaining()) {
             // Force incorrect Powercell LED to switch it off temporarily.
             i_powercell_led = i_powercell_leds + 1;
@@ -610,12 +632,23 @@ void loop() {
   }
   else {
     systemPOST();
+
+    // Drop any turns of the dial made during POST rather than applying them all at once afterwards.
+    clearRotaryDetents();
   }
 
   // Update the LEDs
   if(ms_fast_led.justFinished()) {
     FastLED.show();
 
+    #if DEBUG == 1
+      if(!b_first_light_reported) {
+        b_first_light_reported = true;
+        debug(F("Time to first light (ms): "));
+        debugln(millis());
+      }
+    #endif
+
     ms_fast_led.start(i_fast_led_delay);
 
     if(b_powercell_updating == true) {
@@ -894,6 +927,8 @@ void systemPOST() {
       packSerialSend(P_POST_FINISH);
 
       b_pack_post_finish = true;
+
+      reportBootReady();
     }
     else {
       ms_delay_post_3.start(5);
@@ -1114,8 +1149,8 @@ void packShutdown() {
   PACK_STATE = MODE_OFF;
   PACK_ACTION_STATE = ACTION_IDLE;
 
-  if(b_wand_mash_lockout || ms_mash_lockout.isRunning()) {
-    b_wand_mash_lockout = false;
+  if(wandState.mashLockout || ms_mash_lockout.isRunning()) {
+    wandState.mashLockout = false;
     ms_mash_lockout.stop();
     ms_powercell.start(0);
     ms_cyclotron.start(0);
@@ -1127,7 +1162,7 @@ void packShutdown() {
   stopEffect(S_ALARM_LOOP);
   stopEffect(S_RIBBON_CABLE_START);
 
-  if(b_wand_firing) {
+  if(wandState.firing) {
     // Preemptively stop firing.
     wandStoppedFiring();
     cyclotronSpeedRevert();
@@ -1271,10 +1306,10 @@ void packOffReset() {
   ms_overheating_length.stop();
   b_overheating = false;
   b_venting = false;
-  b_2021_ramp_down = false;
-  b_2021_ramp_down_start = false;
-  b_inner_ramp_down = false;
-  b_reset_start_led = true; // Reset the start LED of the Cyclotron.
+  cyclotronState.ramp2021Down = false;
+  cyclotronState.ramp2021DownStart = false;
+  cyclotronState.innerRampDown = false;
+  cyclotronState.resetStartLed = true; // Reset the start LED of the Cyclotron.
 
   resetCyclotronState();
   reset2021RampUp();
@@ -1398,14 +1433,10 @@ void setYearModeByToggle() {
 }
 
 void checkSwitches() {
-  // Perform loop() needed by ezButton.
-  switch_alarm.loop();
-  switch_cyclotron_lid.loop();
-  switch_cyclotron_direction.loop();
-  switch_mode.loop();
-  switch_power.loop();
-  switch_smoke.loop();
-  switch_vibration.loop();
+  // Sample all of the switches together once per scan tick.
+  if(packSwitches.due(millis())) {
+    packSwitches.sample(readPackSwitches());
+  }
 
   cyclotronSwitchPlateLEDs();
 
@@ -1433,7 +1464,7 @@ void checkSwitches() {
     else {
       // Make sure we reset the cyclotron LED status if not in the EEPROM LED menu.
       if(!b_spectral_lights_on) {
-        b_reset_start_led = false;
+        cyclotronState.resetStartLed = false;
       }
     }
   }
@@ -1454,7 +1485,7 @@ void checkSwitches() {
     else {
       // Make sure we reset the cyclotron LED status if not in the EEPROM LED menu.
       if(!b_spectral_lights_on) {
-        b_reset_start_led = false;
+        cyclotronState.resetStartLed = false;
       }
     }
   }
@@ -1626,7 +1657,7 @@ void checkSwitches() {
       }
 
       // Tell the Neutrona Wand that power to the Proton Pack is on.
-      if(b_wand_connected) {
+      if(wandState.connected) {
         packSerialSend(P_ION_ARM_SWITCH_ON);
       }
 
@@ -1641,7 +1672,7 @@ void checkSwitches() {
       }
 
       // Tell the Neutrona Wand that power to the Proton Pack is off.
-      if(b_wand_connected) {
+      if(wandState.connected) {
         packSerialSend(P_ION_ARM_SWITCH_OFF);
       }
 
@@ -1972,7 +2003,7 @@ void cyclotronSwitchLEDLoop() {
   if(ms_cyclotron_switch_led.justFinished()) {
     if(b_cyclotron_lid_on != true) {
       // Frozen Empire brass pack sound is handled here.
-      if(SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM) && !b_alarm && !b_overheating && !b_2021_ramp_down && !b_wand_mash_lockout) {
+      if(SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM) && !b_alarm && !b_overheating && !cyclotronState.ramp2021Down && !wandState.mashLockout) {
         if(!b_brass_pack_sound_loop) {
           playEffect(S_FROZEN_EMPIRE_BOOT_EFFECT, true, i_volume_effects, true, 2000);
           b_brass_pack_sound_loop = true;
@@ -1983,7 +2014,7 @@ void cyclotronSwitchLEDLoop() {
         b_brass_pack_sound_loop = false;
       }
 
-      if(b_brass_pack_sound_loop || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (b_2021_ramp_down || b_alarm || b_wand_mash_lockout) && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM))) {
+      if(b_brass_pack_sound_loop || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (cyclotronState.ramp2021Down || b_alarm || wandState.mashLockout) && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM))) {
         // Per user request, turn off the switch panel LEDs if brass pack is running.
         cyclotronSwitchLEDOff();
       }
@@ -2028,18 +2059,18 @@ void cyclotronSwitchLEDLoop() {
       case SYSTEM_FROZEN_EMPIRE:
       default:
         if(ms_idle_fire_fade.remaining() > 0) {
-          if(b_2021_ramp_up == true) {
+          if(cyclotronState.ramp2021Up == true) {
             i_cyc_led_delay = i_cyclotron_switch_led_delay + (i_2021_ramp_delay - r_outer_cyclotron_ramp.update());
           }
-          else if(b_2021_ramp_down == true) {
+          else if(cyclotronState.ramp2021Down == true) {
             i_cyc_led_delay = i_cyclotron_switch_led_delay + r_outer_cyclotron_ramp.update();
           }
         }
         else {
-          if(b_2021_ramp_up == true) {
+          if(cyclotronState.ramp2021Up == true) {
             i_cyc_led_delay = i_cyclotron_switch_led_delay + ((i_2021_ramp_delay / 2) - r_outer_cyclotron_ramp.update());
           }
-          else if(b_2021_ramp_down == true) {
+          else if(cyclotronState.ramp2021Down == true) {
             i_cyc_led_delay = i_cyclotron_switch_led_delay + r_outer_cyclotron_ramp.update();
           }
         }
@@ -2047,10 +2078,10 @@ void cyclotronSwitchLEDLoop() {
 
       case SYSTEM_1984:
       case SYSTEM_1989:
-        if(b_2021_ramp_up == true) {
+        if(cyclotronState.ramp2021Up == true) {
           i_cyc_led_delay = i_cyclotron_switch_led_delay + (r_outer_cyclotron_ramp.update() - i_1984_delay);
         }
-        else if(b_2021_ramp_down == true) {
+        else if(cyclotronState.ramp2021Down == true) {
           i_cyc_led_delay = i_cyclotron_switch_led_delay / 6 + r_outer_cyclotron_ramp.update();
         }
       break;
@@ -2076,7 +2107,7 @@ void powercellRampDown() {
     }
 
     if(b_powercell_sound_loop) {
-      audio.trackLoop(S_POWERCELL, 0); // Turn off looping which stops the track.
+      audioTrackLoop(S_POWERCELL, 0); // Turn off looping which stops the track.
       b_powercell_sound_loop = false;
     }
 
@@ -2086,7 +2117,7 @@ void powercellRampDown() {
     switch(SYSTEM_YEAR) {
       case SYSTEM_1984:
       case SYSTEM_1989:
-        if(b_2021_ramp_up == true || b_2021_ramp_down == true) {
+        if(cyclotronState.ramp2021Up == true || cyclotronState.ramp2021Down == true) {
           i_pc_delay = i_powercell_delay + (r_outer_cyclotron_ramp.update() - i_1984_delay);
         }
       break;
@@ -2094,7 +2125,7 @@ void powercellRampDown() {
       case SYSTEM_AFTERLIFE:
       case SYSTEM_FROZEN_EMPIRE:
       default:
-        if(b_2021_ramp_up == true || b_2021_ramp_down == true) {
+        if(cyclotronState.ramp2021Up == true || cyclotronState.ramp2021Down == true) {
           i_pc_delay = i_powercell_delay + r_outer_cyclotron_ramp.update();
         }
       break;
@@ -2120,7 +2151,7 @@ void powercellLoop() {
     }
     else {
       if(b_powercell_updating != true) {
-        if(((SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && b_cyclotron_lid_on && !b_wand_mash_lockout) || SYSTEM_YEAR == SYSTEM_AFTERLIFE) && i_powercell_led == 0 && !b_2021_ramp_up && !b_2021_ramp_down && !b_wand_firing && !b_alarm && !b_overheating) {
+        if(((SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && b_cyclotron_lid_on && !wandState.mashLockout) || SYSTEM_YEAR == SYSTEM_AFTERLIFE) && i_powercell_led == 0 && !cyclotronState.ramp2021Up && !cyclotronState.ramp2021Down && !wandState.firing && !b_alarm && !b_overheating) {
           if(b_powercell_sound_loop != true) {
             playEffect(S_POWERCELL, true, i_volume_effects - i_wand_idle_level, true, 1400);
             b_powercell_sound_loop = true;
@@ -2138,8 +2169,8 @@ void powercellLoop() {
       }
     }
 
-    if((b_overheating || b_2021_ramp_down || b_2021_ramp_up || b_alarm || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (!b_cyclotron_lid_on || b_wand_mash_lockout))) && b_powercell_sound_loop) {
-      audio.trackLoop(S_POWERCELL, 0); // Turn off looping which stops the track.
+    if((b_overheating || cyclotronState.ramp2021Down || cyclotronState.ramp2021Up || b_alarm || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (!b_cyclotron_lid_on || wandState.mashLockout))) && b_powercell_sound_loop) {
+      audioTrackLoop(S_POWERCELL, 0); // Turn off looping which stops the track.
       b_powercell_sound_loop = false;
     }
 
@@ -2149,7 +2180,7 @@ void powercellLoop() {
     switch(SYSTEM_YEAR) {
       case SYSTEM_1984:
       case SYSTEM_1989:
-        if(b_2021_ramp_up == true || b_2021_ramp_down == true) {
+        if(cyclotronState.ramp2021Up == true || cyclotronState.ramp2021Down == true) {
           i_pc_delay = i_powercell_delay + (r_outer_cyclotron_ramp.update() - i_1984_delay);
         }
       break;
@@ -2157,7 +2188,7 @@ void powercellLoop() {
       case SYSTEM_AFTERLIFE:
       case SYSTEM_FROZEN_EMPIRE:
       default:
-        if(b_2021_ramp_up == true || b_2021_ramp_down == true) {
+        if(cyclotronState.ramp2021Up == true || cyclotronState.ramp2021Down == true) {
           i_pc_delay = i_powercell_delay + r_outer_cyclotron_ramp.update();
         }
       break;
@@ -2463,8 +2494,8 @@ void cyclotronColourReset() {
 
 void cyclotronControl() {
   // Only reset the starting LED when the pack is first started up.
-  if(b_reset_start_led == true) {
-    b_reset_start_led = false;
+  if(cyclotronState.resetStartLed == true) {
+    cyclotronState.resetStartLed = false;
     i_cyclotron_fake_ring_counter = 0;
     i_led_cyclotron_ring = i_ic_cake_start;
 
@@ -2487,10 +2518,10 @@ void cyclotronControl() {
     }
   }
 
-  if(ribbonCableAttached() != true && PACK_STATE != MODE_OFF && b_2021_ramp_down_start != true && b_overheating == false) {
+  if(ribbonCableAttached() != true && PACK_STATE != MODE_OFF && cyclotronState.ramp2021DownStart != true && b_overheating == false) {
     if(b_alarm == false) {
-      b_2021_ramp_up = false;
-      b_inner_ramp_up = false;
+      cyclotronState.ramp2021Up = false;
+      cyclotronState.innerRampUp = false;
       b_alarm = true;
 
       if(SYSTEM_YEAR == SYSTEM_1984 || SYSTEM_YEAR == SYSTEM_1989) {
@@ -2519,8 +2550,8 @@ void cyclotronControl() {
   }
   else if(b_overheating == true) {
     if(b_alarm == false) {
-      b_2021_ramp_up = false;
-      b_inner_ramp_up = false;
+      cyclotronState.ramp2021Up = false;
+      cyclotronState.innerRampUp = false;
 
       if(SYSTEM_YEAR == SYSTEM_1984 || SYSTEM_YEAR == SYSTEM_1989) {
         if(!usingSlimeCyclotron()) {
@@ -2549,8 +2580,8 @@ void cyclotronControl() {
     cyclotronOverheating();
   }
   else {
-    if(b_2021_ramp_up_start == true) {
-      b_2021_ramp_up_start = false;
+    if(cyclotronState.ramp2021UpStart == true) {
+      cyclotronState.ramp2021UpStart = false;
 
       r_outer_cyclotron_ramp.go(i_outer_current_ramp_speed); // Reset the ramp.
       r_inner_cyclotron_ramp.go(i_inner_current_ramp_speed); // Reset the Inner Cyclotron ramp.
@@ -2585,8 +2616,8 @@ void cyclotronControl() {
         break;
       }
     }
-    else if(b_2021_ramp_down_start == true) {
-      b_2021_ramp_down_start = false;
+    else if(cyclotronState.ramp2021DownStart == true) {
+      cyclotronState.ramp2021DownStart = false;
 
       r_outer_cyclotron_ramp.go(i_outer_current_ramp_speed); // Reset the ramp.
       r_inner_cyclotron_ramp.go(i_inner_current_ramp_speed); // Reset the Inner Cyclotron ramp.
@@ -2655,7 +2686,7 @@ void cyclotronFade() {
 
       for(uint8_t i = 0; i < i_cyclotron_leds_total; i++) {
         if(r_cyclotron_led_fade_in[i].isRunning()) {
-          b_cyclotron_led_fading_in[i] = true;
+          b_cyclotron_led_fading_in.set(i, true);
 
           uint8_t i_curr_brightness = r_cyclotron_led_fade_in[i].update();
           i_cyclotron_led_value[i] = i_curr_brightness;
@@ -2666,9 +2697,9 @@ void cyclotronFade() {
         }
 
         uint8_t i_new_brightness = getBrightness(i_cyclotron_brightness);
-        if(r_cyclotron_led_fade_in[i].isFinished() && i_cyclotron_led_value[i] > (i_new_brightness - 1) && b_cyclotron_led_fading_in[i] == true) {
+        if(r_cyclotron_led_fade_in[i].isFinished() && i_cyclotron_led_value[i] > (i_new_brightness - 1) && b_cyclotron_led_fading_in.get(i) == true) {
           i_cyclotron_led_value[i] = i_new_brightness;
-          b_cyclotron_led_fading_in[i] = false;
+          b_cyclotron_led_fading_in.set(i, false);
 
           r_cyclotron_led_fade_out[i].go(i_new_brightness);
 
@@ -2699,9 +2730,9 @@ void cyclotronFade() {
           }
         }
 
-        if(r_cyclotron_led_fade_out[i].isFinished() && b_cyclotron_led_fading_in[i] == false) {
+        if(r_cyclotron_led_fade_out[i].isFinished() && b_cyclotron_led_fading_in.get(i) == false) {
           i_cyclotron_led_value[i] = 0;
-          b_cyclotron_led_fading_in[i] = true;
+          b_cyclotron_led_fading_in.set(i, true);
 
           if(cyclotronLookupTable(i) > 0) {
             pack_leds[cyclotronLookupTable(i) + i_cyclotron_led_start - 1] = getHueAsRGB(CYCLOTRON_OUTER, C_BLACK);
@@ -2720,7 +2751,7 @@ void cyclotronFade() {
 
         for(uint8_t i = 0; i < i_cyclotron_leds_total; i++) {
           if(r_cyclotron_led_fade_in[i].isRunning()) {
-            b_cyclotron_led_fading_in[i] = true;
+            b_cyclotron_led_fading_in.set(i, true);
             uint8_t i_curr_brightness = r_cyclotron_led_fade_in[i].update();
 
             pack_leds[i + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_curr_brightness, false, !b_overheating);
@@ -2729,7 +2760,7 @@ void cyclotronFade() {
 
           uint8_t i_new_brightness = getBrightness(i_cyclotron_brightness);
 
-          if(r_cyclotron_led_fade_in[i].isFinished() && i_cyclotron_led_value[i] > (i_new_brightness - 1) && b_cyclotron_led_fading_in[i] == true) {
+          if(r_cyclotron_led_fade_in[i].isFinished() && i_cyclotron_led_value[i] > (i_new_brightness - 1) && b_cyclotron_led_fading_in.get(i) == true) {
             pack_leds[i + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_new_brightness, false, !b_overheating);
             i_cyclotron_led_value[i] = i_new_brightness;
           }
@@ -2739,13 +2770,13 @@ void cyclotronFade() {
 
             pack_leds[i + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_curr_brightness, false, !b_overheating);
             i_cyclotron_led_value[i] = i_curr_brightness;
-            b_cyclotron_led_fading_in[i] = false;
+            b_cyclotron_led_fading_in.set(i, false);
           }
 
-          if(r_cyclotron_led_fade_out[i].isFinished() && b_cyclotron_led_fading_in[i] == false) {
+          if(r_cyclotron_led_fade_out[i].isFinished() && b_cyclotron_led_fading_in.get(i) == false) {
             pack_leds[i + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, C_BLACK);
             i_cyclotron_led_value[i] = 0;
-            b_cyclotron_led_fading_in[i] = true;
+            b_cyclotron_led_fading_in.set(i, true);
           }
         }
       }
@@ -2760,11 +2791,11 @@ void cyclotron2021(uint16_t iRampDelay) {
   if(ms_cyclotron.justFinished()) {
     uint8_t i_cyclotron_matrix_led = cyclotronLookupTable(i_curr_cyclotron_position);
 
-    if(b_2021_ramp_up) {
+    if(cyclotronState.ramp2021Up) {
       i_fast_led_delay = FAST_LED_UPDATE_MS;
 
       if(r_outer_cyclotron_ramp.isFinished()) {
-        b_2021_ramp_up = false;
+        cyclotronState.ramp2021Up = false;
         i_outer_current_ramp_speed = iRampDelay;
 
         ms_cyclotron.start(i_outer_current_ramp_speed);
@@ -2787,11 +2818,11 @@ void cyclotron2021(uint16_t iRampDelay) {
         }
       }
     }
-    else if(b_2021_ramp_down) {
+    else if(cyclotronState.ramp2021Down) {
       i_fast_led_delay = FAST_LED_UPDATE_MS;
 
       if(r_outer_cyclotron_ramp.isFinished()) {
-        b_2021_ramp_down = false;
+        cyclotronState.ramp2021Down = false;
       }
       else {
         i_outer_current_ramp_speed = r_outer_cyclotron_ramp.update();
@@ -2865,7 +2896,7 @@ void cyclotron2021(uint16_t iRampDelay) {
       ms_cyclotron.start(t_iRampDelay);
     }
 
-    if(!b_wand_firing && !b_overheating && !b_alarm) {
+    if(!wandState.firing && !b_overheating && !b_alarm) {
       vibrationPack(i_vibration_level);
     }
 
@@ -2882,7 +2913,7 @@ void cyclotron2021(uint16_t iRampDelay) {
         else {
           iRampDelay = iRampDelay / i_cyclotron_multiplier;
 
-          if(b_2021_ramp_up || b_2021_ramp_down) {
+          if(cyclotronState.ramp2021Up || cyclotronState.ramp2021Down) {
             iRampDelay = iRampDelay * 1;
           }
           else {
@@ -2947,7 +2978,7 @@ void cyclotron2021(uint16_t iRampDelay) {
         break;
 
         case FRUTTO_MAX_CYCLOTRON_LED_COUNT:
-          if(b_2021_ramp_down || b_2021_ramp_up || b_alarm || b_wand_mash_lockout) {
+          if(cyclotronState.ramp2021Down || cyclotronState.ramp2021Up || b_alarm || wandState.mashLockout) {
             if(i_curr_cyclotron_position == 39) {
               // Top gap between lenses is about 27 pixels wide.
               i_cyclotron_lens_gap = 27;
@@ -2968,7 +2999,7 @@ void cyclotron2021(uint16_t iRampDelay) {
         break;
 
         case FRUTTO_CYCLOTRON_LED_COUNT:
-          if(b_2021_ramp_down || b_2021_ramp_up || b_alarm || b_wand_mash_lockout) {
+          if(cyclotronState.ramp2021Down || cyclotronState.ramp2021Up || b_alarm || wandState.mashLockout) {
             if(i_curr_cyclotron_position > 34) {
               // Top gap between lenses is about 15 pixels wide.
               i_cyclotron_lens_gap = 15;
@@ -2990,7 +3021,7 @@ void cyclotron2021(uint16_t iRampDelay) {
 
         case HASLAB_CYCLOTRON_LED_COUNT:
         default:
-          if(b_2021_ramp_down || b_2021_ramp_up || b_alarm || b_wand_mash_lockout) {
+          if(cyclotronState.ramp2021Down || cyclotronState.ramp2021Up || b_alarm || wandState.mashLockout) {
             if(i_curr_cyclotron_position > 32) {
               // Top gap between lenses is about 9 pixels wide.
               i_cyclotron_lens_gap = 9;
@@ -3075,9 +3106,9 @@ void cyclotron1984(uint16_t iRampDelay) {
   if(ms_cyclotron.justFinished()) {
     iRampDelay = iRampDelay / i_cyclotron_multiplier;
 
-    if(b_2021_ramp_up) {
+    if(cyclotronState.ramp2021Up) {
       if(r_outer_cyclotron_ramp.isFinished()) {
-        b_2021_ramp_up = false;
+        cyclotronState.ramp2021Up = false;
 
         ms_cyclotron.start(iRampDelay);
         i_outer_current_ramp_speed = iRampDelay;
@@ -3092,9 +3123,9 @@ void cyclotron1984(uint16_t iRampDelay) {
         i_vibration_level = i_vibration_idle_level_1984;
       }
     }
-    else if(b_2021_ramp_down) {
+    else if(cyclotronState.ramp2021Down) {
       if(r_outer_cyclotron_ramp.isFinished()) {
-        b_2021_ramp_down = false;
+        cyclotronState.ramp2021Down = false;
       }
       else {
         ms_cyclotron.start(r_outer_cyclotron_ramp.update());
@@ -3111,7 +3142,7 @@ void cyclotron1984(uint16_t iRampDelay) {
       ms_cyclotron.start(iRampDelay);
     }
 
-    if(!b_wand_firing && !b_overheating && !b_alarm) {
+    if(!wandState.firing && !b_overheating && !b_alarm) {
       vibrationPack(i_vibration_level);
     }
 
@@ -3119,13 +3150,13 @@ void cyclotron1984(uint16_t iRampDelay) {
       return;
     }
 
-    if(!b_1984_led_start) {
+    if(!cyclotronState.ledStart1984) {
       if(b_cyclotron_lid_on) {
         cyclotron84LightOff(i_led_cyclotron);
       }
     }
     else {
-      b_1984_led_start = false;
+      cyclotronState.ledStart1984 = false;
     }
 
     i_1984_counter++;
@@ -3426,7 +3457,7 @@ bool usingSlimeCyclotron() {
 // Controls the slime cyclotron effect.
 void slimeCyclotronEffect() {
   if(ms_cyclotron_slime_effect.justFinished()) {
-    if(PACK_STATE == MODE_OFF && b_2021_ramp_down) {
+    if(PACK_STATE == MODE_OFF && cyclotronState.ramp2021Down) {
       slimeCyclotronFadeout();
       return;
     }
@@ -3436,7 +3467,7 @@ void slimeCyclotronEffect() {
     uint8_t i_random_lower = 50;
     uint8_t i_random_upper = 121;
 
-    if(b_wand_firing) {
+    if(wandState.firing) {
       i_random_lower = 40;
 
       switch(i_wand_power_level) {
@@ -3500,7 +3531,7 @@ void slimeCyclotronEffect() {
     }
   }
 
-  if(b_wand_firing != true && b_overheating != true && b_alarm != true) {
+  if(wandState.firing != true && b_overheating != true && b_alarm != true) {
     vibrationPack(i_vibration_level);
   }
 }
@@ -3526,7 +3557,7 @@ void slimeCyclotronFadeout() {
     else {
       // All LEDs faded to black.
       ms_cyclotron_slime_effect.stop();
-      b_2021_ramp_down = false;
+      cyclotronState.ramp2021Down = false;
     }
   //}
 }
@@ -3866,7 +3897,7 @@ void packVentingStart() {
 }
 
 void packOverheatingFinished() {
-  if(b_wand_syncing != true) {
+  if(wandState.syncing != true) {
     packSerialSend(P_OVERHEATING_FINISHED);
   }
 
@@ -4042,7 +4073,7 @@ void resetCyclotronState() {
   cyclotronLidLedsOff();
 
   // Only reset the start LED if the pack is off or just started.
-  if(b_reset_start_led == true) {
+  if(cyclotronState.resetStartLed == true) {
     i_led_cyclotron = i_cyclotron_led_start;
     i_led_cyclotron_ring = i_ic_cake_start;
     i_cyclotron_fake_ring_counter = 0;
@@ -4050,8 +4081,8 @@ void resetCyclotronState() {
 
   // Keep the fade control fading out a light that is not on during startup.
   if(PACK_STATE == MODE_OFF) {
-    if(b_1984_led_start != true) {
-      b_1984_led_start = true;
+    if(cyclotronState.ledStart1984 != true) {
+      cyclotronState.ledStart1984 = true;
     }
   }
 
@@ -4069,7 +4100,7 @@ void clearCyclotronFades() {
     i_cyclotron_led_value[i] = 0;
     r_cyclotron_led_fade_out[i].go(0);
     r_cyclotron_led_fade_in[i].go(0);
-    b_cyclotron_led_fading_in[i] = true;
+    b_cyclotron_led_fading_in.set(i, true);
   }
 }
 
@@ -4197,9 +4228,9 @@ void innerCyclotronCavityUpdate(uint16_t iRampDelay) {
 // For NeoPixel rings, ramp up and ramp down the LEDs in the ring and set the speed. (optional)
 void innerCyclotronRingUpdate(uint16_t iRampDelay) {
   if(ms_cyclotron_ring.justFinished()) {
-    if(b_inner_ramp_up == true) {
+    if(cyclotronState.innerRampUp == true) {
       if(r_inner_cyclotron_ramp.isFinished()) {
-        b_inner_ramp_up = false;
+        cyclotronState.innerRampUp = false;
         ms_cyclotron_ring.start(iRampDelay);
 
         i_inner_current_ramp_speed = iRampDelay;
@@ -4209,11 +4240,11 @@ void innerCyclotronRingUpdate(uint16_t iRampDelay) {
         i_inner_current_ramp_speed = r_inner_cyclotron_ramp.update();
       }
     }
-    else if(b_inner_ramp_down == true) {
+    else if(cyclotronState.innerRampDown == true) {
       innerCyclotronCavityOff(); // Turn off (sparking) cavity lights.
 
       if(r_inner_cyclotron_ramp.isFinished()) {
-        b_inner_ramp_down = false;
+        cyclotronState.innerRampDown = false;
       }
       else {
         ms_cyclotron_ring.start(r_inner_cyclotron_ramp.update());
@@ -4363,23 +4394,23 @@ void innerCyclotronRingUpdate(uint16_t iRampDelay) {
 }
 
 void reset2021RampUp() {
-  b_2021_ramp_up = true;
-  b_2021_ramp_up_start = true;
+  cyclotronState.ramp2021Up = true;
+  cyclotronState.ramp2021UpStart = true;
 
   // Inner Cyclotron ring.
-  b_inner_ramp_up = true;
+  cyclotronState.innerRampUp = true;
 }
 
 void reset2021RampDown() {
-  b_2021_ramp_down = true;
-  b_2021_ramp_down_start = true;
+  cyclotronState.ramp2021Down = true;
+  cyclotronState.ramp2021DownStart = true;
 
   // Inner Cyclotron ring.
-  b_inner_ramp_down = true;
+  cyclotronState.innerRampDown = true;
 }
 
 void ventLightLEDW(bool b_on) {
-  if(b_on && ((b_wand_firing && b_smoke_continuous_level[i_wand_power_level - 1]) || b_overheating || b_alarm)) {
+  if(b_on && ((wandState.firing && b_smoke_continuous_level[i_wand_power_level - 1]) || b_overheating || b_alarm)) {
     digitalWriteFast(NFILTER_LED_PIN, HIGH);
   }
   else {
@@ -4393,7 +4424,7 @@ void ventLight(bool b_on) {
 
   if(b_on) {
     // If doing firing smoke effects, let's change the light colours.
-    if((b_wand_firing && b_smoke_continuous_level[i_wand_power_level - 1]) || b_overheating) {
+    if((wandState.firing && b_smoke_continuous_level[i_wand_power_level - 1]) || b_overheating) {
       if(STREAM_MODE == PROTON) {
         // Override the N-Filter light colours for a proton stream.
         switch(i_wand_power_level) {
@@ -4423,7 +4454,7 @@ void ventLight(bool b_on) {
         }
       }
     }
-    else if(b_wand_firing && !b_smoke_continuous_level[i_wand_power_level - 1]) {
+    else if(wandState.firing && !b_smoke_continuous_level[i_wand_power_level - 1]) {
       // If continuous fire smoke is disabled in the current power level, do not turn on the N-Filter LEDs.
       i_colour_scheme = C_BLACK;
     }
@@ -4444,7 +4475,7 @@ void ventLight(bool b_on) {
 
 void checkCyclotronAutoSpeed() {
   // No need to start any timers until after any ramping has finished; only in Afterlife and Frozen Empire do we do the auto speed increases.
-  if(b_wand_firing && !b_2021_ramp_up && !b_2021_ramp_down) {
+  if(wandState.firing && !cyclotronState.ramp2021Up && !cyclotronState.ramp2021Down) {
     if(ms_cyclotron_auto_speed_timer.justFinished() && i_cyclotron_multiplier < 6) {
       // Increase the Cyclotron speed.
       i_cyclotron_multiplier++;
@@ -4465,7 +4496,7 @@ void modeFireStartSounds() {
       switch(i_wand_power_level) {
         case 1 ... 4:
         default:
-          if(b_firing_intensify == true) {
+          if(wandState.firingIntensify == true) {
             switch(SYSTEM_YEAR) {
               case SYSTEM_1984:
                 playEffect(S_GB1_1984_FIRE_START_SHORT, false, i_volume_effects, false, 0, false);
@@ -4489,13 +4520,13 @@ void modeFireStartSounds() {
               break;
             }
 
-            b_sound_firing_intensify_trigger = true;
+            wandState.soundIntensifyTrigger = true;
           }
           else {
-            b_sound_firing_intensify_trigger = false;
+            wandState.soundIntensifyTrigger = false;
           }
 
-          if(b_firing_alt == true) {
+          if(wandState.firingAlt == true) {
             if(SYSTEM_YEAR == SYSTEM_1989) {
               playEffect(S_GB2_FIRE_START, false, i_volume_effects, false, 0, false);
               playEffect(S_FIRING_LOOP_GB1, true, i_volume_effects, true, 6500, false);
@@ -4509,10 +4540,10 @@ void modeFireStartSounds() {
               playEffect(S_FIRING_LOOP_GB1, true, i_volume_effects, true, 300, false);
             }
 
-            b_sound_firing_alt_trigger = true;
+            wandState.soundAltTrigger = true;
           }
           else {
-            b_sound_firing_alt_trigger = false;
+            wandState.soundAltTrigger = false;
           }
         break;
 
@@ -4536,9 +4567,9 @@ void modeFireStartSounds() {
             break;
           }
 
-          if(b_firing_intensify == true) {
+          if(wandState.firingIntensify == true) {
             // Reset some sound triggers.
-            b_sound_firing_intensify_trigger = true;
+            wandState.soundIntensifyTrigger = true;
             if(SYSTEM_YEAR == SYSTEM_1984) {
               playEffect(S_GB1_1984_FIRE_HIGH_POWER_LOOP, true, i_volume_effects, true, 1700, false);
             }
@@ -4550,12 +4581,12 @@ void modeFireStartSounds() {
             }
           }
           else {
-            b_sound_firing_intensify_trigger = false;
+            wandState.soundIntensifyTrigger = false;
           }
 
-          if(b_firing_alt == true) {
+          if(wandState.firingAlt == true) {
             // Reset some sound triggers.
-            b_sound_firing_alt_trigger = true;
+            wandState.soundAltTrigger = true;
             if(SYSTEM_YEAR == SYSTEM_1989) {
               playEffect(S_FIRING_LOOP_GB1, true, i_volume_effects, true, 700, false);
             }
@@ -4567,7 +4598,7 @@ void modeFireStartSounds() {
             }
           }
           else {
-            b_sound_firing_alt_trigger = false;
+            wandState.soundAltTrigger = false;
           }
         break;
       }
@@ -4626,7 +4657,7 @@ void wandFiring() {
 
   modeFireStartSounds();
 
-  b_wand_firing = true;
+  wandState.firing = true;
   serial1Send(A_FIRING);
 
   if(SYSTEM_YEAR == SYSTEM_AFTERLIFE || SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE) {
@@ -4663,7 +4694,7 @@ void wandFiring() {
 }
 
 void modeFireStopSounds() {
-  if(b_wand_firing) {
+  if(wandState.firing) {
     switch(STREAM_MODE) {
       case PROTON:
       default:
@@ -4788,9 +4819,9 @@ void wandStoppedFiring() {
   // Stop the auto speed timer.
   ms_cyclotron_auto_speed_timer.stop();
 
-  b_wand_firing = false;
-  b_firing_alt = false;
-  b_firing_intensify = false;
+  wandState.firing = false;
+  wandState.firingAlt = false;
+  wandState.firingIntensify = false;
 
   // Reset some vent light timers.
   ms_vent_light_off.stop();
@@ -4925,8 +4956,8 @@ void wandStopFiringSounds() {
     break;
   }
 
-  b_sound_firing_intensify_trigger = false;
-  b_sound_firing_alt_trigger = false;
+  wandState.soundIntensifyTrigger = false;
+  wandState.soundAltTrigger = false;
 
   if(STREAM_MODE == HOLIDAY_HALLOWEEN) {
     stopEffect(S_HALLOWEEN_FIRING_EXTRA);
@@ -4946,7 +4977,7 @@ void stopMashErrorSounds() {
 }
 
 void packAlarm() {
-  if(b_wand_firing == true) {
+  if(wandState.firing == true) {
     // Preemptively stop firing sounds.
     wandStopFiringSounds();
     cyclotronSpeedRevert();
@@ -5033,7 +5064,7 @@ void packAlarm() {
 
 // LEDs for the 1984/2021 and vibration switches.
 void cyclotronSwitchPlateLEDs() {
-  bool b_brass_pack_effect_active = b_brass_pack_sound_loop || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (b_2021_ramp_down || b_alarm || b_wand_mash_lockout) && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM));
+  bool b_brass_pack_effect_active = b_brass_pack_sound_loop || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (cyclotronState.ramp2021Down || b_alarm || wandState.mashLockout) && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM));
 
   if(b_cyclotron_lid_on != true && !b_brass_pack_effect_active) {
     uint8_t i_brightness = getBrightness(i_cyclotron_panel_brightness);
@@ -5127,7 +5158,7 @@ void cyclotronSwitchPlateLEDs() {
 void vibrationPack(uint8_t i_level) {
   if(VIBRATION_MODE != VIBRATION_NONE && VIBRATION_MODE != CYCLOTRON_MOTOR && b_vibration_switch_on && i_level > 0) {
     if(VIBRATION_MODE == VIBRATION_FIRING_ONLY) {
-      if(b_wand_firing == true) {
+      if(wandState.firing == true) {
         if(i_level != i_vibration_level_prev) {
           i_vibration_level_prev = i_level;
           analogWrite(VIBRATION_PIN, i_level);
@@ -5238,26 +5269,72 @@ int8_t readRotary() {
   return 0;
 }
 
+// Runs once per millisecond (Timer0 drives the millis() clock), independent of the loop.
+ISR(TIMER0_COMPB_vect) {
+  int8_t i_step = readRotary();
+
+  if(i_step < 0 && i_rotary_detents > -i_rotary_max_detents) {
+    i_rotary_detents--;
+  }
+  else if(i_step > 0 && i_rotary_detents < i_rotary_max_detents) {
+    i_rotary_detents++;
+  }
+}
+
+// Take the net detents counted since the last call.
+int8_t takeRotaryDetents() {
+  noInterrupts();
+  int8_t i_detents = i_rotary_detents;
+  i_rotary_detents = 0;
+  interrupts();
+
+  return i_detents;
+}
+
+// Discard any detents counted while nothing was consuming them.
+void clearRotaryDetents() {
+  noInterrupts();
+  i_rotary_detents = 0;
+  interrupts();
+}
+
+// Scale detents into steps by how quickly the dial is being turned.
+uint8_t rotaryAcceleration(uint8_t i_detents) {
+  uint32_t i_now = millis();
+  uint32_t i_interval = (i_now - i_rotary_last_detent) / i_detents;
+  uint8_t i_multiplier = 1;
+
+  i_rotary_last_detent = i_now;
+
+  if(i_interval < i_rotary_fast_interval) {
+    i_multiplier = 4;
+  }
+  else if(i_interval < i_rotary_medium_interval) {
+    i_multiplier = 2;
+  }
+
+  return min(i_detents * i_multiplier, i_rotary_max_steps);
+}
+
 void checkRotaryEncoder() {
-  if(readRotary() != 0) {
-    // Only continue if the limiter has expired.
-    if(ms_rotary_encoder.remaining() > 0) {
-      return;
-    }
-    else {
-      ms_rotary_encoder.start(i_rotary_encoder_delay);
-    }
+  int8_t i_detents = takeRotaryDetents();
 
+  if(i_detents == 0) {
+    return;
+  }
+
+  uint8_t i_steps = rotaryAcceleration(abs(i_detents));
+
+  for(uint8_t i = 0; i < i_steps; i++) {
     // Clockwise
-    if(prev_next_code == 0x0b) {
+    if(i_detents < 0) {
       increaseVolume();
 
       // Tell wand to increase volume.
       packSerialSend(P_VOLUME_INCREASE);
     }
-
     // Counter Clockwise
-    if(prev_next_code == 0x07) {
+    else {
       decreaseVolume();
 
       // Tell wand to decrease volume.
@@ -5273,7 +5350,7 @@ void smokeNFilter(bool b_smoke_on) {
 
   if(b_smoke_on) {
     if(b_smoke_enabled) {
-      if(b_wand_firing && !b_overheating && b_smoke_nfilter_continuous_firing && b_smoke_continuous_level[i_wand_power_level - 1]) {
+      if(wandState.firing && !b_overheating && b_smoke_nfilter_continuous_firing && b_smoke_continuous_level[i_wand_power_level - 1]) {
         digitalWriteFast(NFILTER_SMOKE_PIN, HIGH);
       }
       else if(b_overheating && b_smoke_nfilter_overheat && b_smoke_overheat_level[i_wand_power_level - 1]) {
@@ -5298,7 +5375,7 @@ void smokeNFilter(bool b_smoke_on) {
 void smokeBooster(bool b_smoke_on) {
   if(b_smoke_on) {
     if(b_smoke_enabled) {
-      if(b_wand_firing && !b_overheating && b_smoke_booster_continuous_firing && b_smoke_continuous_level[i_wand_power_level - 1]) {
+      if(wandState.firing && !b_overheating && b_smoke_booster_continuous_firing && b_smoke_continuous_level[i_wand_power_level - 1]) {
         digitalWriteFast(BOOSTER_TUBE_SMOKE_PIN, HIGH);
       }
       else if(b_overheating && b_smoke_booster_overheat && b_smoke_overheat_level[i_wand_power_level - 1]) {
@@ -5328,7 +5405,7 @@ void fanNFilter(bool b_fan_on) {
 
   if(b_fan_on) {
     if(b_smoke_enabled) {
-      if(b_wand_firing && !b_overheating && b_fan_nfilter_continuous_firing && b_smoke_continuous_level[i_wand_power_level - 1]) {
+      if(wandState.firing && !b_overheating && b_fan_nfilter_continuous_firing && b_smoke_continuous_level[i_wand_power_level - 1]) {
         digitalWriteFast(NFILTER_FAN_PIN, HIGH);
       }
       else if(b_overheating && b_fan_nfilter_overheat && b_smoke_overheat_level[i_wand_power_level - 1]) {
@@ -5352,7 +5429,7 @@ void fanNFilter(bool b_fan_on) {
 void fanBooster(bool b_fan_on) {
   if(b_fan_on) {
     if(b_smoke_enabled) {
-      if(b_wand_firing && !b_overheating && b_fan_booster_continuous_firing && b_smoke_continuous_level[i_wand_power_level - 1]) {
+      if(wandState.firing && !b_overheating && b_fan_booster_continuous_firing && b_smoke_continuous_level[i_wand_power_level - 1]) {
         digitalWriteFast(BOOSTER_TUBE_FAN_PIN, HIGH);
       }
       else if(b_overheating && b_fan_booster_overheat && b_smoke_overheat_level[i_wand_power_level - 1]) {
@@ -5392,7 +5469,7 @@ void serial1HandShake() {
 // Check if the wand is still connected.
 void wandDisconnectCheck() {
   // A wand was previously considered to be connected.
-  if(b_wand_connected == true) {
+  if(wandState.connected == true) {
     if(ms_wand_check.justFinished()) {
       // Timer just ran out, so we must assume the wand was disconnected.
       if(b_diagnostic == true) {
@@ -5400,20 +5477,20 @@ void wandDisconnectCheck() {
         playEffect(S_VENT_BEEP);
       }
 
-      b_wand_connected = false; // Cause the next handshake to trigger a sync.
-      b_wand_syncing = false; // If there is no wand we cannot be syncing with one.
-      b_wand_on = false; // No wand means the device is no longer powered on.
+      wandState.connected = false; // Cause the next handshake to trigger a sync.
+      wandState.syncing = false; // If there is no wand we cannot be syncing with one.
+      wandState.on = false; // No wand means the device is no longer powered on.
 
       // Tell the serial1 device the wand was disconnected.
       serial1Send(A_WAND_DISCONNECTED);
 
-      if(b_wand_firing == true) {
+      if(wandState.firing == true) {
         // Reset the pack to a non-firing state.
         wandStoppedFiring();
         cyclotronSpeedRevert();
       }
 
-      if(b_wand_mash_lockout) {
+      if(wandState.mashLockout) {
         restartFromWandMash();
       }
 
@@ -5430,11 +5507,11 @@ void wandDisconnectCheck() {
       }
     }
     else {
-      if(ms_wand_check.remaining() < (ms_wand_check.delay() / 5) && !b_wand_syncing) {
+      if(ms_wand_check.remaining() < (ms_wand_check.delay() / 5) && !wandState.syncing) {
         // If we haven't received a handshake from the wand in over 6.5 seconds, force a handshake with the wand.
         // This is because the wand is supposed to handshake every 3.25 seconds and we haven't heard back in two pings.
         // This should be a last-resort check to make sure it's available and responding.
-        b_wand_syncing = true;
+        wandState.syncing = true;
         packSerialSend(P_HANDSHAKE);
       }
     }
@@ -5470,11 +5547,11 @@ void wandExtraSoundsBeepLoop() {
 void wandExtraSoundsBeepLoopStop(bool stopNaturally) {
   if(stopNaturally) {
     // Set all beep looping to false so they stop naturally.
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S1, false);
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S2, false);
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S3, false);
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S4, false);
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S5, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S1, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S2, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S3, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S4, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S5, false);
   }
   else {
     // Stop all beeps explicitly to prevent rapid switching from taking up all available channels.
@@ -5506,7 +5583,7 @@ void wandExtraSoundsStop() {
   stopEffect(S_WAND_BOOTUP);
   stopEffect(S_WAND_BOOTUP_SHORT);
 
-  if(b_wand_mash_lockout || PACK_STATE == MODE_OFF) {
+  if(wandState.mashLockout || PACK_STATE == MODE_OFF) {
     stopMashErrorSounds();
   }
 }
@@ -5735,7 +5812,7 @@ void startWandMashLockout(uint16_t i_timeout) {
   }
 
   // Flag that the button mash error sequence is in effect.
-  b_wand_mash_lockout = true;
+  wandState.mashLockout = true;
   stopMashErrorSounds();
 
   // Play special sounds for the Frozen Empire theme and begin a freeze-up effect.
@@ -5763,7 +5840,7 @@ void startWandMashLockout(uint16_t i_timeout) {
 void restartFromWandMash() {
   stopMashErrorSounds();
 
-  b_wand_mash_lockout = false;
+  wandState.mashLockout = false;
 
   if(b_pack_on) {
     switch(SYSTEM_YEAR) {
@@ -5781,8 +5858,8 @@ void restartFromWandMash() {
         }
 
         // Reset the lighting timers.
-        b_2021_ramp_down = false;
-        b_inner_ramp_down = false;
+        cyclotronState.ramp2021Down = false;
+        cyclotronState.innerRampDown = false;
         reset2021RampUp();
         ms_mash_lockout.stop();
         ms_powercell.start(0);
@@ -55,11 +55,22 @@ bool b_preload_tracks = false; // Sets whether to add a 50ms delay before playin
 /*
  * Music Control/Checking
  */
-const uint16_t i_music_check_delay = 2000;
-const uint16_t i_music_next_track_delay = 500;
+const uint16_t i_music_check_delay = 2000; // How often to request the music track status from GPStar Audio.
 millisDelay ms_check_music;
-millisDelay ms_music_next_track;
-millisDelay ms_music_status_check;
+bool b_music_track_reported = false; // Whether the audio device has reported the current music track as playing.
+
+/*
+ * Audio Device Detection
+ * Probes are repeated until a device answers or the timeout expires, all from updateAudio().
+ */
+enum AUDIO_DETECT_STATES { AD_IDLE, AD_PROBING, AD_SYSINFO };
+enum AUDIO_DETECT_STATES AUDIO_DETECT_STATE = AD_IDLE;
+const uint16_t i_audio_probe_delay = 100; // Time between probes while waiting for the audio device to boot.
+const uint16_t i_audio_detect_timeout = 2000; // Give up looking for an audio device after this long.
+const uint8_t i_audio_sysinfo_delay = 50; // How long a WAV Trigger has to follow its version string with RSP_SYSTEM_INFO.
+millisDelay ms_audio_probe;
+millisDelay ms_audio_detect;
+bool b_audio_master_pending = false; // Whether the master volume was changed before the audio device was ready.
 
 /*
  * Volume percentage values (0 to 100)
@@ -88,6 +99,123 @@ void playTransitionEffect(uint16_t i_track_id, uint16_t i_track_id2, bool b_trac
 void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume = i_volume_effects, bool b_fade = false, uint16_t i_fade_time = 0);
 void updateMasterVolume(bool startup = false);
 
+/*
+ * Audio Command Shadow
+ * Keeps a small direct-mapped copy of the per-track gain sent to the audio device, plus any loop write not yet sent.
+ * Gain and loop writes are staged here and sent once per loop() from updateAudio(), and repeated writes to one
+ * track are merged. A gain write which matches what the device already holds is dropped. Loop writes are always
+ * sent, as the device applies the loop state to the voice currently playing rather than keeping it for the track.
+ * Any staged writes for a track are always sent before that track is started.
+ */
+const uint8_t i_audio_shadow_slots = 16; // Number of tracks tracked at once. Must be a power of two.
+const uint8_t AUDIO_SHADOW_GAIN_KNOWN = 0x01; // Gain matches the value held by the audio device.
+const uint8_t AUDIO_SHADOW_GAIN_DIRTY = 0x02; // Gain holds a new value not yet sent to the audio device.
+const uint8_t AUDIO_SHADOW_LOOP_DIRTY = 0x04; // Loop bit holds a new value not yet sent to the audio device.
+const uint8_t AUDIO_SHADOW_LOOP_ON = 0x08; // Loop state for the track.
+
+struct AudioTrackShadow {
+  uint16_t TrackId = 0; // Track held by this slot (0 when empty).
+  int8_t Gain = 0;      // Gain last sent or staged for the track.
+  uint8_t Flags = 0;    // AUDIO_SHADOW_* state bits.
+};
+
+AudioTrackShadow audioShadow[i_audio_shadow_slots];
+bool b_audio_shadow_dirty = false; // Whether any slot holds writes waiting to be sent.
+
+// Send any staged gain/loop writes held by a shadow slot.
+void audioShadowSend(AudioTrackShadow &slot) {
+  if(slot.Flags & AUDIO_SHADOW_GAIN_DIRTY) {
+    audio.trackGain(slot.TrackId, slot.Gain);
+    slot.Flags = (slot.Flags & ~AUDIO_SHADOW_GAIN_DIRTY) | AUDIO_SHADOW_GAIN_KNOWN;
+  }
+
+  if(slot.Flags & AUDIO_SHADOW_LOOP_DIRTY) {
+    audio.trackLoop(slot.TrackId, (slot.Flags & AUDIO_SHADOW_LOOP_ON) ? 1 : 0);
+    slot.Flags &= ~AUDIO_SHADOW_LOOP_DIRTY;
+  }
+}
+
+// Return the shadow slot for a track, sending the staged writes of any other track which held it.
+AudioTrackShadow& audioShadowSlot(uint16_t i_track_id) {
+  AudioTrackShadow &slot = audioShadow[i_track_id & (i_audio_shadow_slots - 1)];
+
+  if(slot.TrackId != i_track_id) {
+    audioShadowSend(slot);
+    slot.TrackId = i_track_id;
+    slot.Flags = 0;
+  }
+
+  return slot;
+}
+
+// Stage a gain change for a track, unless the audio device already has (or will have) that gain.
+void audioTrackGain(uint16_t i_track_id, int8_t i_track_volume) {
+  AudioTrackShadow &slot = audioShadowSlot(i_track_id);
+
+  if((slot.Flags & (AUDIO_SHADOW_GAIN_KNOWN | AUDIO_SHADOW_GAIN_DIRTY)) && slot.Gain == i_track_volume) {
+    return;
+  }
+
+  slot.Gain = i_track_volume;
+  slot.Flags |= AUDIO_SHADOW_GAIN_DIRTY;
+  b_audio_shadow_dirty = true;
+}
+
+// Stage a loop write for a track. It is always sent, even when it matches the last loop state sent.
+void audioTrackLoop(uint16_t i_track_id, bool b_loop) {
+  AudioTrackShadow &slot = audioShadowSlot(i_track_id);
+
+  if(b_loop) {
+    slot.Flags |= AUDIO_SHADOW_LOOP_ON;
+  }
+  else {
+    slot.Flags &= ~AUDIO_SHADOW_LOOP_ON;
+  }
+
+  slot.Flags |= AUDIO_SHADOW_LOOP_DIRTY;
+  b_audio_shadow_dirty = true;
+}
+
+// Send any staged writes for a track now, ahead of a command which depends on them.
+void audioFlushTrack(uint16_t i_track_id) {
+  AudioTrackShadow &slot = audioShadow[i_track_id & (i_audio_shadow_slots - 1)];
+
+  if(slot.TrackId == i_track_id) {
+    audioShadowSend(slot);
+  }
+}
+
+// Fade a track to a new gain, which becomes the known gain for that track.
+void audioTrackFade(uint16_t i_track_id, int8_t i_track_volume, uint16_t i_fade_time) {
+  AudioTrackShadow &slot = audioShadowSlot(i_track_id);
+
+  audioShadowSend(slot);
+  audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+
+  slot.Gain = i_track_volume;
+  slot.Flags |= AUDIO_SHADOW_GAIN_KNOWN;
+}
+
+// Drop any staged loop write for a track after the audio device has set its loop state on its own.
+void audioForgetLoop(uint16_t i_track_id) {
+  AudioTrackShadow &slot = audioShadow[i_track_id & (i_audio_shadow_slots - 1)];
+
+  if(slot.TrackId == i_track_id) {
+    slot.Flags &= ~AUDIO_SHADOW_LOOP_DIRTY;
+  }
+}
+
+// Send all staged writes. Called once per loop from updateAudio().
+void audioShadowFlush() {
+  if(b_audio_shadow_dirty) {
+    for(uint8_t i = 0; i < i_audio_shadow_slots; i++) {
+      audioShadowSend(audioShadow[i]);
+    }
+
+    b_audio_shadow_dirty = false;
+  }
+}
+
 /*
  * Audio playback functions.
  */
@@ -106,39 +234,43 @@ void playEffect(uint16_t i_track_id, bool b_track_loop, int8_t i_track_volume, b
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(b_fade_in) {
-        audio.trackGain(i_track_id, i_volume_abs_min);
+        audioTrackGain(i_track_id, i_volume_abs_min);
+        audioFlushTrack(i_track_id);
         audio.trackPlayPoly(i_track_id, b_lock);
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
+        audioTrackGain(i_track_id, i_track_volume);
+        audioFlushTrack(i_track_id);
         audio.trackPlayPoly(i_track_id, b_lock);
       }
 
       if(b_track_loop) {
-        audio.trackLoop(i_track_id, 1);
+        audioTrackLoop(i_track_id, 1);
       }
       else {
-        audio.trackLoop(i_track_id, 0);
+        audioTrackLoop(i_track_id, 0);
       }
     break;
 
     case A_GPSTAR_AUDIO_ADV:
       if(b_fade_in) {
-        audio.trackGain(i_track_id, i_volume_abs_min);
+        audioTrackGain(i_track_id, i_volume_abs_min);
+        audioFlushTrack(i_track_id);
         audio.trackPlayPoly(i_track_id, b_lock, b_preload_tracks ? 50 : 0);
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
+        audioTrackGain(i_track_id, i_track_volume);
+        audioFlushTrack(i_track_id);
         audio.trackPlayPoly(i_track_id, b_lock, b_preload_tracks ? 50 : 0);
       }
 
       if(b_track_loop) {
-        audio.trackLoop(i_track_id, 1);
+        audioTrackLoop(i_track_id, 1);
       }
       else {
-        audio.trackLoop(i_track_id, 0);
+        audioTrackLoop(i_track_id, 0);
       }
     break;
 
@@ -177,15 +309,21 @@ void playTransitionEffect(uint16_t i_track_id, uint16_t i_track_id2, bool b_trac
   switch(AUDIO_DEVICE) {
     case A_GPSTAR_AUDIO_ADV:
       if(b_fade_in) {
-        audio.trackGain(i_track_id, i_volume_abs_min);
-        audio.trackGain(i_track_id2, i_track_volume);
+        audioTrackGain(i_track_id, i_volume_abs_min);
+        audioTrackGain(i_track_id2, i_track_volume);
+        audioFlushTrack(i_track_id);
+        audioFlushTrack(i_track_id2);
         audio.trackPlayPoly(i_track_id, b_lock, b_preload_tracks ? 50 : 0, i_track_id2, b_track2_loop, i_track2_offset);
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioForgetLoop(i_track_id2); // The audio device sets the loop state for the follow-up track.
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
-        audio.trackGain(i_track_id2, i_track_volume);
+        audioTrackGain(i_track_id, i_track_volume);
+        audioTrackGain(i_track_id2, i_track_volume);
+        audioFlushTrack(i_track_id);
+        audioFlushTrack(i_track_id2);
         audio.trackPlayPoly(i_track_id, b_lock, b_preload_tracks ? 5 : 0, i_track_id2, b_track2_loop, i_track2_offset);
+        audioForgetLoop(i_track_id2); // The audio device sets the loop state for the follow-up track.
       }
     break;
 
@@ -205,13 +343,14 @@ void playMusic() {
       case A_GPSTAR_AUDIO:
         // Loop the music track.
         if(b_repeat_track) {
-          audio.trackLoop(i_current_music_track, 1);
+          audioTrackLoop(i_current_music_track, 1);
         }
         else {
-          audio.trackLoop(i_current_music_track, 0);
+          audioTrackLoop(i_current_music_track, 0);
         }
 
-        audio.trackGain(i_current_music_track, i_volume_music);
+        audioTrackGain(i_current_music_track, i_volume_music);
+        audioFlushTrack(i_current_music_track);
         audio.trackPlayPoly(i_current_music_track, true);
         audio.update();
 
@@ -221,13 +360,14 @@ void playMusic() {
       case A_GPSTAR_AUDIO_ADV:
         // Loop the music track.
         if(b_repeat_track) {
-          audio.trackLoop(i_current_music_track, 1);
+          audioTrackLoop(i_current_music_track, 1);
         }
         else {
-          audio.trackLoop(i_current_music_track, 0);
+          audioTrackLoop(i_current_music_track, 0);
         }
 
-        audio.trackGain(i_current_music_track, i_volume_music);
+        audioTrackGain(i_current_music_track, i_volume_music);
+        audioFlushTrack(i_current_music_track);
         audio.trackPlayPoly(i_current_music_track, true, b_preload_tracks ? 50 : 0);
         audio.update();
 
@@ -240,8 +380,8 @@ void playMusic() {
       break;
     }
 
-    // Keep track of music playback on the device directly.
-    ms_music_status_check.start(i_music_check_delay * 10);
+    // Wait for the audio device to report the new track as playing.
+    b_music_track_reported = false;
   }
 }
 
@@ -269,9 +409,6 @@ void stopMusic() {
 
 void pauseMusic() {
   if(b_playing_music && !b_music_paused) {
-    // Stop the music check timer.
-    ms_music_status_check.stop();
-
     // Pause music playback on the Single-Shot Blaster
     switch(AUDIO_DEVICE) {
       case A_WAV_TRIGGER:
@@ -293,8 +430,8 @@ void pauseMusic() {
 
 void resumeMusic() {
   if(b_music_paused) {
-    // Reset the music check timer.
-    ms_music_status_check.start(i_music_check_delay * 4);
+    // Wait for the audio device to report the track as playing again.
+    b_music_track_reported = false;
 
     // Resume music playback on the Single-Shot Blaster
     switch(AUDIO_DEVICE) {
@@ -387,10 +524,10 @@ void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume, bool b_fade, u
     case A_GPSTAR_AUDIO:
     case A_GPSTAR_AUDIO_ADV:
       if(b_fade) {
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
+        audioTrackGain(i_track_id, i_track_volume);
       }
     break;
 
@@ -411,7 +548,8 @@ void updateMasterVolume(bool startup) {
 
     case A_NONE:
     default:
-      // Nothing.
+      // Applied once detection finds an audio device.
+      b_audio_master_pending = true;
     break;
   }
 
@@ -509,7 +647,7 @@ void updateEffectsVolume() {
     case A_GPSTAR_AUDIO:
     case A_GPSTAR_AUDIO_ADV:
       // Since adjusting only happens while in the menu mode, only certain effects need to be adjusted on the fly.
-      audio.trackGain(S_IDLE_LOOP, i_volume_effects);
+      audioTrackGain(S_IDLE_LOOP, i_volume_effects);
     break;
 
     case A_NONE:
@@ -559,7 +697,7 @@ void updateMusicVolume() {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
       case A_GPSTAR_AUDIO_ADV:
-        audio.trackGain(i_current_music_track, i_volume_music);
+        audioTrackGain(i_current_music_track, i_volume_music);
       break;
 
       case A_NONE:
@@ -661,57 +799,65 @@ bool musicTrackStatus() {
   }
 }
 
+// Ask GPStar Audio for the music track status, as only the WAV Trigger pushes track reports on its own.
 void checkMusic() {
-  if(ms_check_music.justFinished() && !ms_music_next_track.isRunning()) {
+  if(ms_check_music.justFinished()) {
+    ms_check_music.start(i_music_check_delay);
+
     switch(AUDIO_DEVICE) {
-      case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
       case A_GPSTAR_AUDIO_ADV:
-        ms_check_music.start(i_music_check_delay);
-
-        musicTrackPlayingStatus();
-
-        // Loop through all the tracks if the music is not set to repeat a track.
         if(b_playing_music && !b_repeat_track && !b_music_paused) {
-          if(!musicTrackStatus() && ms_music_status_check.justFinished() && !musicIsTrackCounterReset()) {
-            ms_check_music.stop();
-            ms_music_status_check.stop();
-
-            stopMusic();
-
-            // Switch to the next track.
-            if(i_current_music_track + 1 > i_music_track_start + i_music_count - 1) {
-              i_current_music_track = i_music_track_start;
-            }
-            else {
-              i_current_music_track++;
-            }
-
-            // Start timer to prepare to play music again.
-            ms_music_next_track.start(i_music_next_track_delay);
-          }
-          else {
-            if(ms_music_status_check.justFinished()) {
-              ms_music_status_check.start(i_music_check_delay * 4);
-            }
-          }
+          musicTrackPlayingStatus();
         }
       break;
 
+      case A_WAV_TRIGGER:
       case A_NONE:
       default:
-        // None
+        // Nothing.
       break;
     }
   }
+}
 
-  // Start playing music again.
-  if(ms_music_next_track.justFinished()) {
-    ms_music_next_track.stop();
-    ms_check_music.start(i_music_check_delay);
+// Advance the playlist as soon as the audio device reports the current music track has ended.
+// Called from updateAudio() so the reply is acted upon in the same pass it arrives.
+void checkMusicStatus() {
+  if(!b_playing_music || b_repeat_track || b_music_paused) {
+    return;
+  }
 
-    // Play the appropriate track on the device.
-    playMusic();
+  bool b_track_playing = false;
+
+  switch(AUDIO_DEVICE) {
+    case A_WAV_TRIGGER:
+      // Kept current by the track reports enabled with setReporting().
+      b_track_playing = audio.isTrackPlaying(i_current_music_track);
+    break;
+
+    case A_GPSTAR_AUDIO:
+    case A_GPSTAR_AUDIO_ADV:
+      if(musicIsTrackCounterReset()) {
+        // No status reply has arrived since playback began.
+        return;
+      }
+
+      b_track_playing = musicTrackStatus();
+    break;
+
+    case A_NONE:
+    default:
+      return;
+    break;
+  }
+
+  if(b_track_playing) {
+    b_music_track_reported = true;
+  }
+  else if(b_music_track_reported) {
+    // Only a track which was seen playing can have ended.
+    musicNextTrack();
   }
 }
 
@@ -725,14 +871,14 @@ void toggleMusicLoop() {
         b_repeat_track = true;
 
         if(i_music_count > 0) {
-          audio.trackLoop(i_current_music_track, 1);
+          audioTrackLoop(i_current_music_track, 1);
         }
       }
       else {
         b_repeat_track = false;
 
         if(i_music_count > 0) {
-          audio.trackLoop(i_current_music_track, 0);
+          audioTrackLoop(i_current_music_track, 0);
         }
       }
     break;
@@ -753,21 +899,63 @@ void toggleMusicLoop() {
  * Audio Setup Routines
  * Used to detect, update, and reset the available audio devices.
  */
-bool setupAudioDevice() {
-  // Short delay to allow the audio boards to boot up.
-  delay(1000);
-
-  char gVersion[VERSION_STRING_LEN];
-
+// Start detecting the audio device. Detection completes in the background from updateAudio().
+void setupAudioDevice() {
   Serial3.begin(57600);
 
   audio.start(Serial3);
 
-  // Ask for some Wav Trigger information.
-  audio.requestVersionString();
-  audio.requestSystemInfo();
+  AUDIO_DEVICE = A_NONE;
+  AUDIO_DETECT_STATE = AD_PROBING;
+
+  ms_audio_detect.start(i_audio_detect_timeout);
+  ms_audio_probe.start(0);
+}
+
+// Configure the audio device once detection has finished.
+void audioDeviceReady() {
+  AUDIO_DETECT_STATE = AD_IDLE;
+  ms_audio_probe.stop();
+  ms_audio_detect.stop();
+
+  debug(F("Audio detection finished (ms): "));
+  debugln(millis());
+
+  switch(AUDIO_DEVICE) {
+    case A_WAV_TRIGGER:
+      // Only attempt to build a music track count if the WAV Trigger responded with RSP_SYSTEM_INFO.
+      if(audio.wasSysInfoRcvd()) {
+        buildMusicCount((uint16_t) audio.getNumTracks());
+      }
+      else {
+        debugln(F("Warning: RSP_SYSTEM_INFO not received!"));
+      }
+
+      debugln(F("Using WAV Trigger"));
+    break;
 
-  delay(10);
+    case A_GPSTAR_AUDIO:
+    case A_GPSTAR_AUDIO_ADV:
+      // GPStar Audio has higher maximum amplification, so reset default values accordingly.
+      i_volume_abs_max = 10;
+      i_volume_master = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100); // Master overall volume
+      i_volume_master_eeprom = i_volume_master; // Master overall volume that is saved into the eeprom menu and loaded during bootup in standalone mode
+      i_volume_revert = i_volume_master; // Used to restore volume level from a muted state.
+
+      debugln(F("Using GPStar Audio"));
+      debug(F("Version: "));
+      debugln(audio.getVersionNumber());
+
+      buildMusicCount((uint16_t) audio.getNumTracks());
+    break;
+
+    case A_NONE:
+    default:
+      // No audio devices connected.
+      debugln(F("No Audio Device"));
+      return;
+    break;
+  }
 
   // Stop all tracks.
   audio.stopAllTracks();
@@ -783,59 +971,66 @@ bool setupAudioDevice() {
   // Enable track reporting. Only for the WAV Trigger.
   audio.setReporting(true);
 
-  // Allow time for hello command and other data to return back.
-  delay(350);
-
-  if(audio.getVersion(gVersion)) {
-    // We found a WAV Trigger. Build the music track count.
-    if(audio.wasSysInfoRcvd()) {
-      // Only attempt to build a music track count if the WAV Trigger responded with RSP_SYSTEM_INFO.
-      buildMusicCount((uint16_t) audio.getNumTracks());
-    }
-    else {
-      debugln(F("Warning: RSP_SYSTEM_INFO not received!"));
-    }
-
-    AUDIO_DEVICE = A_WAV_TRIGGER;
-
-    debugln(F("Using WAV Trigger"));
-
-    return true;
+  if(b_audio_master_pending) {
+    // The system finished loading before the audio device did.
+    b_audio_master_pending = false;
+    audio.masterGain(i_volume_master);
   }
 
-  audio.hello();
+  // Play a sound to test the audio system.
+  playEffect(S_DEVICE_READY);
+}
 
-  delay(350);
+// Send probes and act on the replies until an audio device is found or detection times out.
+void checkAudioDetection() {
+  char gVersion[VERSION_STRING_LEN];
 
-  if(audio.gpstarAudioHello()) {
-    if(audio.getVersionNumber() != 0) {
-      AUDIO_DEVICE = A_GPSTAR_AUDIO_ADV;
-    }
-    else {
-      AUDIO_DEVICE = A_GPSTAR_AUDIO;
-    }
+  audio.update();
 
-    // GPStar Audio has higher maximum amplification, so reset default values accordingly.
-    i_volume_abs_max = 10;
-    i_volume_master = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100); // Master overall volume
-    i_volume_master_eeprom = i_volume_master; // Master overall volume that is saved into the eeprom menu and loaded during bootup in standalone mode
-    i_volume_revert = i_volume_master; // Used to restore volume level from a muted state.
+  switch(AUDIO_DETECT_STATE) {
+    case AD_PROBING:
+      if(audio.getVersion(gVersion)) {
+        // We found a WAV Trigger, so allow its system info (track count) to arrive.
+        AUDIO_DETECT_STATE = AD_SYSINFO;
+        ms_audio_probe.start(i_audio_sysinfo_delay);
+      }
+      else if(audio.gpstarAudioHello()) {
+        if(audio.getVersionNumber() != 0) {
+          AUDIO_DEVICE = A_GPSTAR_AUDIO_ADV;
+        }
+        else {
+          AUDIO_DEVICE = A_GPSTAR_AUDIO;
+        }
 
-    debugln(F("Using GPStar Audio"));
-    debug(F("Version: "));
-    debugln(audio.getVersionNumber());
+        audioDeviceReady();
+      }
+      else if(ms_audio_detect.justFinished()) {
+        AUDIO_DEVICE = A_NONE;
 
-    buildMusicCount((uint16_t) audio.getNumTracks());
+        audioDeviceReady();
+      }
+      else if(ms_audio_probe.justFinished()) {
+        // Ask for some WAV Trigger information and greet GPStar Audio; whichever is present will answer.
+        audio.requestVersionString();
+        audio.requestSystemInfo();
+        audio.hello();
 
-    return true;
-  }
-  else {
-    // No audio devices connected.
-    AUDIO_DEVICE = A_NONE;
+        ms_audio_probe.start(i_audio_probe_delay);
+      }
+    break;
 
-    debugln(F("No Audio Device"));
+    case AD_SYSINFO:
+      if(audio.wasSysInfoRcvd() || ms_audio_probe.justFinished()) {
+        AUDIO_DEVICE = A_WAV_TRIGGER;
+
+        audioDeviceReady();
+      }
+    break;
 
-    return false;
+    case AD_IDLE:
+    default:
+      // Nothing.
+    break;
   }
 }
 
@@ -844,12 +1039,20 @@ void updateAudio() {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
     case A_GPSTAR_AUDIO_ADV:
+      // Send any gain/loop changes staged during the previous pass.
+      audioShadowFlush();
+
       audio.update();
+
+      // Act on any music track status which just arrived.
+      checkMusicStatus();
     break;
 
     case A_NONE:
     default:
-      // Nothing.
+      if(AUDIO_DETECT_STATE != AD_IDLE) {
+        checkAudioDetection();
+      }
     break;
   }
 }
@@ -124,10 +124,12 @@ enum ENCODER_STATES { ENCODER_IDLE = 0, ENCODER_CW = 1, ENCODER_CCW = -1 };
 struct Encoder {
   const static uint8_t PinA = r_encoderA;
   const static uint8_t PinB = r_encoderB;
+  const static int8_t MAX_DETENTS = 4; // Limit on the detents held for check(), so a fast spin does not keep stepping menus after the dial stops.
 
   private:
     uint8_t PrevNextCode = 0;
     uint16_t CodeStore = 0;
+    volatile int8_t Detents = 0; // Net detents counted by sample(), not yet consumed by check().
 
     int8_t read() {
       static int8_t RotEncTable[] = {0,1,1,0,1,0,0,1,1,0,0,1,0,1,1,0};
@@ -169,30 +171,56 @@ struct Encoder {
       pinMode(PinA, INPUT_PULLUP);
       pinMode(PinB, INPUT_PULLUP);
       STATE = ENCODER_IDLE;
+
+      // Decode the encoder from the Timer0 compare B interrupt, midway between the millis() updates.
+      OCR0B = 0x80;
+      TIMSK0 |= _BV(OCIE0B);
+    }
+
+    // Called once per millisecond by the timer interrupt, so detents are counted while the loop is busy with other work.
+    // FastLED.show() holds interrupts off while it writes the LEDs, so samples (and steps of a very fast turn) can be missed then.
+    void sample() {
+      int8_t i_step = read();
+
+      if(i_step > 0 && Detents < MAX_DETENTS) {
+        Detents++;
+      }
+      else if(i_step < 0 && Detents > -MAX_DETENTS) {
+        Detents--;
+      }
+    }
+
+    // Discard any detents counted while nothing was consuming them.
+    void clear() {
+      noInterrupts();
+      Detents = 0;
+      interrupts();
     }
 
+    // Take a single detent counted by the interrupt, so every menu step is acted on in turn.
     void check() {
-      static int8_t i_last_val; // Always stored to know if change occurred.
+      STATE = ENCODER_IDLE;
 
-      // Read the current encoder value, noting state when adjusted.
-      if(i_last_val != read()) {
+      noInterrupts();
+      if(Detents > 0) {
         // Clockwise.
-        if(PrevNextCode == 0x07) {
-          STATE = ENCODER_CW;
-        }
-
-        // Counter-clockwise.
-        if(PrevNextCode == 0x0b) {
-          STATE = ENCODER_CCW;
-        }
+        Detents--;
+        STATE = ENCODER_CW;
       }
-      else {
-        STATE = ENCODER_IDLE;
+      else if(Detents < 0) {
+        // Counter-clockwise.
+        Detents++;
+        STATE = ENCODER_CCW;
       }
+      interrupts();
     }
 
 } encoder;
 
+ISR(TIMER0_COMPB_vect) {
+  encoder.sample();
+}
+
 /*
  * Vibration
  *
@@ -37,16 +37,10 @@
 void readEEPROM();
 void clearConfigEEPROM();
 void saveConfigEEPROM();
-void updateCRCEEPROM();
 uint32_t eepromCRC(void);
 void resetOverheatLevels();
 void resetWhiteLEDBlinkRate();
 
-/*
- * General EEPROM Variables
- */
-uint16_t i_eepromAddress = 0; // The address in the EEPROM to start reading from.
-
 /*
  * Data structure object for customizations which are saved into the EEPROM memory.
  */
@@ -59,19 +53,225 @@ struct objConfigEEPROM {
 };
 
 /*
- * Read all user preferences from device controller EEPROM.
+ * EEPROM Preference Journal
+ *
+ * Rather than rewriting the same bytes at address 0, each save appends a record (header, object and
+ * its own CRC32) to the next slot of a ring spanning the EEPROM. At boot only the slot headers are
+ * scanned to find the newest record of each kind, and older copies are used only if its CRC fails.
+ * An interrupted save therefore loses only that save, and a save which changes nothing writes nothing.
  */
-void readEEPROM() {
-  // Get the stored CRC from the EEPROM.
+enum EEPROM_RECORDS { EEPROM_RECORD_CONFIG, EEPROM_RECORD_KINDS };
+const uint8_t i_eeprom_record_tag = 0xA0; // Stored as (tag + kind) so records stand apart from erased or legacy bytes.
+const uint8_t i_eeprom_record_length[EEPROM_RECORD_KINDS] = { sizeof(objConfigEEPROM) };
+const uint16_t i_eeprom_no_slot = 0xFFFF;
+
+struct objEEPROMRecordHeader {
+  uint8_t tag;       // i_eeprom_record_tag + the record kind.
+  uint8_t length;    // Size of the object which follows the header.
+  uint32_t sequence; // Incremented for every record written; the highest is the newest. Too wide to wrap within the EEPROM's write endurance.
+};
+
+// Every slot fits a header, the largest preference object and a CRC32.
+const uint8_t i_eeprom_slot_size = sizeof(objEEPROMRecordHeader) + sizeof(objConfigEEPROM) + sizeof(uint32_t);
+
+// The last 4 bytes of the EEPROM still hold the CRC used by the single-copy layout of earlier firmware.
+const uint16_t i_eeprom_slots = (E2END + 1 - sizeof(uint32_t)) / i_eeprom_slot_size;
+
+// Slots overlapping that single-copy layout, which are left alone until the journal wraps around.
+const uint16_t i_eeprom_legacy_slots = (sizeof(objConfigEEPROM) + i_eeprom_slot_size - 1) / i_eeprom_slot_size;
+
+uint16_t i_eeprom_record_slot[EEPROM_RECORD_KINDS] = { i_eeprom_no_slot }; // Slot of the newest valid record of each kind.
+uint32_t i_eeprom_sequence = 0; // Sequence number of the newest record in the journal.
+uint16_t i_eeprom_next_slot = i_eeprom_legacy_slots; // Slot which receives the next record.
+
+// Whether sequence number a was written after sequence number b, allowing for wrap-around.
+bool eepromSequenceNewer(uint32_t a, uint32_t b) {
+  return (int32_t)(a - b) > 0;
+}
+
+uint16_t eepromSlotAddress(uint16_t i_slot) {
+  return i_slot * i_eeprom_slot_size;
+}
+
+// Whether a slot header describes a record of the given kind.
+bool eepromRecordMatches(const objEEPROMRecordHeader &header, uint8_t i_kind) {
+  return header.tag == i_eeprom_record_tag + i_kind && header.length == i_eeprom_record_length[i_kind];
+}
+
+// Calculate the CRC32 for a record header and the object which follows it.
+uint32_t eepromRecordCRC(const objEEPROMRecordHeader &header, const uint8_t *p_data) {
+  CRC32 crc;
+  const uint8_t *p_header = (const uint8_t*) &header;
+
+  for(uint8_t i = 0; i < sizeof(objEEPROMRecordHeader); i++) {
+    crc.update(p_header[i]);
+  }
+
+  for(uint8_t i = 0; i < header.length; i++) {
+    crc.update(p_data[i]);
+  }
+
+  return (uint32_t)crc.finalize();
+}
+
+// Copy the object held by a slot into a buffer and check it against the CRC stored with it.
+bool readEEPROMRecord(uint16_t i_slot, uint8_t *p_data) {
+  uint16_t i_address = eepromSlotAddress(i_slot);
+  objEEPROMRecordHeader header;
+  uint32_t l_crc_check;
+
+  EEPROM.get(i_address, header);
+  i_address += sizeof(objEEPROMRecordHeader);
+
+  for(uint8_t i = 0; i < header.length; i++) {
+    p_data[i] = EEPROM.read(i_address + i);
+  }
+
+  EEPROM.get(i_address + header.length, l_crc_check);
+
+  return eepromRecordCRC(header, p_data) == l_crc_check;
+}
+
+// Find the newest record of a kind with an intact CRC, falling back to older copies if necessary.
+uint16_t findEEPROMRecord(uint8_t i_kind, uint8_t *p_data) {
+  bool b_bounded = false;
+  uint32_t i_older_than = 0;
+
+  for(uint16_t i_attempt = 0; i_attempt < i_eeprom_slots; i_attempt++) {
+    uint16_t i_best_slot = i_eeprom_no_slot;
+    uint32_t i_best_sequence = 0;
+
+    for(uint16_t i_slot = 0; i_slot < i_eeprom_slots; i_slot++) {
+      objEEPROMRecordHeader header;
+      EEPROM.get(eepromSlotAddress(i_slot), header);
+
+      if(!eepromRecordMatches(header, i_kind) || (b_bounded && !eepromSequenceNewer(i_older_than, header.sequence))) {
+        continue;
+      }
+
+      if(i_best_slot == i_eeprom_no_slot || eepromSequenceNewer(header.sequence, i_best_sequence)) {
+        i_best_slot = i_slot;
+        i_best_sequence = header.sequence;
+      }
+    }
+
+    if(i_best_slot == i_eeprom_no_slot || readEEPROMRecord(i_best_slot, p_data)) {
+      return i_best_slot;
+    }
+
+    // That record was torn or corrupted, so try the next newest copy.
+    b_bounded = true;
+    i_older_than = i_best_sequence;
+  }
+
+  return i_eeprom_no_slot;
+}
+
+// Locate the newest record of each kind and the slot which the next record will be written to.
+void scanEEPROMJournal() {
+  bool b_found = false;
+
+  for(uint16_t i_slot = 0; i_slot < i_eeprom_slots; i_slot++) {
+    objEEPROMRecordHeader header;
+    EEPROM.get(eepromSlotAddress(i_slot), header);
+
+    for(uint8_t i_kind = 0; i_kind < EEPROM_RECORD_KINDS; i_kind++) {
+      if(eepromRecordMatches(header, i_kind) && (!b_found || eepromSequenceNewer(header.sequence, i_eeprom_sequence))) {
+        b_found = true;
+        i_eeprom_sequence = header.sequence;
+        i_eeprom_next_slot = (i_slot + 1) % i_eeprom_slots;
+      }
+    }
+  }
+}
+
+// Append a record for an object, unless the newest record of that kind already holds the same data.
+void writeEEPROMRecord(uint8_t i_kind, const uint8_t *p_data) {
+  uint8_t i_length = i_eeprom_record_length[i_kind];
+  uint16_t i_current = i_eeprom_record_slot[i_kind];
+
+  if(i_current != i_eeprom_no_slot) {
+    uint16_t i_address = eepromSlotAddress(i_current) + sizeof(objEEPROMRecordHeader);
+    bool b_changed = false;
+
+    for(uint8_t i = 0; i < i_length && !b_changed; i++) {
+      b_changed = EEPROM.read(i_address + i) != p_data[i];
+    }
+
+    if(!b_changed) {
+      return;
+    }
+  }
+
+  // Never overwrite the newest record of any kind.
+  uint16_t i_slot = i_eeprom_next_slot;
+  bool b_in_use = true;
+
+  while(b_in_use) {
+    b_in_use = false;
+
+    for(uint8_t i_kind_check = 0; i_kind_check < EEPROM_RECORD_KINDS; i_kind_check++) {
+      if(i_eeprom_record_slot[i_kind_check] == i_slot) {
+        b_in_use = true;
+      }
+    }
+
+    if(b_in_use) {
+      i_slot = (i_slot + 1) % i_eeprom_slots;
+    }
+  }
+
+  objEEPROMRecordHeader header = { (uint8_t)(i_eeprom_record_tag + i_kind), i_length, i_eeprom_sequence + 1 };
+  uint16_t i_address = eepromSlotAddress(i_slot);
+
+  EEPROM.put(i_address, header);
+
+  for(uint8_t i = 0; i < i_length; i++) {
+    EEPROM.update(i_address + sizeof(objEEPROMRecordHeader) + i, p_data[i]);
+  }
+
+  // The CRC is written last so that an interrupted save never looks valid.
+  EEPROM.put(i_address + sizeof(objEEPROMRecordHeader) + i_length, eepromRecordCRC(header, p_data));
+
+  i_eeprom_sequence = header.sequence;
+  i_eeprom_record_slot[i_kind] = i_slot;
+  i_eeprom_next_slot = (i_slot + 1) % i_eeprom_slots;
+}
+
+// Fetch the newest stored configuration object. If it was never saved it is left zeroed (defaults).
+bool loadEEPROM(objConfigEEPROM &obj_config_eeprom) {
+  scanEEPROMJournal();
+
+  i_eeprom_record_slot[EEPROM_RECORD_CONFIG] = findEEPROMRecord(EEPROM_RECORD_CONFIG, (uint8_t*) &obj_config_eeprom);
+
+  if(i_eeprom_record_slot[EEPROM_RECORD_CONFIG] != i_eeprom_no_slot) {
+    return true;
+  }
+
+  // Nothing journaled yet, so fall back to the single-copy layout used by earlier firmware.
   uint32_t l_crc_check;
   EEPROM.get(EEPROM.length() - sizeof(eepromCRC()), l_crc_check);
 
-  // Check if the calculated CRC matches the stored CRC value in the EEPROM.
   if(eepromCRC() == l_crc_check) {
-    // Read our object from the EEPROM.
-    objConfigEEPROM obj_config_eeprom;
-    EEPROM.get(i_eepromAddress, obj_config_eeprom);
+    EEPROM.get(0, obj_config_eeprom);
+
+    // Carry the stored preferences over into the journal.
+    writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_config_eeprom);
+
+    return true;
+  }
+
+  return false;
+}
+
+/*
+ * Read all user preferences from device controller EEPROM.
+ */
+void readEEPROM() {
+  objConfigEEPROM obj_config_eeprom = {};
 
+  // Locate the newest stored copy of the preference object.
+  if(loadEEPROM(obj_config_eeprom)) {
     if(obj_config_eeprom.device_boot_errors > 0 && obj_config_eeprom.device_boot_errors != 255) {
       if(obj_config_eeprom.device_boot_errors > 1) {
         b_device_boot_errors = true;
@@ -128,7 +328,7 @@ void readEEPROM() {
     }
   }
   else {
-    // CRC doesn't match; let's clear the EEPROMs to be safe.
+    // Nothing valid was found; let's clear the EEPROMs to be safe.
     playEffect(S_VOICE_EEPROM_LOADING_FAILED_RESET);
 
     clearConfigEEPROM();
@@ -136,12 +336,10 @@ void readEEPROM() {
 }
 
 void clearConfigEEPROM() {
-  // Clear out the EEPROM only in the memory addresses used for our EEPROM data object.
-  for(uint16_t i = 0; i < sizeof(objConfigEEPROM); i++) {
-    EEPROM.update(i, 0);
-  }
+  // Store an empty configuration object so that defaults are used.
+  objConfigEEPROM obj_config_eeprom = {};
 
-  updateCRCEEPROM();
+  writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_config_eeprom);
 }
 
 void saveConfigEEPROM() {
@@ -196,21 +394,15 @@ void saveConfigEEPROM() {
     i_device_vibration
   };
 
-  // Save and update our object in the EEPROM.
-  EEPROM.put(i_eepromAddress, obj_config_eeprom);
-
-  updateCRCEEPROM();
-}
-
-// Update the CRC in the EEPROM.
-void updateCRCEEPROM() {
-  EEPROM.put(EEPROM.length() - sizeof(eepromCRC()), eepromCRC());
+  // Append the object to the EEPROM journal if any of the values have changed.
+  writeEEPROMRecord(EEPROM_RECORD_CONFIG, (const uint8_t*) &obj_config_eeprom);
 }
 
+// CRC of the single-copy layout used by earlier firmware, kept only to migrate it into the journal.
 uint32_t eepromCRC(void) {
   CRC32 crc;
 
-  for(uint16_t index = 0; index < (i_eepromAddress + sizeof(objConfigEEPROM)); index++) {
+  for(uint16_t index = 0; index < (sizeof(objConfigEEPROM)); index++) {
     crc.update(EEPROM[index]);
   }
 
@@ -144,8 +144,7 @@ void checkRotaryEncoder() {
 void systemPOST() {
   uint8_t i_delay = 100;
 
-  // Play a sound to test the audio system.
-  playEffect(S_DEVICE_READY);
+  // The sound which tests the audio system plays once the audio device is ready.
 
   // Turn on all bargraph elements and force an update
   bargraph.reset();
@@ -157,6 +157,9 @@ void setup() {
   // Execute the System POST (Power On Self Test)
   systemPOST();
 
+  // Drop any turns of the dial made during POST rather than applying them all at once afterwards.
+  encoder.clear();
+
   // Set the options for the tasks so that it "catches up" if there is a delay.
   animateTask.setSchedulingOption(TASK_SCHEDULE);
   inputsTask.setSchedulingOption(TASK_SCHEDULE);
@@ -28,6 +28,7 @@
 #include "Password.h" // PASSWORD_page
 #include "Style.h" // STYLE_page
 #include "Icon.h" // FAVICON_ico, FAVICON_svg
+#include "Metrics.h" // handleGetMetrics
 
 // Forward function declarations.
 void setupRouting();
@@ -35,8 +36,6 @@ void setupRouting();
 /*
  * Web Handler Functions - Performs actions or returns data for web UI
  */
-JsonDocument jsonBody; // Used for processing JSON body/payload data.
-JsonDocument jsonSuccess; // Used for sending JSON status as success.
 String status; // Holder for simple "status: success" response.
 
 void onWebSocketEventHandler(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
@@ -78,11 +77,16 @@ void onWebSocketEventHandler(AsyncWebSocket *server, AsyncWebSocketClient *clien
 }
 
 void startWebServer() {
+  // Guards the metrics history shared by the web server and the WiFi management task.
+  if(metricsMutex == nullptr) {
+    metricsMutex = xSemaphoreCreateMutex();
+  }
+
   // Configures URI routing with function handlers.
   setupRouting();
 
   // Prepare a standard "success" message for responses.
-  jsonSuccess.clear();
+  JsonDocument jsonSuccess;
   jsonSuccess["status"] = "success";
   serializeJson(jsonSuccess, status);
 
@@ -167,10 +171,9 @@ void handleFavSvg(AsyncWebServerRequest *request) {
   request->send(response);
 }
 
-String getDeviceConfig() {
+void writeDeviceConfig(Print& output) {
   // Prepare a JSON object with information we have gleamed from the system.
-  String equipSettings;
-  jsonBody.clear();
+  JsonDocument jsonBody;
 
   // Provide current values for the device.
   jsonBody["buildDate"] = build_date;
@@ -179,64 +182,40 @@ String getDeviceConfig() {
   jsonBody["extAddr"] = wifi_address;
   jsonBody["extMask"] = wifi_subnet;
 
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, equipSettings);
-  return equipSettings;
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
 }
 
-String getWifiSettings() {
+void writeWifiSettings(Print& output) {
   // Prepare a JSON object with information stored in preferences (or a blank default).
-  String wifiNetwork;
-  jsonBody.clear();
-
-  // Accesses namespace in read-only mode.
-  if(preferences.begin("network", true)) {
-    jsonBody["enabled"] = preferences.getBool("enabled", false);
-    jsonBody["network"] = preferences.getString("ssid");
-    jsonBody["password"] = preferences.getString("password");
-
-    jsonBody["address"] = preferences.getString("address");
-    if(jsonBody["address"].as<String>() == "") {
-      jsonBody["address"] = wifi_address;
-    }
-
-    jsonBody["subnet"] = preferences.getString("subnet");
-    if(jsonBody["subnet"].as<String>() == "") {
-      jsonBody["subnet"] = wifi_subnet;
-    }
-
-    jsonBody["gateway"] = preferences.getString("gateway");
-    if(jsonBody["gateway"].as<String>() == "") {
-      jsonBody["gateway"] = wifi_gateway;
-    }
-
-    preferences.end();
-  }
-  else {
-    if(preferences.begin("network", false)) {
-      preferences.putBool("enabled", false);
-      preferences.putString("ssid", "");
-      preferences.putString("password", "");
-      preferences.putString("address", "");
-      preferences.putString("subnet", "");
-      preferences.putString("gateway", "");
-      preferences.end();
-    }
-  }
-
-  // Serialize JSON object to string.
-  serializeJson(jsonBody, wifiNetwork);
-  return wifiNetwork;
+  JsonDocument jsonBody;
+
+  // Served from the settings cache, as flash is only read at boot.
+  xSemaphoreTake(settingsMutex, portMAX_DELAY);
+  jsonBody["enabled"] = networkSettings.enabled;
+  jsonBody["network"] = networkSettings.ssid;
+  jsonBody["password"] = networkSettings.password;
+  jsonBody["address"] = (networkSettings.address != "") ? networkSettings.address : wifi_address;
+  jsonBody["subnet"] = (networkSettings.subnet != "") ? networkSettings.subnet : wifi_subnet;
+  jsonBody["gateway"] = (networkSettings.gateway != "") ? networkSettings.gateway : wifi_gateway;
+  xSemaphoreGive(settingsMutex);
+
+  // Serialize JSON object to the output.
+  serializeJson(jsonBody, output);
 }
 
 void handleGetDeviceConfig(AsyncWebServerRequest *request) {
-  // Return current device settings as a stringified JSON object.
-  request->send(200, "application/json", getDeviceConfig());
+  // Return current device settings as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writeDeviceConfig(*response);
+  request->send(response);
 }
 
 void handleGetWifi(AsyncWebServerRequest *request) {
-  // Return current system status as a stringified JSON object.
-  request->send(200, "application/json", getWifiSettings());
+  // Return current system status as a JSON object, written straight into the response.
+  AsyncResponseStream *response = request->beginResponseStream("application/json");
+  writeWifiSettings(*response);
+  request->send(response);
 }
 
 void handleRestartDevice(AsyncWebServerRequest *request) {
@@ -248,7 +227,7 @@ void handleRestartDevice(AsyncWebServerRequest *request) {
 
 void handleRestartWiFi(AsyncWebServerRequest *request) {
   // Performs a restart of the external WiFi.
-  jsonBody.clear();
+  JsonDocument jsonBody;
 
   // Disconnect from the WiFi network and re-apply any changes.
   WiFi.disconnect();
@@ -271,7 +250,7 @@ void handleRestartWiFi(AsyncWebServerRequest *request) {
 
 // Handles the JSON body for the pack settings save request.
 AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHandler("/config/device/save", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -289,15 +268,19 @@ AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHa
     // Update the private network name ONLY if the new value differs from the current SSID.
     if(newSSID != ap_ssid){
       if(newSSID.length() >= 8 && newSSID.length() <= 32) {
-        // Accesses namespace in read/write mode.
-        if(preferences.begin("credentials", false)) {
-          #if defined(DEBUG_SEND_TO_CONSOLE)
-            Serial.print(F("New Private SSID: "));
-            Serial.println(newSSID);
-          #endif
-          preferences.putString("ssid", newSSID); // Store SSID in case this was altered.
-          preferences.end();
-        }
+        #if defined(DEBUG_SEND_TO_CONSOLE)
+          Serial.print(F("New Private SSID: "));
+          Serial.println(newSSID);
+        #endif
+
+        // Store SSID in case this was altered.
+        xSemaphoreTake(settingsMutex, portMAX_DELAY);
+        credentialSettings.ssid = newSSID;
+        markSettingsDirty(SETTINGS_CREDENTIALS);
+        xSemaphoreGive(settingsMutex);
+
+        // The new name only takes effect after a restart, so write it to NVS now.
+        flushSettings();
 
         b_ssid_changed = true; // This will cause a reboot of the device after saving.
       }
@@ -333,7 +316,7 @@ AsyncCallbackJsonWebHandler *handleSaveDeviceConfig = new AsyncCallbackJsonWebHa
 
 // Handles the JSON body for the password change request.
 AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHandler("/password/update", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -347,15 +330,19 @@ AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHan
 
     // Password is used for the built-in Access Point ability, which will be used when a preferred network is not available.
     if(newPasswd.length() >= 8) {
-      // Accesses namespace in read/write mode.
-      if(preferences.begin("credentials", false)) {
-        #if defined(DEBUG_SEND_TO_CONSOLE)
-          Serial.print(F("New Private WiFi Password: "));
-          Serial.println(newPasswd);
-        #endif
-        preferences.putString("password", newPasswd); // Store user-provided password.
-        preferences.end();
-      }
+      #if defined(DEBUG_SEND_TO_CONSOLE)
+        Serial.print(F("New Private WiFi Password: "));
+        Serial.println(newPasswd);
+      #endif
+
+      // Store user-provided password.
+      xSemaphoreTake(settingsMutex, portMAX_DELAY);
+      credentialSettings.password = newPasswd;
+      markSettingsDirty(SETTINGS_CREDENTIALS);
+      xSemaphoreGive(settingsMutex);
+
+      // Write the new password now, as the device is likely to be restarted or powered off next.
+      flushSettings();
 
       jsonBody.clear();
       jsonBody["status"] = "Password updated, restart required. Please enter your new WiFi password when prompted by your device.";
@@ -381,7 +368,7 @@ AsyncCallbackJsonWebHandler *passwordChangeHandler = new AsyncCallbackJsonWebHan
 
 // Handles the JSON body for the wifi network info.
 AsyncCallbackJsonWebHandler *wifiChangeHandler = new AsyncCallbackJsonWebHandler("/wifi/update", [](AsyncWebServerRequest *request, JsonVariant &json) {
-  jsonBody.clear();
+  JsonDocument jsonBody;
   if(json.is<JsonObject>()) {
     jsonBody = json.as<JsonObject>();
   }
@@ -401,35 +388,37 @@ AsyncCallbackJsonWebHandler *wifiChangeHandler = new AsyncCallbackJsonWebHandler
 
     // If no errors encountered, continue with storing a preferred network (with credentials and IP information).
     if(wifiNetwork.length() >= 2 && wifiPasswd.length() >= 8) {
-      // Accesses namespace in read/write mode.
-      if(preferences.begin("network", false)) {
-        // Clear old network IP info if SSID or password have been changed.
-        String old_ssid = preferences.getString("ssid", "");
-        String old_passwd = preferences.getString("password", "");
-        if(old_ssid == "" || old_ssid != wifiNetwork || old_passwd == "" || old_passwd != wifiPasswd) {
-          preferences.putString("address", "");
-          preferences.putString("subnet", "");
-          preferences.putString("gateway", "");
-        }
+      xSemaphoreTake(settingsMutex, portMAX_DELAY);
+
+      // Clear old network IP info if SSID or password have been changed.
+      if(networkSettings.ssid == "" || networkSettings.ssid != wifiNetwork || networkSettings.password == "" || networkSettings.password != wifiPasswd) {
+        networkSettings.address = "";
+        networkSettings.subnet = "";
+        networkSettings.gateway = "";
+        forgetAccessPoint();
+      }
 
-        // Store the critical values to enable/disable the external WiFi.
-        preferences.putBool("enabled", b_enabled);
-        preferences.putString("ssid", wifiNetwork);
-        preferences.putString("password", wifiPasswd);
+      // Store the critical values to enable/disable the external WiFi.
+      networkSettings.enabled = b_enabled;
+      networkSettings.ssid = wifiNetwork;
+      networkSettings.password = wifiPasswd;
 
-        // Continue saving only if network values are 7 characters or more (eg. N.N.N.N)
-        if(localAddr.length() >= 7 && localAddr != wifi_address) {
-          preferences.putString("address", localAddr);
-        }
-        if(subnetMask.length() >= 7 && subnetMask != wifi_subnet) {
-          preferences.putString("subnet", subnetMask);
-        }
-        if(gatewayIP.length() >= 7 && gatewayIP != wifi_gateway) {
-          preferences.putString("gateway", gatewayIP);
-        }
-
-        preferences.end();
+      // Continue saving only if network values are 7 characters or more (eg. N.N.N.N)
+      if(localAddr.length() >= 7 && localAddr != wifi_address) {
+        networkSettings.address = localAddr;
+      }
+      if(subnetMask.length() >= 7 && subnetMask != wifi_subnet) {
+        networkSettings.subnet = subnetMask;
+      }
+      if(gatewayIP.length() >= 7 && gatewayIP != wifi_gateway) {
+        networkSettings.gateway = gatewayIP;
       }
+
+      markSettingsDirty(SETTINGS_NETWORK);
+      xSemaphoreGive(settingsMutex);
+
+      // Write the network settings now rather than after the quiet period.
+      flushSettings();
     }
 
     if(!b_errors) {
@@ -497,6 +486,7 @@ void setupRouting() {
   // Get/Set Handlers
   httpServer.on("/config/device", HTTP_GET, handleGetDeviceConfig);
   httpServer.on("/restart", HTTP_DELETE, handleRestartDevice);
+  httpServer.on("/metrics", HTTP_GET, handleGetMetrics);
   httpServer.on("/wifi/restart", HTTP_GET, handleRestartWiFi);
   httpServer.on("/wifi/settings", HTTP_GET, handleGetWifi);
 
@@ -562,63 +552,52 @@ void webSocketClientEvent(WStype_t type, uint8_t * payload, size_t length) {
       * which will cause an error to be thrown. Only continue when no
       * error is present from deserialization.
       */
+      JsonDocument jsonBody;
       DeserializationError jsonError = deserializeJson(jsonBody, payload);
       if (!jsonError) {
-        // Store values as a known datatype (String).
-        String data_mode = jsonBody["mode"];
-        String data_theme = jsonBody["theme"];
-        String data_switch = jsonBody["switch"];
-        String data_pack = jsonBody["pack"];
-        String data_safety = jsonBody["safety"];
-        String data_wandPower = jsonBody["wandPower"];
-        String data_wandMode = jsonBody["wandMode"];
-        String data_firing = jsonBody["firing"];
-        String data_cable = jsonBody["cable"];
-        String data_ctron = jsonBody["cyclotron"];
-        String data_temp = jsonBody["temperature"];
+        // Only the firing state, power level and stream mode are used here, so read them in place.
+        const char* c_wand_mode = jsonBody["wandMode"] | "";
+        const char* c_firing = jsonBody["firing"] | "";
 
         // Convert power (1-5) to an integer.
         i_power = (int)jsonBody["power"];
 
         // Output some data to the serial console when needed.
-        String dataMessage = data_wandMode + " is " + data_firing + " at level " + i_power;
-        debug(dataMessage);
+        debug(String(c_wand_mode) + " is " + c_firing + " at level " + i_power);
 
         // Change LED for testing
-        if(data_firing == "Firing") {
-          b_firing = true;
-        }
-        else {
-          b_firing = false;
-        }
-
-        // Always keep up with the current stream mode.
-        if(data_wandMode == "Proton Stream") {
-          STREAM_MODE = PROTON;
-        }
-        else if(data_wandMode == "Plasm System") {
-          STREAM_MODE = SLIME;
-        }
-        else if(data_wandMode == "Dark Matter Gen.") {
-          STREAM_MODE = STASIS;
-        }
-        else if(data_wandMode == "Particle System") {
-          STREAM_MODE = MESON;
-        }
-        else if(data_wandMode == "Spectral Stream") {
-          STREAM_MODE = SPECTRAL;
-        }
-        else if(data_wandMode == "Halloween") {
-          STREAM_MODE = HOLIDAY_HALLOWEEN;
-        }
-        else if(data_wandMode == "Christmas") {
-          STREAM_MODE = HOLIDAY_CHRISTMAS;
-        }
-        else if(data_wandMode == "Settings") {
-          STREAM_MODE = SETTINGS;
-        }
-        else {
-          STREAM_MODE = SPECTRAL_CUSTOM; // Custom Stream
+        b_firing = (strcmp(c_firing, "Firing") == 0);
+
+        // Always keep up with the current stream mode, sent as its STREAM_MODES value.
+        switch(jsonBody["wandModeID"] | (uint8_t) SPECTRAL_CUSTOM) {
+          case PROTON:
+            STREAM_MODE = PROTON;
+          break;
+          case STASIS:
+            STREAM_MODE = STASIS;
+          break;
+          case SLIME:
+            STREAM_MODE = SLIME;
+          break;
+          case MESON:
+            STREAM_MODE = MESON;
+          break;
+          case SPECTRAL:
+            STREAM_MODE = SPECTRAL;
+          break;
+          case HOLIDAY_HALLOWEEN:
+            STREAM_MODE = HOLIDAY_HALLOWEEN;
+          break;
+          case HOLIDAY_CHRISTMAS:
+            STREAM_MODE = HOLIDAY_CHRISTMAS;
+          break;
+          case SETTINGS:
+            STREAM_MODE = SETTINGS;
+          break;
+          case SPECTRAL_CUSTOM:
+          default:
+            STREAM_MODE = SPECTRAL_CUSTOM; // Custom Stream
+          break;
         }
 
         updateStreamPalette();